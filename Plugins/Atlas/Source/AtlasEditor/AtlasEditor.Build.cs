@@ -50,9 +50,17 @@ public class AtlasEditor : ModuleRules
 				"EditorStyle",
 				"PropertyEditor",
 				"WorkspaceMenuStructure",
+				"MeshReductionInterface",
+				"AssetTools",
+				"MaterialEditor",
+				"MeshDescription",
+				"StaticMeshDescription",
 			}
 		);
 
+		// Streaming gzip for report files
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
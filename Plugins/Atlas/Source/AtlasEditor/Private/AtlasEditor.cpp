@@ -5,6 +5,12 @@
 #include "AtlasCommands.h"
 #include "Core/AtlasRuleRegistry.h"
 #include "Core/AtlasRuleInitializer.h"
+#include "Core/AtlasScanExecutor.h"
+#include "Core/AtlasLiveValidator.h"
+#include "Organizer/AtlasOrganizer.h"
+#include "AtlasSettings.h"
+#include "AtlasIssueStore.h"
+#include "AssetRegistry/AssetData.h"
 #include "IAtlasRule.h"
 #include "Misc/MessageDialog.h"
 #include "ToolMenus.h"
@@ -37,11 +43,28 @@ void FAtlasEditorModule::StartupModule()
 	// Register tab spawners
 	RegisterTabSpawners();
 
+	// Start background validation of changed assets
+	if (UAtlasSettings::Get()->bLiveValidation && !IsRunningCommandlet())
+	{
+		LiveValidator = MakeUnique<FAtlasLiveValidator>(OnIssuesDeltaDelegate);
+		LiveValidator->Start();
+	}
+
+	// Organize imported content once per import session
+	if (UAtlasSettings::Get()->bAutoOrganizeOnImport && !IsRunningCommandlet())
+	{
+		Organizer = MakeUnique<FAtlasOrganizer>();
+		Organizer->Start();
+	}
+
 	UE_LOG(LogAtlas, Log, TEXT("AtlasEditor module started"));
 }
 
 void FAtlasEditorModule::ShutdownModule()
 {
+	Organizer.Reset();
+	LiveValidator.Reset();
+
 	// Unregister all the asset types that we registered
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
@@ -150,8 +173,38 @@ void FAtlasEditorModule::RegisterRule(TSharedRef<IAtlasRule> Rule)
 
 void FAtlasEditorModule::RequestScan(const TArray<FAssetData>& OptionalSelection)
 {
-	// TODO: Implement scan request
 	UE_LOG(LogAtlas, Log, TEXT("Scan requested for %d assets"), OptionalSelection.Num());
+
+	TArray<FAssetData> Selection = OptionalSelection;
+	if (Selection.Num() == 0)
+	{
+		FAtlasScanExecutor::GetAllScannableAssets(Selection);
+	}
+
+	FAtlasIssueStore Store;
+	if (OptionalSelection.Num() == 0)
+	{
+		FAtlasScanExecutor::ScanAll(Store);
+	}
+	else
+	{
+		FAtlasScanExecutor::ScanSelection(Selection, Store);
+	}
+
+	if (LiveValidator)
+	{
+		LiveValidator->IngestScanResults(Selection, Store);
+	}
+
+	OnIssueStoreReadyDelegate.Broadcast(Store);
+
+	// Only expand the store for listeners that still want the array form
+	if (OnIssuesReadyDelegate.IsBound())
+	{
+		TArray<FAtlasIssue> Issues;
+		Store.ToArray(Issues);
+		OnIssuesReadyDelegate.Broadcast(Issues);
+	}
 }
 
 void FAtlasEditorModule::OpenOverview()
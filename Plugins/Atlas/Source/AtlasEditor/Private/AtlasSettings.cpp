@@ -1,6 +1,7 @@
 // Copyright Atlas Team. All Rights Reserved.
 
 #include "AtlasSettings.h"
+#include "Core/AtlasMapTypeClassifier.h"
 
 #define LOCTEXT_NAMESPACE "AtlasSettings"
 
@@ -21,17 +22,37 @@ UAtlasSettings::UAtlasSettings()
 	NamingPrefixes.Add(TEXT("TextureCube"), TEXT("TC_"));
 	NamingPrefixes.Add(TEXT("Blueprint"), TEXT("BP_"));
 
+	// Set default texture map type suffixes
+	MapTypeSuffixes = FAtlasMapTypeClassifier::GetDefaultSuffixes();
+
 	// Set default thresholds
 	MaxTextureSize = 2048;
 	MaxTriCount = 25000;
+	MinMeshLODs = 4;
+	MaxLODTriangleDensity = 0.1f;
+	MaxLODReductionRatio = 0.75f;
+	NaniteMinTriangles = 100000;
+	NearDuplicateMaxDistance = 8;
+	MaterialInstanceParameterTolerance = 0.001f;
+	MaxShaderPermutations = 2000;
 	MaxProjectSizeMB = 81920; // 80 GB
 	TargetVRAMMB = 2560; // 2.5 GB
+	CostModelPlatform = EAtlasCostPlatform::Desktop;
+	StreamingScreenSize = 1920;
+	StreamingSteadyScreenFraction = 0.5f;
 
 	// Set default behavior
 	bBlockBuildOnRed = true;
 	bAutoOrganizeOnImport = false;
+	OrganizerDebounceSeconds = 1.0f;
+	MasterMaterial = FSoftObjectPath(TEXT("/Atlas/Editor/M_MegaPBR_Master.M_MegaPBR_Master"));
 	bAutoFixOnScan = false;
 	bShowInfoMessages = true;
+	bParallelScan = true;
+	bUseScanCache = true;
+	bLiveValidation = true;
+	LiveValidationDebounceSeconds = 0.5f;
+	LiveValidationBudgetMs = 4.0f;
 }
 
 const UAtlasSettings* UAtlasSettings::Get()
@@ -39,6 +60,44 @@ const UAtlasSettings* UAtlasSettings::Get()
 	return GetDefault<UAtlasSettings>();
 }
 
+uint32 UAtlasSettings::GetValidationHash() const
+{
+	uint32 Hash = GetTypeHash(MeshRoot.Path);
+	Hash = HashCombine(Hash, GetTypeHash(MaterialRoot.Path));
+	Hash = HashCombine(Hash, GetTypeHash(TextureRoot.Path));
+	Hash = HashCombine(Hash, GetTypeHash(MaxTextureSize));
+	Hash = HashCombine(Hash, GetTypeHash(MaxTriCount));
+	Hash = HashCombine(Hash, GetTypeHash(MinMeshLODs));
+	Hash = HashCombine(Hash, GetTypeHash(MaxLODTriangleDensity));
+	Hash = HashCombine(Hash, GetTypeHash(MaxLODReductionRatio));
+	Hash = HashCombine(Hash, GetTypeHash(NaniteMinTriangles));
+	Hash = HashCombine(Hash, GetTypeHash(TargetVRAMMB));
+	Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(CostModelPlatform)));
+	Hash = HashCombine(Hash, GetTypeHash(StreamingScreenSize));
+	Hash = HashCombine(Hash, GetTypeHash(StreamingSteadyScreenFraction));
+
+	// Map iteration order depends on insertion, so hash the prefixes in a stable order
+	TArray<FName> PrefixKeys;
+	NamingPrefixes.GetKeys(PrefixKeys);
+	PrefixKeys.Sort(FNameLexicalLess());
+	for (const FName& Key : PrefixKeys)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Key.ToString()));
+		Hash = HashCombine(Hash, GetTypeHash(NamingPrefixes[Key]));
+	}
+
+	TArray<FString> SuffixKeys;
+	MapTypeSuffixes.GetKeys(SuffixKeys);
+	SuffixKeys.Sort();
+	for (const FString& Key : SuffixKeys)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Key));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(MapTypeSuffixes[Key])));
+	}
+
+	return Hash;
+}
+
 FName UAtlasSettings::GetCategoryName() const
 {
 	return TEXT("Plugins");
@@ -49,4 +108,16 @@ FText UAtlasSettings::GetSectionText() const
 	return LOCTEXT("AtlasSettingsSection", "Atlas");
 }
 
+#if WITH_EDITOR
+void UAtlasSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAtlasSettings, MapTypeSuffixes))
+	{
+		FAtlasMapTypeClassifier::Rebuild();
+	}
+}
+#endif
+
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,594 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasValidateCommandlet.h"
+#include "Core/AtlasScanExecutor.h"
+#include "Core/AtlasScanProfiler.h"
+#include "Dedup/AtlasDedupEngine.h"
+#include "Overview/AtlasReportSerializer.h"
+#include "Overview/AtlasReportWriter.h"
+#include "Overview/AtlasBinaryReport.h"
+#include "Overview/AtlasOverviewStats.h"
+#include "Overview/AtlasShaderAnalyzer.h"
+#include "AtlasSettings.h"
+#include "AtlasTypes.h"
+#include "AtlasRuntime.h"
+#include "AtlasTimeline.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+
+namespace AtlasValidateCommandlet
+{
+	static constexpr int32 ExitSuccess = 0;
+	static constexpr int32 ExitWarnings = 1;
+	static constexpr int32 ExitErrors = 2;
+
+	/** Commandlet failure (bad arguments, unreadable input); reported as errors so CI never passes by accident */
+	static constexpr int32 ExitFailure = ExitErrors;
+
+	/**
+	 * One shard report being merged
+	 * Binary reports are memory-mapped and read in place; JSON reports are loaded and sorted.
+	 */
+	struct FMergeSource
+	{
+		FAtlasBinaryReportView View;
+		FAtlasReport Report;
+		bool bBinary;
+		int32 NextIssue;
+
+		FMergeSource()
+			: bBinary(false)
+			, NextIssue(0)
+		{
+		}
+
+		bool Open(const FString& FilePath)
+		{
+			bBinary = FAtlasBinaryReportView::IsBinaryReport(FilePath);
+			if (bBinary)
+			{
+				return View.Open(FilePath);
+			}
+
+			if (!FAtlasReportSerializer::LoadFromFile(FilePath, Report))
+			{
+				return false;
+			}
+
+			FAtlasReportSerializer::SortIssues(Report);
+			return true;
+		}
+
+		int32 NumIssues() const { return bBinary ? View.NumIssues() : Report.Issues.Num(); }
+		FAtlasIssue GetIssue(int32 Index) const { return bBinary ? View.GetIssue(Index) : Report.Issues[Index]; }
+	};
+
+	/** Running counts of the issues written to a report, so the exit code never needs the issues themselves */
+	struct FReportStats
+	{
+		int32 NumIssues;
+		int32 NumWarnings;
+		int32 NumErrors;
+		int64 TotalProjectBytes;
+		int64 TotalVRAMBytes;
+
+		FReportStats()
+			: NumIssues(0)
+			, NumWarnings(0)
+			, NumErrors(0)
+			, TotalProjectBytes(0)
+			, TotalVRAMBytes(0)
+		{
+		}
+
+		void AddIssue(const FAtlasIssue& Issue)
+		{
+			++NumIssues;
+			NumWarnings += Issue.Severity == EAtlasSeverity::Warning ? 1 : 0;
+			NumErrors += Issue.Severity == EAtlasSeverity::Error ? 1 : 0;
+		}
+	};
+
+	/**
+	 * Collects the violations of a run for one timeline snapshot
+	 */
+	struct FTimelineBuilder
+	{
+		FAtlasSnapshot Snapshot;
+		TMap<FString, int32> ViolationsByAsset;
+
+		void AddIssue(const FAtlasIssue& Issue)
+		{
+			Snapshot.AddViolation(Issue.RuleName, static_cast<uint8>(Issue.Severity));
+			++ViolationsByAsset.FindOrAdd(Issue.AssetPath);
+		}
+
+		bool Append(int64 ProjectBytes, int64 VRAMBytes)
+		{
+			Snapshot.When = FDateTime::UtcNow();
+			Snapshot.ProjectBytes = ProjectBytes;
+			Snapshot.VRAMBytes = VRAMBytes;
+
+			// The timeline keeps only the worst offenders; ties go to the first path so reruns agree
+			TArray<TPair<FString, int32>> Assets = ViolationsByAsset.Array();
+			Assets.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B)
+			{
+				return A.Value != B.Value ? A.Value > B.Value : A.Key < B.Key;
+			});
+
+			for (int32 Index = 0; Index < FMath::Min(Assets.Num(), FAtlasTimeline::MaxOffenders); ++Index)
+			{
+				FAtlasSnapshotOffender& Offender = Snapshot.Offenders.AddDefaulted_GetRef();
+				Offender.AssetPath = Assets[Index].Key;
+				Offender.NumViolations = Assets[Index].Value;
+			}
+
+			return FAtlasTimeline::AppendSnapshot(Snapshot);
+		}
+	};
+
+	/**
+	 * Merge the (individually sorted) sources into one writer
+	 * Issues are k-way merged so only one pending issue per source is held in memory.
+	 */
+	template <typename WriterType>
+	static void WriteMerged(TArray<TUniquePtr<FMergeSource>>& Sources, WriterType& Writer, FReportStats& OutStats, FTimelineBuilder* Timeline)
+	{
+		TArray<FAtlasIssue> Heads;
+		TBitArray<> HasHead;
+		for (TUniquePtr<FMergeSource>& Source : Sources)
+		{
+			const bool bHasIssues = Source->NumIssues() > 0;
+			Heads.Add(bHasIssues ? Source->GetIssue(Source->NextIssue++) : FAtlasIssue());
+			HasHead.Add(bHasIssues);
+		}
+
+		for (;;)
+		{
+			int32 Best = INDEX_NONE;
+			for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); ++SourceIndex)
+			{
+				if (HasHead[SourceIndex] && (Best == INDEX_NONE || FAtlasReportSerializer::IsIssueLess(Heads[SourceIndex], Heads[Best])))
+				{
+					Best = SourceIndex;
+				}
+			}
+
+			if (Best == INDEX_NONE)
+			{
+				break;
+			}
+
+			const FAtlasIssue& Issue = Heads[Best];
+			OutStats.AddIssue(Issue);
+			Writer.WriteIssue(Issue);
+
+			if (Timeline)
+			{
+				Timeline->AddIssue(Issue);
+			}
+
+			FMergeSource& Source = *Sources[Best];
+			if (Source.NextIssue < Source.NumIssues())
+			{
+				Heads[Best] = Source.GetIssue(Source.NextIssue++);
+			}
+			else
+			{
+				HasHead[Best] = false;
+			}
+		}
+
+		int64 TotalProjectBytes = 0;
+		int64 TotalVRAMBytes = 0;
+		int64 ReclaimableBytes = 0;
+		int64 ReclaimableVRAMBytes = 0;
+		for (const TUniquePtr<FMergeSource>& Source : Sources)
+		{
+			if (Source->bBinary)
+			{
+				for (int32 Index = 0; Index < Source->View.NumTextures(); ++Index)
+				{
+					Writer.WriteTexture(Source->View.GetTexture(Index));
+				}
+				for (int32 Index = 0; Index < Source->View.NumMeshes(); ++Index)
+				{
+					Writer.WriteMesh(Source->View.GetMesh(Index));
+				}
+				for (int32 Index = 0; Index < Source->View.NumLevels(); ++Index)
+				{
+					Writer.WriteLevel(Source->View.GetLevel(Index));
+				}
+				for (int32 Index = 0; Index < Source->View.NumShaders(); ++Index)
+				{
+					Writer.WriteShader(Source->View.GetShader(Index));
+				}
+				TotalProjectBytes += Source->View.GetTotalProjectBytes();
+				TotalVRAMBytes += Source->View.GetTotalVRAMBytes();
+				ReclaimableBytes += Source->View.GetReclaimableBytes();
+				ReclaimableVRAMBytes += Source->View.GetReclaimableVRAMBytes();
+			}
+			else
+			{
+				for (const FAtlasTextureStat& Texture : Source->Report.Textures)
+				{
+					Writer.WriteTexture(Texture);
+				}
+				for (const FAtlasMeshStat& Mesh : Source->Report.Meshes)
+				{
+					Writer.WriteMesh(Mesh);
+				}
+				for (const FAtlasLevelStat& Level : Source->Report.Levels)
+				{
+					Writer.WriteLevel(Level);
+				}
+				for (const FAtlasShaderStat& Shader : Source->Report.Shaders)
+				{
+					Writer.WriteShader(Shader);
+				}
+				TotalProjectBytes += Source->Report.TotalProjectBytes;
+				TotalVRAMBytes += Source->Report.TotalVRAMBytes;
+				ReclaimableBytes += Source->Report.ReclaimableBytes;
+				ReclaimableVRAMBytes += Source->Report.ReclaimableVRAMBytes;
+			}
+		}
+
+		Writer.SetTotals(TotalProjectBytes, TotalVRAMBytes, ReclaimableBytes, ReclaimableVRAMBytes);
+		OutStats.TotalProjectBytes = TotalProjectBytes;
+		OutStats.TotalVRAMBytes = TotalVRAMBytes;
+	}
+
+	/**
+	 * Scan the selection straight into a writer
+	 * Each scan batch is sorted and merged with SortedIssues as it arrives, so the report comes out in IsIssueLess
+	 * order without the scan's issues ever being collected. Selection must be sorted by object path for this.
+	 */
+	template <typename WriterType>
+	static void WriteScanned(const TArray<FAssetData>& Selection, const TArray<FAtlasIssue>& SortedIssues, WriterType& Writer, FReportStats& OutStats, FAtlasScanStats& OutScanStats, FTimelineBuilder* Timeline)
+	{
+		auto Write = [&Writer, &OutStats, Timeline](const FAtlasIssue& Issue)
+		{
+			OutStats.AddIssue(Issue);
+			Writer.WriteIssue(Issue);
+
+			if (Timeline)
+			{
+				Timeline->AddIssue(Issue);
+			}
+		};
+
+		int32 NextSorted = 0;
+		FAtlasScanExecutor::ScanSelection(Selection, [&](TArray<FAtlasIssue>& Batch)
+		{
+			Batch.StableSort(&FAtlasReportSerializer::IsIssueLess);
+			for (const FAtlasIssue& Issue : Batch)
+			{
+				while (NextSorted < SortedIssues.Num() && FAtlasReportSerializer::IsIssueLess(SortedIssues[NextSorted], Issue))
+				{
+					Write(SortedIssues[NextSorted++]);
+				}
+				Write(Issue);
+			}
+		}, &OutScanStats);
+
+		while (NextSorted < SortedIssues.Num())
+		{
+			Write(SortedIssues[NextSorted++]);
+		}
+	}
+}
+
+UAtlasValidateCommandlet::UAtlasValidateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UAtlasValidateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const bool bCompress = Switches.Contains(TEXT("Compress"));
+	const bool bTimeline = Switches.Contains(TEXT("Timeline"));
+
+	if (Switches.Contains(TEXT("Merge")))
+	{
+		return RunMerge(ParamVals, bCompress, bTimeline);
+	}
+
+	return RunValidate(ParamVals, bCompress, Switches.Contains(TEXT("Dedup")), Switches.Contains(TEXT("Shaders")), bTimeline);
+}
+
+int32 UAtlasValidateCommandlet::RunValidate(const TMap<FString, FString>& ParamVals, bool bCompress, bool bDedup, bool bShaders, bool bTimeline)
+{
+	using namespace AtlasValidateCommandlet;
+
+	int32 ShardIndex = 0;
+	int32 ShardCount = 1;
+	if (const FString* ShardSpec = ParamVals.Find(TEXT("Shard")))
+	{
+		if (!ParseShard(*ShardSpec, ShardIndex, ShardCount))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Invalid -Shard=%s, expected N/M with 1 <= N <= M"), **ShardSpec);
+			return ExitFailure;
+		}
+	}
+
+	FString OutputPath;
+	if (const FString* Output = ParamVals.Find(TEXT("Output")))
+	{
+		OutputPath = *Output;
+	}
+	else if (ShardCount > 1)
+	{
+		// Shard reports are intermediate merge inputs, so they use the compact binary format
+		OutputPath = GetDefaultOutputDir() / FString::Printf(TEXT("Validate.Shard%dof%d%s"), ShardIndex + 1, ShardCount, FAtlasReportSerializer::BinaryExtension);
+	}
+	else
+	{
+		OutputPath = GetDefaultOutputDir() / FString(TEXT("Validate")) + (bCompress ? TEXT(".json.gz") : TEXT(".json"));
+	}
+
+	// The asset registry does not discover content on its own in commandlets
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> AllAssets;
+	FAtlasScanExecutor::GetAllScannableAssets(AllAssets);
+
+	// Sort so every shard (and every rerun) scans in the same order, which is also the order issues are reported in
+	AllAssets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.ObjectPath.ToString().Compare(B.ObjectPath.ToString()) < 0;
+	});
+
+	TArray<FAssetData> Selection;
+	if (ShardCount > 1)
+	{
+		for (const FAssetData& AssetData : AllAssets)
+		{
+			if (GetShardForPackage(AssetData.PackageName, ShardCount) == ShardIndex)
+			{
+				Selection.Add(AssetData);
+			}
+		}
+	}
+	else
+	{
+		Selection = MoveTemp(AllAssets);
+	}
+
+	UE_LOG(LogAtlas, Display, TEXT("Atlas validate: shard %d/%d, %d assets"), ShardIndex + 1, ShardCount, Selection.Num());
+
+	// The permutation rule and the shaders section estimate the same masters; analyze each once
+	if (bShaders)
+	{
+		FAtlasShaderAnalyzer::BeginCache();
+	}
+
+	// Duplicates do not depend on scan results; finding them first lets their issues merge into the scan's stream
+	TArray<FAtlasIssue> DedupIssues;
+	FAtlasReport DedupReport;
+	if (bDedup)
+	{
+		TArray<FAtlasDuplicateGroup> Duplicates;
+		FAtlasDedupEngine::FindDuplicates(Selection, Duplicates);
+		FAtlasDedupEngine::MakeIssues(Duplicates, DedupIssues);
+		FAtlasDedupEngine::FillReport(Duplicates, DedupReport);
+
+		TArray<FAtlasNearDuplicatePair> NearDuplicates;
+		const int32 MaxDistance = UAtlasSettings::Get()->NearDuplicateMaxDistance;
+		FAtlasDedupEngine::FindNearDuplicates(Selection, MaxDistance, Duplicates, NearDuplicates);
+		FAtlasDedupEngine::MakeNearDuplicateIssues(NearDuplicates, MaxDistance, DedupIssues);
+
+		DedupIssues.StableSort(&FAtlasReportSerializer::IsIssueLess);
+	}
+
+	// The timeline is only appended from unsharded runs; sharded runs append it when merging
+	FTimelineBuilder Timeline;
+	FTimelineBuilder* TimelinePtr = bTimeline && ShardCount == 1 ? &Timeline : nullptr;
+
+	FReportStats ReportStats;
+	FAtlasScanStats Stats;
+
+	// Issues, shaders and totals, in that order; the JSON writer streams them straight to disk
+	auto WriteReport = [&](auto& Writer)
+	{
+		WriteScanned(Selection, DedupIssues, Writer, ReportStats, Stats, TimelinePtr);
+
+		if (bShaders)
+		{
+			TArray<FAtlasShaderStat> Shaders;
+			FAtlasShaderAnalyzer::Analyze(Selection, Shaders);
+
+			for (const FAtlasShaderStat& Shader : Shaders)
+			{
+				Writer.WriteShader(Shader);
+			}
+		}
+
+		if (bTimeline)
+		{
+			// Only the totals go into the report; shard totals add up because shards never share a package
+			FAtlasReport SizeReport;
+			FAtlasOverviewStats::Collect(Selection, SizeReport);
+			ReportStats.TotalProjectBytes = SizeReport.TotalProjectBytes;
+			ReportStats.TotalVRAMBytes = SizeReport.TotalVRAMBytes;
+		}
+
+		Writer.SetTotals(ReportStats.TotalProjectBytes, ReportStats.TotalVRAMBytes, DedupReport.ReclaimableBytes, DedupReport.ReclaimableVRAMBytes);
+	};
+
+	bool bWritten = false;
+	if (FAtlasReportSerializer::IsBinaryPath(OutputPath))
+	{
+		FAtlasBinaryReportWriter Writer;
+		WriteReport(Writer);
+		bWritten = Writer.Save(OutputPath);
+	}
+	else
+	{
+		FAtlasReportWriter Writer;
+		if (Writer.Open(OutputPath, bCompress))
+		{
+			WriteReport(Writer);
+			Writer.SetProfile(Stats.Profile);
+			bWritten = Writer.Close();
+		}
+	}
+
+	if (bShaders)
+	{
+		FAtlasShaderAnalyzer::EndCache();
+	}
+
+	if (!bWritten)
+	{
+		return ExitFailure;
+	}
+
+	if (TimelinePtr && !Timeline.Append(ReportStats.TotalProjectBytes, ReportStats.TotalVRAMBytes))
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Atlas validate: failed to append the timeline snapshot"));
+	}
+
+	FAtlasScanProfiler::LogSummary(Stats.Profile);
+
+	const int32 ExitCode = GetExitCode(ReportStats.NumWarnings, ReportStats.NumErrors);
+	UE_LOG(LogAtlas, Display, TEXT("Atlas validate: %d issues in %d assets (%d loaded), report written to %s, exit code %d"),
+		ReportStats.NumIssues, Stats.NumAssets, Stats.NumLoaded, *OutputPath, ExitCode);
+
+	return ExitCode;
+}
+
+int32 UAtlasValidateCommandlet::RunMerge(const TMap<FString, FString>& ParamVals, bool bCompress, bool bTimeline)
+{
+	using namespace AtlasValidateCommandlet;
+
+	TArray<FString> InputPaths;
+	if (const FString* Inputs = ParamVals.Find(TEXT("Inputs")))
+	{
+		Inputs->ParseIntoArray(InputPaths, TEXT(";"), true);
+	}
+	else
+	{
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *(GetDefaultOutputDir() / TEXT("Validate.Shard*")), true, false);
+		FileNames.Sort();
+
+		for (const FString& FileName : FileNames)
+		{
+			InputPaths.Add(GetDefaultOutputDir() / FileName);
+		}
+	}
+
+	if (InputPaths.Num() == 0)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Atlas merge: no shard reports found"));
+		return ExitFailure;
+	}
+
+	TArray<TUniquePtr<FMergeSource>> Sources;
+	for (const FString& InputPath : InputPaths)
+	{
+		TUniquePtr<FMergeSource> Source = MakeUnique<FMergeSource>();
+		if (!Source->Open(InputPath))
+		{
+			return ExitFailure;
+		}
+		Sources.Add(MoveTemp(Source));
+	}
+
+	const FString* Output = ParamVals.Find(TEXT("Output"));
+	const FString OutputPath = Output ? *Output : GetDefaultOutputDir() / FString(TEXT("Validate")) + (bCompress ? TEXT(".json.gz") : TEXT(".json"));
+
+	FReportStats Stats;
+	FTimelineBuilder Timeline;
+	FTimelineBuilder* TimelinePtr = bTimeline ? &Timeline : nullptr;
+	bool bWritten = false;
+	if (FAtlasReportSerializer::IsBinaryPath(OutputPath))
+	{
+		FAtlasBinaryReportWriter Writer;
+		WriteMerged(Sources, Writer, Stats, TimelinePtr);
+		bWritten = Writer.Save(OutputPath);
+	}
+	else
+	{
+		FAtlasReportWriter Writer;
+		if (Writer.Open(OutputPath, bCompress))
+		{
+			WriteMerged(Sources, Writer, Stats, TimelinePtr);
+			bWritten = Writer.Close();
+		}
+	}
+
+	if (!bWritten)
+	{
+		return ExitFailure;
+	}
+
+	if (bTimeline && !Timeline.Append(Stats.TotalProjectBytes, Stats.TotalVRAMBytes))
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Atlas merge: failed to append the timeline snapshot"));
+	}
+
+	const int32 ExitCode = GetExitCode(Stats.NumWarnings, Stats.NumErrors);
+	UE_LOG(LogAtlas, Display, TEXT("Atlas merge: %d reports, %d issues, written to %s, exit code %d"),
+		InputPaths.Num(), Stats.NumIssues, *OutputPath, ExitCode);
+
+	return ExitCode;
+}
+
+bool UAtlasValidateCommandlet::ParseShard(const FString& ShardSpec, int32& OutShardIndex, int32& OutShardCount)
+{
+	FString IndexString;
+	FString CountString;
+	if (!ShardSpec.Split(TEXT("/"), &IndexString, &CountString) || !IndexString.IsNumeric() || !CountString.IsNumeric())
+	{
+		return false;
+	}
+
+	const int32 ShardNumber = FCString::Atoi(*IndexString);
+	const int32 ShardCount = FCString::Atoi(*CountString);
+	if (ShardCount < 1 || ShardNumber < 1 || ShardNumber > ShardCount)
+	{
+		return false;
+	}
+
+	OutShardIndex = ShardNumber - 1;
+	OutShardCount = ShardCount;
+	return true;
+}
+
+int32 UAtlasValidateCommandlet::GetShardForPackage(FName PackageName, int32 ShardCount)
+{
+	// Hash the lowercase path string: FName hashes and indices differ between processes
+	const FString PackagePath = PackageName.ToString().ToLower();
+	return static_cast<int32>(FCrc::StrCrc32(*PackagePath) % static_cast<uint32>(ShardCount));
+}
+
+int32 UAtlasValidateCommandlet::GetExitCode(int32 NumWarnings, int32 NumErrors)
+{
+	using namespace AtlasValidateCommandlet;
+
+	if (NumErrors > 0)
+	{
+		const UAtlasSettings* Settings = UAtlasSettings::Get();
+		return (Settings && Settings->bBlockBuildOnRed) ? ExitErrors : ExitWarnings;
+	}
+
+	return NumWarnings > 0 ? ExitWarnings : ExitSuccess;
+}
+
+FString UAtlasValidateCommandlet::GetDefaultOutputDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Atlas");
+}
@@ -0,0 +1,74 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AtlasValidateCommandlet.generated.h"
+
+/**
+ * Runs Atlas validation headlessly for CI
+ *
+ * Validate (optionally one shard of the project):
+ *   UnrealEditor-Cmd Project.uproject -run=AtlasValidate [-Shard=N/M] [-Output=Path] [-Compress] [-Dedup] [-Shaders] [-Timeline] -nullrhi -unattended
+ *
+ * Merge shard outputs into one report:
+ *   UnrealEditor-Cmd Project.uproject -run=AtlasValidate -Merge [-Inputs=A.atlasreport;B.atlasreport] [-Output=Path] [-Compress] [-Timeline] -nullrhi
+ *
+ * Shard runs write the binary .atlasreport format by default; other outputs are JSON unless -Output ends in .atlasreport.
+ * -Compress writes gzip-compressed JSON (.json.gz). Input formats are detected automatically.
+ * -Dedup also reports identical textures and meshes and the bytes consolidating them would reclaim,
+ * and textures that look alike; with shards, only duplicates within the same shard are found.
+ * -Shaders adds the estimated shader permutations of every master material to the report.
+ * -Timeline measures project and texture memory size and appends a snapshot to the Atlas timeline
+ * (see FAtlasTimeline); shard runs only record the sizes in their report, and the merge appends.
+ * Every validate run logs the rules and assets that took the most time; JSON reports also keep them
+ * in their "profile" object (see FAtlasScanProfiler).
+ *
+ * Exit codes: 0 = no warnings or errors, 1 = warnings (or errors with bBlockBuildOnRed off), 2 = errors
+ */
+UCLASS()
+class UAtlasValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAtlasValidateCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+	/**
+	 * Parse a 1-based "N/M" shard specification
+	 * @param ShardSpec The value of -Shard
+	 * @param OutShardIndex Zero-based shard index
+	 * @param OutShardCount Total number of shards
+	 * @return True if the specification is valid
+	 */
+	static bool ParseShard(const FString& ShardSpec, int32& OutShardIndex, int32& OutShardCount);
+
+	/**
+	 * Stable shard assignment of a package, independent of machine and registry order
+	 * @param PackageName The package to assign
+	 * @param ShardCount Total number of shards
+	 * @return Zero-based shard index
+	 */
+	static int32 GetShardForPackage(FName PackageName, int32 ShardCount);
+
+	/**
+	 * Compute the process exit code from severity counts
+	 * @return 0, 1 or 2 as documented on the class
+	 */
+	static int32 GetExitCode(int32 NumWarnings, int32 NumErrors);
+
+private:
+	/** Scan the project (or one shard of it) and write the report */
+	int32 RunValidate(const TMap<FString, FString>& ParamVals, bool bCompress, bool bDedup, bool bShaders, bool bTimeline);
+
+	/** Combine shard reports into one */
+	int32 RunMerge(const TMap<FString, FString>& ParamVals, bool bCompress, bool bTimeline);
+
+	/** Default directory for reports */
+	static FString GetDefaultOutputDir();
+};
@@ -1,6 +1,7 @@
 // Copyright Atlas Team. All Rights Reserved.
 
 #include "AtlasAssetUtils.h"
+#include "AtlasFixExecutor.h"
 #include "AtlasSettings.h"
 #include "AtlasRuntime.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -9,6 +10,7 @@
 #include "EditorAssetLibrary.h"
 #include "FileHelpers.h"
 #include "ContentBrowserModule.h"
+#include "UObject/ObjectRedirector.h"
 #include "IContentBrowserSingleton.h"
 
 bool FAtlasAssetUtils::MoveAsset(const FName& SrcPath, const FString& DestPath)
@@ -52,6 +54,63 @@ bool FAtlasAssetUtils::RenameAsset(const FName& AssetPath, const FString& NewNam
 	return false;
 }
 
+bool FAtlasAssetUtils::ConsolidateAssets(UObject* AssetToKeep, const TArray<UObject*>& AssetsToConsolidate)
+{
+	if (!AssetToKeep || AssetsToConsolidate.Num() == 0)
+	{
+		return false;
+	}
+
+	// Paths must be captured first, consolidation replaces the objects with redirectors
+	TArray<FString> ConsolidatedPaths;
+	for (const UObject* Asset : AssetsToConsolidate)
+	{
+		if (Asset)
+		{
+			ConsolidatedPaths.Add(Asset->GetPathName());
+		}
+	}
+
+	if (!UEditorAssetLibrary::ConsolidateAssets(AssetToKeep, AssetsToConsolidate))
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Failed to consolidate %d assets into %s"), AssetsToConsolidate.Num(), *AssetToKeep->GetPathName());
+		return false;
+	}
+
+	// Within a fix batch the redirectors are fixed up together with those of every other fix
+	if (FAtlasFixExecutor::IsBatching())
+	{
+		FAtlasFixExecutor::FixupRedirectors(ConsolidatedPaths);
+		UE_LOG(LogAtlas, Log, TEXT("Consolidated %d assets into %s"), ConsolidatedPaths.Num(), *AssetToKeep->GetPathName());
+		return true;
+	}
+
+	const int32 NumFixed = FixupRedirectors(ConsolidatedPaths);
+	UE_LOG(LogAtlas, Log, TEXT("Consolidated %d assets into %s (%d redirectors fixed up)"), ConsolidatedPaths.Num(), *AssetToKeep->GetPathName(), NumFixed);
+	return true;
+}
+
+int32 FAtlasAssetUtils::FixupRedirectors(const TArray<FString>& ObjectPaths)
+{
+	TArray<UObjectRedirector*> Redirectors;
+	for (const FString& ObjectPath : ObjectPaths)
+	{
+		if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *ObjectPath))
+		{
+			Redirectors.Add(Redirector);
+		}
+	}
+
+	if (Redirectors.Num() == 0)
+	{
+		return 0;
+	}
+
+	FAssetToolsModule& AssetToolsModule = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools");
+	AssetToolsModule.Get().FixupReferencers(Redirectors, false);
+	return Redirectors.Num();
+}
+
 bool FAtlasAssetUtils::Reimport(UObject* Asset)
 {
 	if (!Asset)
@@ -119,3 +178,14 @@ FString FAtlasAssetUtils::GetPrefixForAssetType(const FName& AssetType)
 	}
 	return FString();
 }
+
+bool FAtlasAssetUtils::IsAssetOfClass(const FAssetData& AssetData, const UClass* Class)
+{
+	if (!Class)
+	{
+		return false;
+	}
+
+	const UClass* AssetClass = AssetData.GetClass();
+	return AssetClass && AssetClass->IsChildOf(Class);
+}
@@ -26,6 +26,22 @@ public:
 	 */
 	static bool RenameAsset(const FName& AssetPath, const FString& NewName);
 
+	/**
+	 * Replace every reference to a set of assets with another asset, then fix up the redirectors left behind
+	 * The consolidated assets are deleted; referencing packages are resaved to point at the kept asset.
+	 * @param AssetToKeep The asset references are redirected to
+	 * @param AssetsToConsolidate Assets to replace and delete
+	 * @return True if every asset was consolidated
+	 */
+	static bool ConsolidateAssets(UObject* AssetToKeep, const TArray<UObject*>& AssetsToConsolidate);
+
+	/**
+	 * Point every referencer of a set of redirectors at their destination and delete the redirectors
+	 * @param ObjectPaths Object paths that may now hold redirectors
+	 * @return Number of redirectors fixed up
+	 */
+	static int32 FixupRedirectors(const TArray<FString>& ObjectPaths);
+
 	/**
 	 * Reimport an asset from its source file
 	 * @param Asset The asset to reimport
@@ -67,4 +83,12 @@ public:
 	 * @return The prefix, or empty string if not found
 	 */
 	static FString GetPrefixForAssetType(const FName& AssetType);
+
+	/**
+	 * Check if an asset registry entry is of a class or one of its subclasses, without loading it
+	 * @param AssetData The asset registry entry
+	 * @param Class The class to test against
+	 * @return True if the asset's class is a child of Class
+	 */
+	static bool IsAssetOfClass(const struct FAssetData& AssetData, const UClass* Class);
 };
@@ -0,0 +1,325 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasFixExecutor.h"
+#include "AtlasAssetUtils.h"
+#include "AtlasMeshUtils.h"
+#include "AtlasScanExecutor.h"
+#include "AtlasScanProfiler.h"
+#include "AtlasRuntime.h"
+#include "Algo/StableSort.h"
+#include "AssetToolsModule.h"
+#include "IAssetTools.h"
+#include "Engine/StaticMesh.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ScopedTransaction.h"
+
+/** Work recorded by the edit helpers during one batch */
+struct FAtlasFixExecutor::FBatch
+{
+	/** Objects already recorded in the transaction */
+	TSet<UObject*> ModifiedObjects;
+
+	/** Objects waiting for their PostEditChange, in the order they were first edited */
+	TArray<TWeakObjectPtr<UObject>> EditedObjects;
+	TSet<UObject*> EditedSet;
+
+	/** Renames and moves for the single RenameAssets call */
+	TArray<FAssetRenameData> Renames;
+	TSet<UObject*> RenamedSet;
+
+	/** Index into AppliedFixes of the fix that queued each rename, INDEX_NONE outside ApplyFixes */
+	TArray<int32> RenameFixes;
+
+	/** Result of every fix function run by ApplyFixes; cleared for fixes whose renames fail */
+	TBitArray<> AppliedFixes;
+
+	/** Fix currently running in ApplyFixes, INDEX_NONE otherwise */
+	int32 CurrentFix = INDEX_NONE;
+
+	/** Object paths that hold redirectors once the batch ran */
+	TArray<FString> RedirectorPaths;
+
+	/** Meshes waiting for LODs, by target LOD count and triangle budget */
+	TMap<TTuple<int32, int32>, TArray<UStaticMesh*>> LODRequests;
+};
+
+FAtlasFixExecutor::FBatch* FAtlasFixExecutor::ActiveBatch = nullptr;
+
+void FAtlasFixExecutor::ApplyFixes(TArrayView<FAtlasIssue> Issues, bool bSavePackages, FAtlasFixStats* OutStats)
+{
+	// Group by asset, then by rule, so every fix of an asset runs back to back
+	TArray<FAtlasIssue*> Ordered;
+	Ordered.Reserve(Issues.Num());
+	for (FAtlasIssue& Issue : Issues)
+	{
+		if (Issue.bCanFix)
+		{
+			Ordered.Add(&Issue);
+		}
+	}
+
+	Algo::StableSort(Ordered, [](const FAtlasIssue* A, const FAtlasIssue* B)
+	{
+		const int32 Compare = A->AssetPath.Compare(B->AssetPath);
+		return Compare != 0 ? Compare < 0 : A->RuleName.LexicalLess(B->RuleName);
+	});
+
+	FScopedSlowTask Progress(Ordered.Num(), FText::FromString(TEXT("Fixing issues...")));
+	Progress.MakeDialog();
+
+	FAtlasFixStats Stats;
+	RunBatch(FText::FromString(FString::Printf(TEXT("Atlas: Fix %d Issues"), Ordered.Num())), [&Ordered, &Progress]()
+	{
+		for (FAtlasIssue* Issue : Ordered)
+		{
+			Progress.EnterProgressFrame(1.0f);
+
+			// A fix that only queued a rename is not applied until the rename pass moved the asset
+			FAtlasTraceScope TraceScope(TEXT("Fix"), Issue->RuleName);
+			ActiveBatch->CurrentFix = ActiveBatch->AppliedFixes.Num();
+			const bool bApplied = FAtlasScanExecutor::ResolveFixFunction(*Issue) && Issue->FixFunction();
+			ActiveBatch->AppliedFixes.Add(bApplied);
+		}
+
+		ActiveBatch->CurrentFix = INDEX_NONE;
+	}, bSavePackages, &Stats);
+
+	Stats.NumIssues = Ordered.Num();
+
+	UE_LOG(LogAtlas, Log, TEXT("Applied %d of %d fixes in %.2fs: %d objects edited, %d assets renamed, %d packages saved"),
+		Stats.NumApplied, Stats.NumIssues, Stats.Seconds, Stats.NumObjectsEdited, Stats.NumRenamed, Stats.NumPackagesSaved);
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+void FAtlasFixExecutor::RunBatch(const FText& Description, TFunctionRef<void()> Work, bool bSavePackages, FAtlasFixStats* OutStats)
+{
+	check(IsInGameThread());
+	checkf(!ActiveBatch, TEXT("Fix batches cannot be nested"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	FAtlasFixStats Stats;
+
+	{
+		FScopedTransaction Transaction(Description);
+
+		FBatch Batch;
+		ActiveBatch = &Batch;
+		Work();
+		ActiveBatch = nullptr;
+
+		Flush(Batch, bSavePackages, Stats);
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+bool FAtlasFixExecutor::IsBatching()
+{
+	return ActiveBatch != nullptr;
+}
+
+void FAtlasFixExecutor::BeginEdit(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	if (!ActiveBatch)
+	{
+		Object->Modify();
+		return;
+	}
+
+	// One snapshot per object is enough for the whole transaction
+	bool bAlreadyModified = false;
+	ActiveBatch->ModifiedObjects.Add(Object, &bAlreadyModified);
+	if (!bAlreadyModified)
+	{
+		Object->Modify();
+	}
+}
+
+void FAtlasFixExecutor::EndEdit(UObject* Object)
+{
+	if (!Object)
+	{
+		return;
+	}
+
+	if (!ActiveBatch)
+	{
+		Object->PostEditChange();
+		Object->MarkPackageDirty();
+		return;
+	}
+
+	bool bAlreadyEdited = false;
+	ActiveBatch->EditedSet.Add(Object, &bAlreadyEdited);
+	if (!bAlreadyEdited)
+	{
+		ActiveBatch->EditedObjects.Add(Object);
+	}
+}
+
+bool FAtlasFixExecutor::RenameAsset(const FString& AssetPath, const FString& NewName)
+{
+	if (!ActiveBatch)
+	{
+		return FAtlasAssetUtils::RenameAsset(FName(*AssetPath), NewName);
+	}
+
+	UObject* Asset = FAtlasAssetUtils::LoadAsset(AssetPath);
+	if (!Asset)
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Cannot rename asset - does not exist: %s"), *AssetPath);
+		return false;
+	}
+
+	return MoveAsset(AssetPath, FPaths::GetPath(Asset->GetOutermost()->GetName()) / NewName);
+}
+
+bool FAtlasFixExecutor::MoveAsset(const FString& AssetPath, const FString& DestPath)
+{
+	if (!ActiveBatch)
+	{
+		return FAtlasAssetUtils::MoveAsset(FName(*AssetPath), DestPath);
+	}
+
+	UObject* Asset = FAtlasAssetUtils::LoadAsset(AssetPath);
+	if (!Asset)
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Cannot move asset - source does not exist: %s"), *AssetPath);
+		return false;
+	}
+
+	// An asset can only end up in one place; the first fix that moves it wins
+	bool bAlreadyRenamed = false;
+	ActiveBatch->RenamedSet.Add(Asset, &bAlreadyRenamed);
+	if (bAlreadyRenamed)
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Skipped second rename of %s in the same batch"), *AssetPath);
+		return false;
+	}
+
+	// The rename leaves a redirector at the old path
+	ActiveBatch->RedirectorPaths.Add(Asset->GetPathName());
+	ActiveBatch->Renames.Emplace(Asset, FPaths::GetPath(DestPath), FPaths::GetBaseFilename(DestPath));
+	ActiveBatch->RenameFixes.Add(ActiveBatch->CurrentFix);
+	return true;
+}
+
+bool FAtlasFixExecutor::GenerateLODs(UStaticMesh* Mesh, int32 TargetLODs, int32 MaxTris)
+{
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	if (!ActiveBatch)
+	{
+		return FAtlasMeshUtils::GenerateLODsIfNeeded(Mesh, TargetLODs, MaxTris);
+	}
+
+	ActiveBatch->LODRequests.FindOrAdd(MakeTuple(TargetLODs, MaxTris)).AddUnique(Mesh);
+	return true;
+}
+
+void FAtlasFixExecutor::FixupRedirectors(const TArray<FString>& ObjectPaths)
+{
+	if (!ActiveBatch)
+	{
+		FAtlasAssetUtils::FixupRedirectors(ObjectPaths);
+		return;
+	}
+
+	ActiveBatch->RedirectorPaths.Append(ObjectPaths);
+}
+
+void FAtlasFixExecutor::Flush(FBatch& Batch, bool bSavePackages, FAtlasFixStats& Stats)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Atlas Fix Flush", AtlasChannel);
+
+	TSet<UPackage*> TouchedPackages;
+
+	// One PostEditChange per object, however many of its properties were fixed
+	for (const TWeakObjectPtr<UObject>& WeakObject : Batch.EditedObjects)
+	{
+		if (UObject* Object = WeakObject.Get())
+		{
+			Object->PostEditChange();
+			Object->MarkPackageDirty();
+			TouchedPackages.Add(Object->GetOutermost());
+			++Stats.NumObjectsEdited;
+		}
+	}
+
+	// One async mesh build per LOD setting
+	for (const TPair<TTuple<int32, int32>, TArray<UStaticMesh*>>& Request : Batch.LODRequests)
+	{
+		FAtlasMeshUtils::GenerateLODsBatch(Request.Value, Request.Key.Get<0>(), Request.Key.Get<1>());
+
+		for (UStaticMesh* Mesh : Request.Value)
+		{
+			TouchedPackages.Add(Mesh->GetOutermost());
+		}
+	}
+
+	// One rename pass, so referencers shared by many renamed assets are loaded and resaved once
+	if (Batch.Renames.Num() > 0)
+	{
+		IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+		if (!AssetTools.RenameAssets(Batch.Renames))
+		{
+			UE_LOG(LogAtlas, Warning, TEXT("Some of %d batched renames failed"), Batch.Renames.Num());
+		}
+
+		for (int32 Index = 0; Index < Batch.Renames.Num(); ++Index)
+		{
+			const FAssetRenameData& Rename = Batch.Renames[Index];
+			UObject* Asset = Rename.Asset.Get();
+			if (Asset && Asset->GetOutermost()->GetName() == Rename.NewPackagePath / Rename.NewName)
+			{
+				TouchedPackages.Add(Asset->GetOutermost());
+				++Stats.NumRenamed;
+			}
+			else if (Batch.RenameFixes[Index] != INDEX_NONE)
+			{
+				Batch.AppliedFixes[Batch.RenameFixes[Index]] = false;
+			}
+		}
+	}
+
+	Stats.NumApplied = Batch.AppliedFixes.CountSetBits();
+
+	// Redirectors left by renames and consolidations are fixed up together
+	if (Batch.RedirectorPaths.Num() > 0)
+	{
+		const int32 NumFixed = FAtlasAssetUtils::FixupRedirectors(Batch.RedirectorPaths);
+		UE_LOG(LogAtlas, Log, TEXT("Fixed up %d redirectors"), NumFixed);
+	}
+
+	if (bSavePackages && TouchedPackages.Num() > 0)
+	{
+		TArray<UPackage*> Packages = TouchedPackages.Array();
+		if (UEditorLoadingAndSavingUtils::SavePackages(Packages, true))
+		{
+			Stats.NumPackagesSaved = Packages.Num();
+		}
+		else
+		{
+			UE_LOG(LogAtlas, Warning, TEXT("Failed to save some of %d fixed packages"), Packages.Num());
+		}
+	}
+}
@@ -0,0 +1,135 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+class UStaticMesh;
+
+/**
+ * Counters collected while applying a batch of fixes
+ */
+struct FAtlasFixStats
+{
+	/** Number of issues whose fix was attempted */
+	int32 NumIssues;
+
+	/** Number of fix functions that succeeded; a fix that renames or moves its asset counts once the rename pass did */
+	int32 NumApplied;
+
+	/** Number of objects that got one deferred PostEditChange */
+	int32 NumObjectsEdited;
+
+	/** Number of assets renamed or moved in the single rename pass */
+	int32 NumRenamed;
+
+	/** Number of packages saved */
+	int32 NumPackagesSaved;
+
+	/** Wall time of the batch */
+	double Seconds;
+
+	FAtlasFixStats()
+		: NumIssues(0)
+		, NumApplied(0)
+		, NumObjectsEdited(0)
+		, NumRenamed(0)
+		, NumPackagesSaved(0)
+		, Seconds(0.0)
+	{
+	}
+};
+
+/**
+ * Applies many fixes as one undoable batch
+ *
+ * Fix functions call the edit helpers below instead of PostEditChange, FAtlasAssetUtils::RenameAsset
+ * and friends. Outside a batch the helpers act immediately. Inside ApplyFixes they only record the work:
+ * each edited object gets a single PostEditChange (one texture rebuild however many of its properties
+ * were fixed), LOD generation runs as one mesh build per setting, renames and moves go through one
+ * IAssetTools::RenameAssets call followed by one redirector fixup, and touched packages are saved together.
+ *
+ * Property edits are recorded in one transaction and can be undone. Renames, consolidations and
+ * redirector fixups are not transactional in the editor and stay applied.
+ * Game thread only.
+ */
+class ATLASEDITOR_API FAtlasFixExecutor
+{
+public:
+	/**
+	 * Apply the fixes of a set of issues
+	 * Issues are grouped by asset so every fix of an asset runs back to back. Issues without a fix
+	 * function (e.g. restored from the scan cache) get one through FAtlasScanExecutor::ResolveFixFunction.
+	 * @param Issues Issues to fix; issues that cannot be fixed are skipped
+	 * @param bSavePackages Save every package the batch modified
+	 * @param OutStats Optional batch counters
+	 */
+	static void ApplyFixes(TArrayView<FAtlasIssue> Issues, bool bSavePackages, FAtlasFixStats* OutStats = nullptr);
+
+	/**
+	 * Run arbitrary edits as one batch; the helpers below called from Work are deferred like in ApplyFixes
+	 * @param Description Transaction name shown in the undo history
+	 * @param Work Edits to record
+	 * @param bSavePackages Save every package the batch modified
+	 * @param OutStats Optional batch counters; NumIssues and NumApplied are left at zero
+	 */
+	static void RunBatch(const FText& Description, TFunctionRef<void()> Work, bool bSavePackages, FAtlasFixStats* OutStats = nullptr);
+
+	/**
+	 * Check if fixes are currently being batched
+	 */
+	static bool IsBatching();
+
+	/**
+	 * Prepare an object for property changes; records it in the transaction once per batch
+	 * @param Object The object about to change
+	 */
+	static void BeginEdit(UObject* Object);
+
+	/**
+	 * Finish property changes on an object: PostEditChange and dirty its package, deferred to the end of a batch
+	 * @param Object The object that changed
+	 */
+	static void EndEdit(UObject* Object);
+
+	/**
+	 * Rename an asset in place, deferred to the single rename pass of a batch
+	 * @param AssetPath Object path of the asset
+	 * @param NewName New asset name
+	 * @return True if the asset was renamed or queued for renaming
+	 */
+	static bool RenameAsset(const FString& AssetPath, const FString& NewName);
+
+	/**
+	 * Move an asset, deferred to the single rename pass of a batch
+	 * @param AssetPath Object path of the asset
+	 * @param DestPath Destination asset path, e.g. /Game/Textures/T_Rock
+	 * @return True if the asset was moved or queued for moving
+	 */
+	static bool MoveAsset(const FString& AssetPath, const FString& DestPath);
+
+	/**
+	 * Generate LODs for a mesh; within a batch, meshes with the same settings share one build
+	 * @param Mesh The mesh to process
+	 * @param TargetLODs Number of LODs the mesh should have
+	 * @param MaxTris Maximum triangles for LOD 0 before generating LODs
+	 * @return True if the build was started or queued
+	 */
+	static bool GenerateLODs(UStaticMesh* Mesh, int32 TargetLODs, int32 MaxTris);
+
+	/**
+	 * Fix up the redirectors left at a set of object paths, deferred to the single fixup of a batch
+	 * @param ObjectPaths Object paths that now hold redirectors
+	 */
+	static void FixupRedirectors(const TArray<FString>& ObjectPaths);
+
+private:
+	struct FBatch;
+
+	/** Run the recorded work of a batch */
+	static void Flush(FBatch& Batch, bool bSavePackages, FAtlasFixStats& Stats);
+
+	/** Batch being recorded by ApplyFixes, null otherwise */
+	static FBatch* ActiveBatch;
+};
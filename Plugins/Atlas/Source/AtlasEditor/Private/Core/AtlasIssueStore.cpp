@@ -0,0 +1,446 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasIssueStore.h"
+#include "AtlasScanExecutor.h"
+#include "AtlasFixExecutor.h"
+#include "Misc/PackageName.h"
+
+const TCHAR FAtlasIssueStore::ArgMarker = TCHAR(1);
+
+FAtlasIssueStore::FAtlasIssueStore()
+{
+}
+
+void FAtlasIssueStore::Reset()
+{
+	Paths.Reset();
+	PathLookup.Reset();
+	RuleNames.Reset();
+	RuleLookup.Reset();
+	Templates.Reset();
+	TemplateLookup.Reset();
+
+	PathIds.Reset();
+	RuleIds.Reset();
+	Severities.Reset();
+	TemplateIds.Reset();
+	ArgStarts.Reset();
+	CanFixBits.Reset();
+	ArgBlob.Reset();
+	PathRanks.Reset();
+}
+
+void FAtlasIssueStore::Reserve(int32 NumIssues)
+{
+	PathIds.Reserve(NumIssues);
+	RuleIds.Reserve(NumIssues);
+	Severities.Reserve(NumIssues);
+	TemplateIds.Reserve(NumIssues);
+	ArgStarts.Reserve(NumIssues);
+	CanFixBits.Reserve(NumIssues);
+}
+
+int32 FAtlasIssueStore::InternPath(FName Path)
+{
+	if (const int32* ExistingId = PathLookup.Find(Path))
+	{
+		return *ExistingId;
+	}
+
+	PathRanks.Reset();
+	return PathLookup.Add(Path, Paths.Add(Path));
+}
+
+int32 FAtlasIssueStore::InternRule(FName RuleName)
+{
+	if (const int32* ExistingId = RuleLookup.Find(RuleName))
+	{
+		return *ExistingId;
+	}
+
+	checkf(RuleNames.Num() < MAX_uint16, TEXT("Too many distinct rules in one issue store"));
+	return RuleLookup.Add(RuleName, RuleNames.Add(RuleName));
+}
+
+int32 FAtlasIssueStore::InternTemplate(const FString& Template)
+{
+	if (const int32* ExistingId = TemplateLookup.Find(Template))
+	{
+		return *ExistingId;
+	}
+
+	return TemplateLookup.Add(Template, Templates.Add(Template));
+}
+
+int32 FAtlasIssueStore::Add(const FAtlasIssue& Issue)
+{
+	FString Template;
+	TArray<FString> Args;
+	SplitMessage(Issue.Message, Template, Args);
+
+	PathIds.Add(InternPath(FName(*Issue.AssetPath)));
+	RuleIds.Add(static_cast<uint16>(InternRule(Issue.RuleName)));
+	Severities.Add(static_cast<uint8>(Issue.Severity));
+	TemplateIds.Add(InternTemplate(Template));
+	ArgStarts.Add(ArgBlob.Num());
+	CanFixBits.Add(Issue.bCanFix);
+
+	for (const FString& Arg : Args)
+	{
+		ArgBlob.Append(*Arg, Arg.Len());
+		ArgBlob.Add(TCHAR(0));
+	}
+
+	return PathIds.Num() - 1;
+}
+
+void FAtlasIssueStore::Append(TConstArrayView<FAtlasIssue> Issues)
+{
+	Reserve(Num() + Issues.Num());
+	for (const FAtlasIssue& Issue : Issues)
+	{
+		Add(Issue);
+	}
+}
+
+FString FAtlasIssueStore::GetMessage(int32 Index) const
+{
+	const FString& Template = Templates[TemplateIds[Index]];
+
+	FString Message;
+	Message.Reserve(Template.Len());
+
+	const TCHAR* Arg = ArgBlob.GetData() + ArgStarts[Index];
+	for (const TCHAR Char : Template)
+	{
+		if (Char != ArgMarker)
+		{
+			Message.AppendChar(Char);
+			continue;
+		}
+
+		while (*Arg)
+		{
+			Message.AppendChar(*Arg++);
+		}
+		++Arg;
+	}
+
+	return Message;
+}
+
+FAtlasIssue FAtlasIssueStore::GetIssue(int32 Index) const
+{
+	return FAtlasIssue(GetAssetPath(Index).ToString(), GetRuleName(Index), GetSeverity(Index), GetMessage(Index), CanFix(Index));
+}
+
+void FAtlasIssueStore::ToArray(TArray<FAtlasIssue>& OutIssues) const
+{
+	OutIssues.Reserve(OutIssues.Num() + Num());
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		OutIssues.Add(GetIssue(Index));
+	}
+}
+
+bool FAtlasIssueStore::ApplyFix(int32 Index) const
+{
+	if (!CanFix(Index))
+	{
+		return false;
+	}
+
+	FAtlasIssue Issue = GetIssue(Index);
+	return FAtlasScanExecutor::ResolveFixFunction(Issue) && Issue.FixFunction();
+}
+
+int32 FAtlasIssueStore::ApplyFixes(TConstArrayView<int32> Indices, bool bSavePackages) const
+{
+	TArray<FAtlasIssue> Issues;
+	Issues.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		if (CanFix(Index))
+		{
+			Issues.Add(GetIssue(Index));
+		}
+	}
+
+	FAtlasFixStats Stats;
+	FAtlasFixExecutor::ApplyFixes(Issues, bSavePackages, &Stats);
+	return Stats.NumApplied;
+}
+
+int32 FAtlasIssueStore::NumWithSeverity(EAtlasSeverity Severity) const
+{
+	const uint8 Value = static_cast<uint8>(Severity);
+
+	int32 Count = 0;
+	for (const uint8 IssueSeverity : Severities)
+	{
+		Count += IssueSeverity == Value ? 1 : 0;
+	}
+	return Count;
+}
+
+void FAtlasIssueStore::Query(const FAtlasIssueFilter& Filter, TArray<int32>& OutIndices) const
+{
+	// Resolve rule and path conditions against the interned tables once
+	TBitArray<> RuleMatches(Filter.RuleNames.Num() == 0, RuleNames.Num());
+	for (const FName RuleName : Filter.RuleNames)
+	{
+		if (const int32* RuleId = RuleLookup.Find(RuleName))
+		{
+			RuleMatches[*RuleId] = true;
+		}
+	}
+
+	TBitArray<> PathMatches(true, Paths.Num());
+	if (!Filter.PathFilter.IsEmpty())
+	{
+		for (int32 PathId = 0; PathId < Paths.Num(); ++PathId)
+		{
+			PathMatches[PathId] = Paths[PathId].ToString().Contains(Filter.PathFilter);
+		}
+	}
+
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if ((Filter.SeverityMask & (1 << Severities[Index])) && RuleMatches[RuleIds[Index]] && PathMatches[PathIds[Index]])
+		{
+			OutIndices.Add(Index);
+		}
+	}
+}
+
+const TArray<int32>& FAtlasIssueStore::GetPathRanks() const
+{
+	if (PathRanks.Num() != Paths.Num())
+	{
+		TArray<int32> Order;
+		Order.Reserve(Paths.Num());
+		for (int32 PathId = 0; PathId < Paths.Num(); ++PathId)
+		{
+			Order.Add(PathId);
+		}
+
+		Order.Sort([this](int32 A, int32 B)
+		{
+			return Paths[A].LexicalLess(Paths[B]);
+		});
+
+		PathRanks.SetNumUninitialized(Paths.Num());
+		for (int32 Rank = 0; Rank < Order.Num(); ++Rank)
+		{
+			PathRanks[Order[Rank]] = Rank;
+		}
+	}
+
+	return PathRanks;
+}
+
+void FAtlasIssueStore::Sort(TArray<int32>& Indices, EAtlasIssueSortKey Key, bool bDescending) const
+{
+	const TArray<int32>& Ranks = GetPathRanks();
+
+	TArray<int32> RuleRanks;
+	if (Key == EAtlasIssueSortKey::Rule)
+	{
+		TArray<int32> Order;
+		for (int32 RuleId = 0; RuleId < RuleNames.Num(); ++RuleId)
+		{
+			Order.Add(RuleId);
+		}
+
+		Order.Sort([this](int32 A, int32 B)
+		{
+			return RuleNames[A].LexicalLess(RuleNames[B]);
+		});
+
+		RuleRanks.SetNumUninitialized(RuleNames.Num());
+		for (int32 Rank = 0; Rank < Order.Num(); ++Rank)
+		{
+			RuleRanks[Order[Rank]] = Rank;
+		}
+	}
+
+	// Pack (primary, path rank) into one integer per issue so the sort compares plain numbers
+	TArray<TPair<uint64, int32>> Keys;
+	Keys.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		uint32 Primary = 0;
+		switch (Key)
+		{
+		case EAtlasIssueSortKey::Severity:
+			Primary = Severities[Index];
+			break;
+		case EAtlasIssueSortKey::Rule:
+			Primary = RuleRanks[RuleIds[Index]];
+			break;
+		case EAtlasIssueSortKey::Path:
+			Primary = Ranks[PathIds[Index]];
+			break;
+		}
+
+		if (bDescending)
+		{
+			Primary = MAX_uint32 - Primary;
+		}
+
+		Keys.Emplace((static_cast<uint64>(Primary) << 32) | static_cast<uint32>(Ranks[PathIds[Index]]), Index);
+	}
+
+	Keys.Sort([](const TPair<uint64, int32>& A, const TPair<uint64, int32>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+	});
+
+	for (int32 Position = 0; Position < Keys.Num(); ++Position)
+	{
+		Indices[Position] = Keys[Position].Value;
+	}
+}
+
+int32 FAtlasIssueStore::RemoveIf(TFunctionRef<bool(int32)> Predicate)
+{
+	TArray<TCHAR> NewArgBlob;
+	NewArgBlob.Reserve(ArgBlob.Num());
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < Num(); ++ReadIndex)
+	{
+		if (Predicate(ReadIndex))
+		{
+			continue;
+		}
+
+		// Copy this issue's arguments: one null-terminated string per marker in its template
+		const int32 ArgStart = NewArgBlob.Num();
+		const TCHAR* Arg = ArgBlob.GetData() + ArgStarts[ReadIndex];
+		for (const TCHAR Char : Templates[TemplateIds[ReadIndex]])
+		{
+			if (Char == ArgMarker)
+			{
+				do
+				{
+					NewArgBlob.Add(*Arg);
+				}
+				while (*Arg++);
+			}
+		}
+
+		PathIds[WriteIndex] = PathIds[ReadIndex];
+		RuleIds[WriteIndex] = RuleIds[ReadIndex];
+		Severities[WriteIndex] = Severities[ReadIndex];
+		TemplateIds[WriteIndex] = TemplateIds[ReadIndex];
+		ArgStarts[WriteIndex] = ArgStart;
+		CanFixBits[WriteIndex] = CanFixBits[ReadIndex];
+		++WriteIndex;
+	}
+
+	const int32 NumRemoved = Num() - WriteIndex;
+	if (NumRemoved > 0)
+	{
+		PathIds.SetNum(WriteIndex);
+		RuleIds.SetNum(WriteIndex);
+		Severities.SetNum(WriteIndex);
+		TemplateIds.SetNum(WriteIndex);
+		ArgStarts.SetNum(WriteIndex);
+		CanFixBits.SetNum(WriteIndex, false);
+		ArgBlob = MoveTemp(NewArgBlob);
+		PruneTables();
+	}
+
+	return NumRemoved;
+}
+
+void FAtlasIssueStore::PruneTables()
+{
+	TArray<FName> OldPaths = MoveTemp(Paths);
+	TArray<FString> OldTemplates = MoveTemp(Templates);
+	Paths.Reset();
+	PathLookup.Reset();
+	Templates.Reset();
+	TemplateLookup.Reset();
+	PathRanks.Reset();
+
+	// Re-intern in first-use order; each old entry is looked up once
+	TArray<int32> NewPathIds;
+	NewPathIds.Init(INDEX_NONE, OldPaths.Num());
+	TArray<int32> NewTemplateIds;
+	NewTemplateIds.Init(INDEX_NONE, OldTemplates.Num());
+
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		int32& NewPathId = NewPathIds[PathIds[Index]];
+		if (NewPathId == INDEX_NONE)
+		{
+			NewPathId = InternPath(OldPaths[PathIds[Index]]);
+		}
+		PathIds[Index] = NewPathId;
+
+		int32& NewTemplateId = NewTemplateIds[TemplateIds[Index]];
+		if (NewTemplateId == INDEX_NONE)
+		{
+			NewTemplateId = InternTemplate(OldTemplates[TemplateIds[Index]]);
+		}
+		TemplateIds[Index] = NewTemplateId;
+	}
+}
+
+int32 FAtlasIssueStore::RemovePackages(const TSet<FName>& PackageNames)
+{
+	TBitArray<> PathRemoved(false, Paths.Num());
+	for (int32 PathId = 0; PathId < Paths.Num(); ++PathId)
+	{
+		const FName PackageName(*FPackageName::ObjectPathToPackageName(Paths[PathId].ToString()));
+		PathRemoved[PathId] = PackageNames.Contains(PackageName);
+	}
+
+	return RemoveIf([this, &PathRemoved](int32 Index)
+	{
+		return PathRemoved[PathIds[Index]];
+	});
+}
+
+void FAtlasIssueStore::SplitMessage(const FString& Message, FString& OutTemplate, TArray<FString>& OutArgs)
+{
+	OutTemplate.Reset(Message.Len());
+	OutArgs.Reset();
+
+	const int32 Len = Message.Len();
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		const TCHAR Char = Message[Index];
+
+		// Quoted text: keep the quotes in the template, the content becomes an argument
+		int32 CloseIndex = INDEX_NONE;
+		if (Char == TEXT('\'') && (CloseIndex = Message.Find(TEXT("'"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1)) != INDEX_NONE)
+		{
+			OutArgs.Add(Message.Mid(Index + 1, CloseIndex - Index - 1));
+			OutTemplate.AppendChar(TEXT('\''));
+			OutTemplate.AppendChar(ArgMarker);
+			OutTemplate.AppendChar(TEXT('\''));
+			Index = CloseIndex + 1;
+		}
+		else if (FChar::IsDigit(Char))
+		{
+			int32 End = Index + 1;
+			while (End < Len && (FChar::IsDigit(Message[End]) || (Message[End] == TEXT('.') && End + 1 < Len && FChar::IsDigit(Message[End + 1]))))
+			{
+				++End;
+			}
+
+			OutArgs.Add(Message.Mid(Index, End - Index));
+			OutTemplate.AppendChar(ArgMarker);
+			Index = End;
+		}
+		else
+		{
+			OutTemplate.AppendChar(Char);
+			++Index;
+		}
+	}
+}
@@ -0,0 +1,398 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasLiveValidator.h"
+#include "AtlasScanExecutor.h"
+#include "AtlasScanCache.h"
+#include "AtlasSettings.h"
+#include "AtlasRuntime.h"
+#include "AtlasIssueStore.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+namespace AtlasLiveValidator
+{
+	/** Minimum seconds between scan cache writes while live validation is running */
+	static constexpr double CacheFlushIntervalSeconds = 60.0;
+
+	static bool AreIssuesEqual(const TArray<FAtlasIssue>& A, const TArray<FAtlasIssue>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (A[Index].RuleName != B[Index].RuleName ||
+				A[Index].Severity != B[Index].Severity ||
+				A[Index].AssetPath != B[Index].AssetPath ||
+				A[Index].Message != B[Index].Message)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+FAtlasLiveValidator::FAtlasLiveValidator(FOnAtlasIssuesDelta& InDeltaDelegate)
+	: DeltaDelegate(InDeltaDelegate)
+	, LastCacheFlushTime(0.0)
+	, bRunning(false)
+	, bRegistryReady(false)
+{
+}
+
+FAtlasLiveValidator::~FAtlasLiveValidator()
+{
+	Stop();
+}
+
+void FAtlasLiveValidator::Start()
+{
+	if (bRunning)
+	{
+		return;
+	}
+
+	bRunning = true;
+	LastCacheFlushTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// The initial discovery reports every asset as added; only listen once it is done
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddRaw(this, &FAtlasLiveValidator::BindRegistryEvents);
+	}
+	else
+	{
+		BindRegistryEvents();
+	}
+
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FAtlasLiveValidator::OnPackageSaved);
+
+	UE_LOG(LogAtlas, Log, TEXT("Atlas live validation started"));
+}
+
+void FAtlasLiveValidator::Stop()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+
+	PendingPackages.Reset();
+	DeferredPackages.Reset();
+	PendingDelta = FAtlasIssueDelta();
+	bRunning = false;
+	bRegistryReady = false;
+
+	FAtlasScanCache::Get().Flush();
+
+	UE_LOG(LogAtlas, Log, TEXT("Atlas live validation stopped"));
+}
+
+void FAtlasLiveValidator::BindRegistryEvents()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAtlasLiveValidator::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAtlasLiveValidator::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAtlasLiveValidator::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FAtlasLiveValidator::OnAssetUpdated);
+
+	bRegistryReady = true;
+}
+
+void FAtlasLiveValidator::IngestScanResults(const TArray<FAssetData>& ScannedAssets, const TArray<FAtlasIssue>& Issues)
+{
+	for (const FAssetData& AssetData : ScannedAssets)
+	{
+		IssueIndex.Remove(AssetData.PackageName);
+		PendingPackages.Remove(AssetData.PackageName);
+		CancelDeferred(AssetData.PackageName);
+	}
+
+	for (const FAtlasIssue& Issue : Issues)
+	{
+		const FName PackageName(*FPackageName::ObjectPathToPackageName(Issue.AssetPath));
+		IssueIndex.FindOrAdd(PackageName).Add(Issue);
+	}
+}
+
+void FAtlasLiveValidator::IngestScanResults(const TArray<FAssetData>& ScannedAssets, const FAtlasIssueStore& Store)
+{
+	for (const FAssetData& AssetData : ScannedAssets)
+	{
+		IssueIndex.Remove(AssetData.PackageName);
+		PendingPackages.Remove(AssetData.PackageName);
+		CancelDeferred(AssetData.PackageName);
+	}
+
+	// Paths are interned in the store, so most issues reuse the package name of the previous one
+	FName LastAssetPath;
+	TArray<FAtlasIssue>* PackageIssues = nullptr;
+	for (int32 Index = 0; Index < Store.Num(); ++Index)
+	{
+		const FName AssetPath = Store.GetAssetPath(Index);
+		if (!PackageIssues || AssetPath != LastAssetPath)
+		{
+			const FName PackageName(*FPackageName::ObjectPathToPackageName(AssetPath.ToString()));
+			PackageIssues = &IssueIndex.FindOrAdd(PackageName);
+			LastAssetPath = AssetPath;
+		}
+
+		PackageIssues->Add(Store.GetIssue(Index));
+	}
+}
+
+void FAtlasLiveValidator::GetAllIssues(TArray<FAtlasIssue>& OutIssues) const
+{
+	for (const TPair<FName, TArray<FAtlasIssue>>& Pair : IssueIndex)
+	{
+		OutIssues.Append(Pair.Value);
+	}
+}
+
+bool FAtlasLiveValidator::IsTickable() const
+{
+	return bRunning && (PendingPackages.Num() > 0 || DeferredPackages.Num() > 0 || !PendingDelta.IsEmpty());
+}
+
+TStatId FAtlasLiveValidator::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FAtlasLiveValidator, STATGROUP_Tickables);
+}
+
+void FAtlasLiveValidator::Tick(float DeltaTime)
+{
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+	const double Now = FPlatformTime::Seconds();
+	const double Deadline = Now + Settings->LiveValidationBudgetMs / 1000.0;
+	const double ReadyBefore = Now - Settings->LiveValidationDebounceSeconds;
+
+	// Oldest changes first, but only those that have settled
+	TArray<FName, TInlineAllocator<64>> ReadyPackages;
+	for (const TPair<FName, double>& Pair : PendingPackages)
+	{
+		if (Pair.Value <= ReadyBefore)
+		{
+			ReadyPackages.Add(Pair.Key);
+		}
+	}
+
+	ReadyPackages.Sort([this](const FName& A, const FName& B)
+	{
+		return PendingPackages[A] < PendingPackages[B];
+	});
+
+	// One rule scan per tick, so rules can share state across the batch
+	FAtlasScanExecutor::BeginRuleScan();
+
+	// Registry data first: no loads, so every settled package gets its cheap results quickly
+	for (const FName& PackageName : ReadyPackages)
+	{
+		PendingPackages.Remove(PackageName);
+		ValidatePackage(PackageName);
+
+		if (FPlatformTime::Seconds() >= Deadline)
+		{
+			break;
+		}
+	}
+
+	// Then loads, one package at a time; at least one per tick so the queue always drains
+	bool bRanDeferred = false;
+	while (DeferredPackages.Num() > 0 && (!bRanDeferred || FPlatformTime::Seconds() < Deadline))
+	{
+		ValidateDeferredPackage();
+		bRanDeferred = true;
+	}
+
+	FAtlasScanExecutor::EndRuleScan();
+
+	if (!PendingDelta.IsEmpty())
+	{
+		FAtlasIssueDelta Delta = MoveTemp(PendingDelta);
+		PendingDelta = FAtlasIssueDelta();
+		DeltaDelegate.Broadcast(Delta);
+	}
+
+	if (PendingPackages.Num() == 0 && DeferredPackages.Num() == 0 && Now - LastCacheFlushTime >= AtlasLiveValidator::CacheFlushIntervalSeconds)
+	{
+		FAtlasScanCache::Get().Flush();
+		LastCacheFlushTime = Now;
+	}
+}
+
+void FAtlasLiveValidator::ValidatePackage(FName PackageName)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> PackageAssets;
+	AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+
+	FDeferredPackage Deferred;
+	Deferred.PackageName = PackageName;
+
+	bool bAnyRelevant = false;
+	TArray<FName> ObjectRules;
+	for (const FAssetData& AssetData : PackageAssets)
+	{
+		if (IsRelevant(AssetData))
+		{
+			bAnyRelevant = true;
+
+			ObjectRules.Reset();
+			FAtlasScanExecutor::ScanAssetDataDeferred(AssetData, Deferred.Issues, ObjectRules);
+			if (ObjectRules.Num() > 0)
+			{
+				Deferred.ObjectWork.Emplace(AssetData, ObjectRules);
+			}
+		}
+	}
+
+	if (!bAnyRelevant)
+	{
+		Remove(PackageName);
+		return;
+	}
+
+	// Published once complete, so listeners never see a partial result
+	if (Deferred.ObjectWork.Num() > 0)
+	{
+		DeferredPackages.Add(MoveTemp(Deferred));
+		return;
+	}
+
+	CommitPackage(PackageName, Deferred.Issues);
+}
+
+void FAtlasLiveValidator::ValidateDeferredPackage()
+{
+	FDeferredPackage Deferred = MoveTemp(DeferredPackages[0]);
+	DeferredPackages.RemoveAt(0);
+
+	for (const TPair<FAssetData, TArray<FName>>& Work : Deferred.ObjectWork)
+	{
+		FAtlasScanExecutor::ScanAssetObjectRules(Work.Key, Work.Value, Deferred.Issues);
+	}
+
+	CommitPackage(Deferred.PackageName, Deferred.Issues);
+}
+
+void FAtlasLiveValidator::CancelDeferred(FName PackageName)
+{
+	DeferredPackages.RemoveAll([PackageName](const FDeferredPackage& Deferred)
+	{
+		return Deferred.PackageName == PackageName;
+	});
+}
+
+void FAtlasLiveValidator::CommitPackage(FName PackageName, TArray<FAtlasIssue>& NewIssues)
+{
+	TArray<FAtlasIssue>* OldIssues = IssueIndex.Find(PackageName);
+	if (OldIssues && AtlasLiveValidator::AreIssuesEqual(*OldIssues, NewIssues))
+	{
+		return; // Nothing changed for listeners
+	}
+
+	if (!OldIssues && NewIssues.Num() == 0)
+	{
+		return;
+	}
+
+	PendingDelta.InvalidatedPackages.AddUnique(PackageName);
+	PendingDelta.Issues.Append(NewIssues);
+
+	if (NewIssues.Num() > 0)
+	{
+		IssueIndex.Add(PackageName, MoveTemp(NewIssues));
+	}
+	else
+	{
+		IssueIndex.Remove(PackageName);
+	}
+}
+
+void FAtlasLiveValidator::Enqueue(FName PackageName)
+{
+	// A newer change supersedes deferred work from an older one
+	CancelDeferred(PackageName);
+	PendingPackages.Add(PackageName, FPlatformTime::Seconds());
+}
+
+void FAtlasLiveValidator::Remove(FName PackageName)
+{
+	PendingPackages.Remove(PackageName);
+	CancelDeferred(PackageName);
+
+	if (IssueIndex.Remove(PackageName) > 0)
+	{
+		PendingDelta.InvalidatedPackages.AddUnique(PackageName);
+	}
+}
+
+bool FAtlasLiveValidator::IsRelevant(const FAssetData& AssetData)
+{
+	return AssetData.PackagePath.ToString().StartsWith(TEXT("/Game")) && FAtlasScanExecutor::ShouldScanAsset(AssetData);
+}
+
+void FAtlasLiveValidator::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (IsRelevant(AssetData))
+	{
+		Enqueue(AssetData.PackageName);
+	}
+}
+
+void FAtlasLiveValidator::OnAssetRemoved(const FAssetData& AssetData)
+{
+	Remove(AssetData.PackageName);
+}
+
+void FAtlasLiveValidator::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	Remove(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+
+	if (IsRelevant(AssetData))
+	{
+		Enqueue(AssetData.PackageName);
+	}
+}
+
+void FAtlasLiveValidator::OnAssetUpdated(const FAssetData& AssetData)
+{
+	if (IsRelevant(AssetData))
+	{
+		Enqueue(AssetData.PackageName);
+	}
+}
+
+void FAtlasLiveValidator::OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	// Cook and procedural saves are not user edits
+	if (!Package || SaveContext.IsProceduralSave() || !bRegistryReady)
+	{
+		return;
+	}
+
+	Enqueue(Package->GetFName());
+}
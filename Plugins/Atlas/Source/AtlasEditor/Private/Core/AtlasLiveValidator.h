@@ -0,0 +1,137 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "AtlasEditor.h"
+#include "AssetRegistry/AssetData.h"
+#include "TickableEditorObject.h"
+
+class UPackage;
+class FObjectPostSaveContext;
+
+/**
+ * Background validation driven by asset registry and package save events
+ * Changed packages are debounced, then validated in time-sliced batches on the editor tick. Each
+ * tick is one rule scan (IAtlasRule::BeginScan/EndScan). Cached and registry-data results come
+ * first; rules that need the loaded asset go to a deferred queue that loads at most one package
+ * beyond the tick budget. Rules that do not support live validation are skipped.
+ * Keeps an in-memory issue index and broadcasts only what changed.
+ */
+class FAtlasLiveValidator : public FTickableEditorObject
+{
+public:
+	/**
+	 * @param InDeltaDelegate Delegate broadcast with each batch of changes
+	 */
+	explicit FAtlasLiveValidator(FOnAtlasIssuesDelta& InDeltaDelegate);
+	virtual ~FAtlasLiveValidator();
+
+	/**
+	 * Subscribe to editor events; waits for the initial asset registry scan to finish
+	 */
+	void Start();
+
+	/**
+	 * Unsubscribe from editor events and drop pending work
+	 */
+	void Stop();
+
+	/**
+	 * Replace the indexed issues of scanned assets with fresh full-scan results
+	 * @param ScannedAssets Assets that were scanned
+	 * @param Issues Issues found for those assets
+	 */
+	void IngestScanResults(const TArray<FAssetData>& ScannedAssets, const TArray<FAtlasIssue>& Issues);
+
+	/**
+	 * Replace the indexed issues of scanned assets with fresh full-scan results
+	 * @param ScannedAssets Assets that were scanned
+	 * @param Store Issues found for those assets
+	 */
+	void IngestScanResults(const TArray<FAssetData>& ScannedAssets, const FAtlasIssueStore& Store);
+
+	/**
+	 * Get every issue currently in the index
+	 * @param OutIssues Array to fill with issues
+	 */
+	void GetAllIssues(TArray<FAtlasIssue>& OutIssues) const;
+
+	//~ Begin FTickableEditorObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableEditorObject Interface
+
+private:
+	void BindRegistryEvents();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AssetData);
+	void OnPackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+
+	/** Queue a package for validation, restarting its debounce timer */
+	void Enqueue(FName PackageName);
+
+	/** Drop a package from the index and report it as invalidated */
+	void Remove(FName PackageName);
+
+	/** Validate one package from cached and registry data, deferring rules that need a load */
+	void ValidatePackage(FName PackageName);
+
+	/** Run the deferred rules of the oldest deferred package */
+	void ValidateDeferredPackage();
+
+	/** Fold a package's complete result into the index and the pending delta */
+	void CommitPackage(FName PackageName, TArray<FAtlasIssue>& NewIssues);
+
+	/** Drop deferred work for a package whose result is no longer wanted */
+	void CancelDeferred(FName PackageName);
+
+	/** Check if an asset is something live validation cares about */
+	static bool IsRelevant(const FAssetData& AssetData);
+
+private:
+	FOnAtlasIssuesDelta& DeltaDelegate;
+
+	/** Packages waiting for validation, with the time they last changed */
+	TMap<FName, double> PendingPackages;
+
+	/** A package whose registry-data results are known but whose object rules still have to run */
+	struct FDeferredPackage
+	{
+		FName PackageName;
+
+		/** Issues found so far */
+		TArray<FAtlasIssue> Issues;
+
+		/** Assets of the package with the rules each still needs */
+		TArray<TPair<FAssetData, TArray<FName>>> ObjectWork;
+	};
+
+	/** Deferred packages, oldest first */
+	TArray<FDeferredPackage> DeferredPackages;
+
+	/** Issues per package from the latest validation */
+	TMap<FName, TArray<FAtlasIssue>> IssueIndex;
+
+	/** Changes accumulated since the last broadcast */
+	FAtlasIssueDelta PendingDelta;
+
+	/** Last time the scan cache was written to disk */
+	double LastCacheFlushTime;
+
+	bool bRunning;
+	bool bRegistryReady;
+
+	FDelegateHandle FilesLoadedHandle;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PackageSavedHandle;
+};
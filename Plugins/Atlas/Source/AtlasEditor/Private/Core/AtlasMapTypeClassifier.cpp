@@ -0,0 +1,337 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasMapTypeClassifier.h"
+#include "AtlasSettings.h"
+#include "AtlasRuntime.h"
+
+namespace AtlasMapTypeClassifier
+{
+	static constexpr uint64 HashOffset = 0xcbf29ce484222325ull;
+	static constexpr uint64 HashPrime = 0x100000001b3ull;
+
+	static bool IsSeparator(TCHAR Char)
+	{
+		return Char == TEXT('_') || Char == TEXT('-') || Char == TEXT('.') || Char == TEXT(' ');
+	}
+
+	/** Whether a new token starts at Index: camelCase humps, the end of an acronym, or letters followed by digits */
+	static bool IsBoundary(FStringView Name, int32 Index)
+	{
+		const TCHAR Prev = Name[Index - 1];
+		const TCHAR Char = Name[Index];
+
+		if (FChar::IsLower(Prev) && FChar::IsUpper(Char))
+		{
+			return true;
+		}
+
+		// "ARMTexture" splits before the 'T'
+		if (FChar::IsUpper(Prev) && FChar::IsUpper(Char) && Index + 1 < Name.Len() && FChar::IsLower(Name[Index + 1]))
+		{
+			return true;
+		}
+
+		return FChar::IsAlpha(Prev) && FChar::IsDigit(Char);
+	}
+
+	/** Version or resolution tokens that may follow the suffix: "01", "2", "2k", "4K" */
+	static bool IsNumericToken(FStringView Name, const FAtlasMapTypeClassifier::FToken& Token)
+	{
+		int32 End = Token.Start + Token.Len;
+		if (Token.Len > 1 && (Name[End - 1] == TEXT('k') || Name[End - 1] == TEXT('K')))
+		{
+			--End;
+		}
+
+		for (int32 Index = Token.Start; Index < End; ++Index)
+		{
+			if (!FChar::IsDigit(Name[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static uint64 HashChar(uint64 Hash, TCHAR Char)
+	{
+		return (Hash ^ static_cast<uint64>(FChar::ToLower(Char))) * HashPrime;
+	}
+
+	/** Shared classifier, built from settings on first use (possibly on a scan worker) */
+	static TUniquePtr<FAtlasMapTypeClassifier>& GetInstance()
+	{
+		static TUniquePtr<FAtlasMapTypeClassifier> Instance = MakeUnique<FAtlasMapTypeClassifier>(UAtlasSettings::Get()->MapTypeSuffixes);
+		return Instance;
+	}
+}
+
+FAtlasMapTypeClassifier::FAtlasMapTypeClassifier(const TMap<FString, EAtlasMapType>& Suffixes)
+{
+	Entries.Reserve(Suffixes.Num());
+
+	FToken Tokens[MaxTokens];
+	for (const TPair<FString, EAtlasMapType>& Suffix : Suffixes)
+	{
+		// Keys go through the same tokenizer, so "BaseColor" and "base_color" are the same suffix
+		const int32 NumTokens = Tokenize(Suffix.Key, Tokens);
+		if (NumTokens < 1 || NumTokens > 2)
+		{
+			UE_LOG(LogAtlas, Warning, TEXT("Ignoring map type suffix '%s': suffixes must have one or two tokens"), *Suffix.Key);
+			continue;
+		}
+
+		FEntry Entry;
+		Entry.Hash = HashTokens(Suffix.Key, Tokens, 0, NumTokens);
+		Entry.NumTokens = NumTokens;
+		Entry.Type = Suffix.Value;
+		Entries.Add(Entry);
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B)
+	{
+		return A.Hash != B.Hash ? A.Hash < B.Hash : A.NumTokens < B.NumTokens;
+	});
+
+	// Two spellings of one suffix, e.g. "BaseColor" and "base_color"; keep the first
+	for (int32 Index = Entries.Num() - 1; Index > 0; --Index)
+	{
+		if (Entries[Index].Hash == Entries[Index - 1].Hash && Entries[Index].NumTokens == Entries[Index - 1].NumTokens)
+		{
+			Entries.RemoveAt(Index, 1, false);
+		}
+	}
+}
+
+const FAtlasMapTypeClassifier& FAtlasMapTypeClassifier::Get()
+{
+	return *AtlasMapTypeClassifier::GetInstance();
+}
+
+void FAtlasMapTypeClassifier::Rebuild()
+{
+	check(IsInGameThread());
+	AtlasMapTypeClassifier::GetInstance() = MakeUnique<FAtlasMapTypeClassifier>(UAtlasSettings::Get()->MapTypeSuffixes);
+}
+
+TMap<FString, EAtlasMapType> FAtlasMapTypeClassifier::GetDefaultSuffixes()
+{
+	TMap<FString, EAtlasMapType> Suffixes;
+
+	Suffixes.Add(TEXT("normal"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("normalmap"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("normal_map"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("norm"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("nrm"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("nor"), EAtlasMapType::Normal);
+	Suffixes.Add(TEXT("n"), EAtlasMapType::Normal);
+
+	Suffixes.Add(TEXT("basecolor"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("base_color"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("albedo"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("diffuse"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("diff"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("color"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("col"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("bc"), EAtlasMapType::BaseColor);
+	Suffixes.Add(TEXT("d"), EAtlasMapType::BaseColor);
+
+	Suffixes.Add(TEXT("roughness"), EAtlasMapType::Roughness);
+	Suffixes.Add(TEXT("rough"), EAtlasMapType::Roughness);
+	Suffixes.Add(TEXT("rgh"), EAtlasMapType::Roughness);
+	Suffixes.Add(TEXT("r"), EAtlasMapType::Roughness);
+
+	Suffixes.Add(TEXT("metallic"), EAtlasMapType::Metalness);
+	Suffixes.Add(TEXT("metalness"), EAtlasMapType::Metalness);
+	Suffixes.Add(TEXT("metal"), EAtlasMapType::Metalness);
+	Suffixes.Add(TEXT("mtl"), EAtlasMapType::Metalness);
+	Suffixes.Add(TEXT("m"), EAtlasMapType::Metalness);
+
+	Suffixes.Add(TEXT("ao"), EAtlasMapType::AO);
+	Suffixes.Add(TEXT("ambientocclusion"), EAtlasMapType::AO);
+	Suffixes.Add(TEXT("ambient_occlusion"), EAtlasMapType::AO);
+	Suffixes.Add(TEXT("occlusion"), EAtlasMapType::AO);
+	Suffixes.Add(TEXT("occ"), EAtlasMapType::AO);
+
+	Suffixes.Add(TEXT("height"), EAtlasMapType::Height);
+	Suffixes.Add(TEXT("displacement"), EAtlasMapType::Height);
+	Suffixes.Add(TEXT("disp"), EAtlasMapType::Height);
+	Suffixes.Add(TEXT("bump"), EAtlasMapType::Height);
+	Suffixes.Add(TEXT("h"), EAtlasMapType::Height);
+
+	Suffixes.Add(TEXT("emissive"), EAtlasMapType::Emissive);
+	Suffixes.Add(TEXT("emission"), EAtlasMapType::Emissive);
+	Suffixes.Add(TEXT("emit"), EAtlasMapType::Emissive);
+	Suffixes.Add(TEXT("e"), EAtlasMapType::Emissive);
+
+	Suffixes.Add(TEXT("opacity"), EAtlasMapType::Opacity);
+	Suffixes.Add(TEXT("alpha"), EAtlasMapType::Opacity);
+	Suffixes.Add(TEXT("o"), EAtlasMapType::Opacity);
+
+	// Channel-packed maps hold several types; do not guess one from an earlier token
+	Suffixes.Add(TEXT("arm"), EAtlasMapType::Unknown);
+	Suffixes.Add(TEXT("orm"), EAtlasMapType::Unknown);
+	Suffixes.Add(TEXT("rma"), EAtlasMapType::Unknown);
+	Suffixes.Add(TEXT("mra"), EAtlasMapType::Unknown);
+
+	return Suffixes;
+}
+
+EAtlasMapType FAtlasMapTypeClassifier::Classify(FStringView Name, int32* OutSuffixStart) const
+{
+	using namespace AtlasMapTypeClassifier;
+
+	FToken Tokens[MaxTokens];
+	const int32 NumTokens = Tokenize(Name, Tokens);
+
+	if (OutSuffixStart)
+	{
+		*OutSuffixStart = INDEX_NONE;
+	}
+
+	// Skip the type prefix ("T_") unless the name is a single token
+	const int32 FirstToken = NumTokens > 1 ? 1 : 0;
+	int32 Last = NumTokens - 1;
+
+	// File names end in their extension; asset names cannot contain '.'
+	if (Last > FirstToken && Name[Tokens[Last].Start - 1] == TEXT('.'))
+	{
+		--Last;
+	}
+
+	// Version and resolution tokens ("_01", "_2K", "Roughness2"), but not digits glued to a single letter,
+	// which are part of a name ("M4", "E1") rather than a suffix
+	while (Last > FirstToken && IsNumericToken(Name, Tokens[Last])
+		&& (IsSeparator(Name[Tokens[Last].Start - 1]) || Tokens[Last - 1].Len > 1))
+	{
+		--Last;
+	}
+
+	if (Last < FirstToken)
+	{
+		return EAtlasMapType::Unknown;
+	}
+
+	// Only the trailing suffix counts; a map type word earlier in the name ("T_Metal_Plate") says nothing
+	const FEntry* Entry = nullptr;
+	int32 SuffixToken = Last;
+
+	if (Last - 1 >= FirstToken)
+	{
+		Entry = FindEntry(HashTokens(Name, Tokens, Last - 1, 2), 2);
+		SuffixToken = Last - 1;
+	}
+
+	if (!Entry)
+	{
+		Entry = FindEntry(HashTokens(Name, Tokens, Last, 1), 1);
+		SuffixToken = Last;
+	}
+
+	if (Entry)
+	{
+		if (OutSuffixStart)
+		{
+			*OutSuffixStart = Tokens[SuffixToken].Start;
+		}
+		return Entry->Type;
+	}
+
+	return EAtlasMapType::Unknown;
+}
+
+void FAtlasMapTypeClassifier::ClassifyBatch(TConstArrayView<FString> Names, TArray<EAtlasMapType>& OutTypes, TArray<int32>* OutSuffixStarts) const
+{
+	OutTypes.SetNumUninitialized(Names.Num());
+	if (OutSuffixStarts)
+	{
+		OutSuffixStarts->SetNumUninitialized(Names.Num());
+	}
+
+	for (int32 Index = 0; Index < Names.Num(); ++Index)
+	{
+		OutTypes[Index] = Classify(Names[Index], OutSuffixStarts ? &(*OutSuffixStarts)[Index] : nullptr);
+	}
+}
+
+int32 FAtlasMapTypeClassifier::Tokenize(FStringView Name, FToken* OutTokens)
+{
+	using namespace AtlasMapTypeClassifier;
+
+	int32 NumTokens = 0;
+	int32 Index = 0;
+	while (Index < Name.Len())
+	{
+		if (IsSeparator(Name[Index]))
+		{
+			++Index;
+			continue;
+		}
+
+		const int32 Start = Index++;
+		while (Index < Name.Len() && !IsSeparator(Name[Index]) && !IsBoundary(Name, Index))
+		{
+			++Index;
+		}
+
+		if (NumTokens == MaxTokens)
+		{
+			FMemory::Memmove(OutTokens, OutTokens + 1, sizeof(FToken) * (MaxTokens - 1));
+			--NumTokens;
+		}
+
+		OutTokens[NumTokens].Start = Start;
+		OutTokens[NumTokens].Len = Index - Start;
+		++NumTokens;
+	}
+
+	return NumTokens;
+}
+
+uint64 FAtlasMapTypeClassifier::HashTokens(FStringView Name, const FToken* Tokens, int32 First, int32 Num)
+{
+	using namespace AtlasMapTypeClassifier;
+
+	uint64 Hash = HashOffset;
+	for (int32 TokenIndex = First; TokenIndex < First + Num; ++TokenIndex)
+	{
+		if (TokenIndex > First)
+		{
+			Hash = HashChar(Hash, TEXT('_'));
+		}
+
+		const FToken& Token = Tokens[TokenIndex];
+		for (int32 CharIndex = Token.Start; CharIndex < Token.Start + Token.Len; ++CharIndex)
+		{
+			Hash = HashChar(Hash, Name[CharIndex]);
+		}
+	}
+
+	return Hash;
+}
+
+const FAtlasMapTypeClassifier::FEntry* FAtlasMapTypeClassifier::FindEntry(uint64 Hash, int32 NumTokens) const
+{
+	int32 Low = 0;
+	int32 High = Entries.Num();
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		const FEntry& Entry = Entries[Mid];
+		if (Entry.Hash < Hash || (Entry.Hash == Hash && Entry.NumTokens < NumTokens))
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	if (Low < Entries.Num() && Entries[Low].Hash == Hash && Entries[Low].NumTokens == NumTokens)
+	{
+		return &Entries[Low];
+	}
+
+	return nullptr;
+}
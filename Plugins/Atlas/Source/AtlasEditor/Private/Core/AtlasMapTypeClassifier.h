@@ -0,0 +1,93 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+/**
+ * Classifies texture names into map types by their suffix tokens
+ *
+ * A name is split once into tokens on '_', '-', '.', spaces, camelCase humps and letter-to-digit
+ * boundaries, so "T_Rock_BaseColor_2K" becomes [t, rock, base, color, 2k]. Only the trailing suffix
+ * is matched, after skipping a file extension and version or resolution tokens ("01", "2k"); digits
+ * glued to a single letter ("M4") are part of the name and stop the skip. That suffix is looked up in
+ * a table of one- and two-token suffixes ("n", "normal", "base_color"), two-token first, so
+ * "T_Metal_Plate" and "T_Rifle_M4" stay Unknown. The first token is the asset type prefix by
+ * convention and is never matched. A suffix mapped to Unknown (e.g. packed "arm") gives Unknown.
+ *
+ * The table is sorted by a case-insensitive hash and looked up by binary search. Classify does not
+ * allocate and is safe to call concurrently on a const classifier.
+ */
+class ATLASEDITOR_API FAtlasMapTypeClassifier
+{
+public:
+	/** Token boundaries within a name */
+	struct FToken
+	{
+		int32 Start;
+		int32 Len;
+	};
+
+	/** Tokens beyond this count drop the earliest ones; suffixes are at the end */
+	static constexpr int32 MaxTokens = 32;
+
+	/**
+	 * Build a classifier from a suffix table
+	 * @param Suffixes Suffix (tokens joined with '_', any case) to map type
+	 */
+	explicit FAtlasMapTypeClassifier(const TMap<FString, EAtlasMapType>& Suffixes);
+
+	/**
+	 * Get the classifier built from UAtlasSettings::MapTypeSuffixes
+	 * Built on first use; Rebuild must not run while a scan is in progress.
+	 */
+	static const FAtlasMapTypeClassifier& Get();
+
+	/** Rebuild the shared classifier after the settings changed */
+	static void Rebuild();
+
+	/** Built-in suffix table, used as the settings default */
+	static TMap<FString, EAtlasMapType> GetDefaultSuffixes();
+
+	/**
+	 * Classify a texture name
+	 * @param Name Asset or file name, without path
+	 * @param OutSuffixStart Optional; receives the index of the matched suffix in Name, or INDEX_NONE
+	 * @return The detected map type, or Unknown
+	 */
+	EAtlasMapType Classify(FStringView Name, int32* OutSuffixStart = nullptr) const;
+
+	/**
+	 * Classify several names, e.g. all textures of an import group
+	 * @param Names Names to classify
+	 * @param OutTypes Array to fill, one entry per name
+	 * @param OutSuffixStarts Optional array to fill with the index of each matched suffix, or INDEX_NONE
+	 */
+	void ClassifyBatch(TConstArrayView<FString> Names, TArray<EAtlasMapType>& OutTypes, TArray<int32>* OutSuffixStarts = nullptr) const;
+
+	/**
+	 * Split a name into tokens without allocating
+	 * @param Name The name to split
+	 * @param OutTokens Storage for at least MaxTokens tokens
+	 * @return Number of tokens written
+	 */
+	static int32 Tokenize(FStringView Name, FToken* OutTokens);
+
+private:
+	struct FEntry
+	{
+		uint64 Hash;
+		int32 NumTokens;
+		EAtlasMapType Type;
+	};
+
+	/** Case-insensitive FNV-1a over tokens First..First+Num-1 joined with '_' */
+	static uint64 HashTokens(FStringView Name, const FToken* Tokens, int32 First, int32 Num);
+
+	/** Find the map type of a one- or two-token suffix */
+	const FEntry* FindEntry(uint64 Hash, int32 NumTokens) const;
+
+	/** Sorted by Hash, then NumTokens */
+	TArray<FEntry> Entries;
+};
@@ -3,10 +3,55 @@
 #include "AtlasMeshUtils.h"
 #include "AtlasRuntime.h"
 #include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "MeshUtilities.h"
 #include "IMeshReductionManagerModule.h"
 #include "IMeshReductionInterfaces.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+
+namespace AtlasMeshUtils
+{
+	/** Smallest fraction of LOD 0 triangles a generated LOD keeps */
+	static constexpr float MinTrianglePercent = 0.01f;
+
+	/** Seconds between checks for finished LOD builds */
+	static constexpr float BuildPollInterval = 0.5f;
+
+	/** Fill in the built triangle counts and log the reduction of each LOD */
+	static void GatherLODTriangles(TArray<FAtlasLODGenerationResult>& Results)
+	{
+		for (FAtlasLODGenerationResult& Result : Results)
+		{
+			const UStaticMesh* Mesh = Result.Mesh.Get();
+			if (!Mesh || !Mesh->GetRenderData())
+			{
+				continue;
+			}
+
+			const TIndirectArray<FStaticMeshLODResources>& LODResources = Mesh->GetRenderData()->LODResources;
+			for (int32 LODIndex = 0; LODIndex < LODResources.Num(); ++LODIndex)
+			{
+				Result.LODTriangles.Add(LODResources[LODIndex].GetNumTriangles());
+			}
+
+			if (Result.LODTriangles.Num() == 0 || Result.LODTriangles[0] == 0)
+			{
+				continue;
+			}
+
+			FString Summary = FString::Printf(TEXT("LOD0 %lld"), Result.LODTriangles[0]);
+			for (int32 LODIndex = 1; LODIndex < Result.LODTriangles.Num(); ++LODIndex)
+			{
+				Summary += FString::Printf(TEXT(", LOD%d %lld (%.1f%%)"), LODIndex, Result.LODTriangles[LODIndex],
+					100.0 * static_cast<double>(Result.LODTriangles[LODIndex]) / static_cast<double>(Result.LODTriangles[0]));
+			}
+
+			UE_LOG(LogAtlas, Log, TEXT("Generated %d LODs for mesh %s: %s triangles"), Result.NumGeneratedLODs, *Mesh->GetName(), *Summary);
+		}
+	}
+}
 
 int64 FAtlasMeshUtils::GetTriangleCount(const UStaticMesh* Mesh)
 {
@@ -78,38 +123,113 @@ bool FAtlasMeshUtils::GenerateLODsIfNeeded(UStaticMesh* Mesh, int32 TargetLODs,
 		return false;
 	}
 
-	int64 TriCount = GetTriangleCount(Mesh);
-	int32 CurrentLODs = GetLODCount(Mesh);
-
 	// Check if we need LODs
-	if (TriCount <= MaxTris || CurrentLODs >= TargetLODs)
+	if (GetTriangleCount(Mesh) <= MaxTris || Mesh->GetNumSourceModels() >= TargetLODs)
 	{
 		return true; // No need for LODs or already has enough
 	}
 
-	// Generate LODs
+	return GenerateLODsBatch({ Mesh }, TargetLODs, MaxTris) > 0;
+}
+
+int32 FAtlasMeshUtils::GenerateLODsBatch(const TArray<UStaticMesh*>& Meshes, int32 TargetLODs, int32 MaxTris, FOnAtlasLODsGenerated OnComplete)
+{
 	IMeshReductionManagerModule& MeshReductionModule = FModuleManager::Get().LoadModuleChecked<IMeshReductionManagerModule>("MeshReductionInterface");
-	IMeshReduction* MeshReduction = MeshReductionModule.GetStaticMeshReductionInterface();
+	if (!MeshReductionModule.GetStaticMeshReductionInterface())
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Mesh reduction interface not available, cannot generate LODs"));
+		return 0;
+	}
+
+	TArray<UStaticMesh*> MeshesToBuild;
+	TArray<FAtlasLODGenerationResult> Results;
+	for (UStaticMesh* Mesh : Meshes)
+	{
+		const int32 NumAdded = ConfigureLODReduction(Mesh, TargetLODs, MaxTris);
+		if (NumAdded > 0)
+		{
+			MeshesToBuild.Add(Mesh);
+
+			FAtlasLODGenerationResult& Result = Results.AddDefaulted_GetRef();
+			Result.Mesh = Mesh;
+			Result.NumGeneratedLODs = NumAdded;
+		}
+	}
 
-	if (!MeshReduction)
+	if (MeshesToBuild.Num() == 0)
 	{
-		UE_LOG(LogAtlas, Warning, TEXT("Mesh reduction interface not available for: %s"), *Mesh->GetName());
+		OnComplete.ExecuteIfBound(Results);
+		return 0;
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Building LODs for %d meshes"), MeshesToBuild.Num());
+
+	// One build for all meshes instead of a PostEditChange each; with async static mesh
+	// compilation this only schedules the work and returns
+	UStaticMesh::BatchBuild(MeshesToBuild, true);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Results = MoveTemp(Results), OnComplete](float DeltaTime) mutable
+	{
+		for (const FAtlasLODGenerationResult& Result : Results)
+		{
+			const UStaticMesh* Mesh = Result.Mesh.Get();
+			if (Mesh && Mesh->IsCompiling())
+			{
+				return true;
+			}
+		}
+
+		AtlasMeshUtils::GatherLODTriangles(Results);
+		OnComplete.ExecuteIfBound(Results);
 		return false;
+	}), AtlasMeshUtils::BuildPollInterval);
+
+	return MeshesToBuild.Num();
+}
+
+int32 FAtlasMeshUtils::ConfigureLODReduction(UStaticMesh* Mesh, int32 TargetLODs, int32 MaxTris)
+{
+	if (!Mesh)
+	{
+		return 0;
+	}
+
+	const int64 SourceTris = GetTriangleCount(Mesh);
+	const int32 CurrentLODs = Mesh->GetNumSourceModels();
+	if (SourceTris <= MaxTris || CurrentLODs >= TargetLODs)
+	{
+		return 0;
 	}
 
 	Mesh->Modify();
+	Mesh->SetNumSourceModels(TargetLODs);
 
-	// Set up LOD settings
-	int32 NumLODsToGenerate = TargetLODs - CurrentLODs;
-	for (int32 i = 0; i < NumLODsToGenerate; i++)
+	for (int32 LODIndex = CurrentLODs; LODIndex < TargetLODs; ++LODIndex)
 	{
-		// This is simplified - actual LOD generation would require more setup
-		// For a production plugin, you'd want to use FMeshUtilities or similar
-		UE_LOG(LogAtlas, Log, TEXT("Would generate LOD %d for mesh: %s"), CurrentLODs + i, *Mesh->GetName());
+		// New source models have no mesh description, so the build reduces them from LOD 0
+		FStaticMeshSourceModel& SourceModel = Mesh->GetSourceModel(LODIndex);
+		SourceModel.BuildSettings = Mesh->GetSourceModel(0).BuildSettings;
+		SourceModel.ReductionSettings.BaseLODModel = 0;
+		SourceModel.ReductionSettings.TerminationCriterion = EStaticMeshReductionTerimationCriterion::Triangles;
+		SourceModel.ReductionSettings.PercentTriangles = GetLODTrianglePercent(LODIndex, SourceTris, MaxTris);
 	}
 
+	Mesh->bAutoComputeLODScreenSize = true;
 	Mesh->MarkPackageDirty();
-	return true;
+
+	return TargetLODs - CurrentLODs;
+}
+
+float FAtlasMeshUtils::GetLODTrianglePercent(int32 LODIndex, int64 SourceTris, int32 MaxTris)
+{
+	if (SourceTris <= 0)
+	{
+		return 1.0f;
+	}
+
+	// LOD 1 fits the budget, every further LOD halves it
+	const double Budget = static_cast<double>(MaxTris) / static_cast<double>(1ll << FMath::Clamp(LODIndex - 1, 0, 30));
+	return static_cast<float>(FMath::Clamp(Budget / static_cast<double>(SourceTris), static_cast<double>(AtlasMeshUtils::MinTrianglePercent), 1.0));
 }
 
 int32 FAtlasMeshUtils::GetLODCount(const UStaticMesh* Mesh)
@@ -122,6 +242,54 @@ int32 FAtlasMeshUtils::GetLODCount(const UStaticMesh* Mesh)
 	return Mesh->GetRenderData()->LODResources.Num();
 }
 
+void FAtlasMeshUtils::GetLODTriangleCounts(const UStaticMesh* Mesh, TArray<int64>& OutTriangles)
+{
+	OutTriangles.Reset();
+	if (!Mesh || !Mesh->GetRenderData())
+	{
+		return;
+	}
+
+	for (const FStaticMeshLODResources& LODResources : Mesh->GetRenderData()->LODResources)
+	{
+		OutTriangles.Add(LODResources.GetNumTriangles());
+	}
+}
+
+void FAtlasMeshUtils::GetLODScreenSizes(const UStaticMesh* Mesh, TArray<float>& OutScreenSizes)
+{
+	OutScreenSizes.Reset();
+	if (!Mesh || !Mesh->GetRenderData())
+	{
+		return;
+	}
+
+	const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+	const int32 NumLODs = FMath::Min(RenderData->LODResources.Num(), MAX_STATIC_MESH_LODS);
+	for (int32 LODIndex = 0; LODIndex < NumLODs; ++LODIndex)
+	{
+		OutScreenSizes.Add(RenderData->ScreenSize[LODIndex].Default);
+	}
+}
+
+bool FAtlasMeshUtils::IsNaniteCompatible(const UStaticMesh* Mesh)
+{
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	for (const FStaticMaterial& StaticMaterial : Mesh->GetStaticMaterials())
+	{
+		if (StaticMaterial.MaterialInterface && StaticMaterial.MaterialInterface->GetBlendMode() != BLEND_Opaque)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool FAtlasMeshUtils::HasCollision(const UStaticMesh* Mesh)
 {
 	if (!Mesh)
@@ -157,3 +325,18 @@ int32 FAtlasMeshUtils::GetVertexCount(const UStaticMesh* Mesh)
 	const FStaticMeshLODResources& LOD0 = Mesh->GetRenderData()->LODResources[0];
 	return LOD0.GetNumVertices();
 }
+
+bool FAtlasMeshUtils::GetTriangleCountFromTags(const FAssetData& AssetData, int64& OutTriangleCount)
+{
+	return AssetData.GetTagValue(TEXT("Triangles"), OutTriangleCount);
+}
+
+bool FAtlasMeshUtils::GetLODCountFromTags(const FAssetData& AssetData, int32& OutLODCount)
+{
+	return AssetData.GetTagValue(TEXT("LODs"), OutLODCount);
+}
+
+bool FAtlasMeshUtils::GetCollisionPrimCountFromTags(const FAssetData& AssetData, int32& OutCollisionPrims)
+{
+	return AssetData.GetTagValue(TEXT("CollisionPrims"), OutCollisionPrims);
+}
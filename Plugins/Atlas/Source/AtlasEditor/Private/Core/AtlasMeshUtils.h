@@ -5,6 +5,29 @@
 #include "CoreMinimal.h"
 
 class UStaticMesh;
+struct FAssetData;
+
+/**
+ * Triangle counts of a mesh after LOD generation
+ */
+struct FAtlasLODGenerationResult
+{
+	/** The processed mesh; may be gone if it was unloaded during the build */
+	TWeakObjectPtr<UStaticMesh> Mesh;
+
+	/** Number of LODs that were added */
+	int32 NumGeneratedLODs;
+
+	/** Triangle count of each LOD after the build, LOD 0 first */
+	TArray<int64> LODTriangles;
+
+	FAtlasLODGenerationResult()
+		: NumGeneratedLODs(0)
+	{
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FOnAtlasLODsGenerated, const TArray<FAtlasLODGenerationResult>&);
 
 /**
  * Utility functions for mesh operations
@@ -28,13 +51,45 @@ public:
 
 	/**
 	 * Generate LODs for a mesh if needed
+	 * The build runs in the background; see GenerateLODsBatch.
 	 * @param Mesh The mesh to process
-	 * @param TargetLODs Number of LODs to generate
+	 * @param TargetLODs Number of LODs the mesh should have
 	 * @param MaxTris Maximum triangles for LOD 0 before generating LODs
-	 * @return True if successful
+	 * @return True if the mesh needs no LODs or its build was started
 	 */
 	static bool GenerateLODsIfNeeded(UStaticMesh* Mesh, int32 TargetLODs, int32 MaxTris);
 
+	/**
+	 * Generate LODs for many meshes in a single build
+	 * Meshes over MaxTris get auto-reduced LODs: LOD 1 is reduced to MaxTris and each further LOD halves
+	 * the previous one. Existing LODs are kept. All meshes are built together with async static mesh
+	 * compilation, so the editor stays responsive while they compile.
+	 * @param Meshes Meshes to process
+	 * @param TargetLODs Number of LODs each mesh should have
+	 * @param MaxTris Maximum triangles for LOD 0 before generating LODs
+	 * @param OnComplete Called on the game thread with the per-LOD triangle counts once every build finished
+	 * @return Number of meshes whose build was started
+	 */
+	static int32 GenerateLODsBatch(const TArray<UStaticMesh*>& Meshes, int32 TargetLODs, int32 MaxTris, FOnAtlasLODsGenerated OnComplete = FOnAtlasLODsGenerated());
+
+	/**
+	 * Add auto-reduced LODs to a mesh's source models without building it
+	 * @param Mesh The mesh to configure
+	 * @param TargetLODs Number of LODs the mesh should have
+	 * @param MaxTris Maximum triangles for LOD 0 before generating LODs
+	 * @return Number of LODs added
+	 */
+	static int32 ConfigureLODReduction(UStaticMesh* Mesh, int32 TargetLODs, int32 MaxTris);
+
+	/**
+	 * Get the fraction of LOD 0 triangles an auto-reduced LOD keeps
+	 * @param LODIndex LOD to reduce, 1 or higher
+	 * @param SourceTris Triangle count of LOD 0
+	 * @param MaxTris Triangle budget of LOD 1
+	 * @return Fraction in (0, 1]
+	 */
+	static float GetLODTrianglePercent(int32 LODIndex, int64 SourceTris, int32 MaxTris);
+
 	/**
 	 * Get the number of LODs for a mesh
 	 * @param Mesh The mesh to check
@@ -42,6 +97,28 @@ public:
 	 */
 	static int32 GetLODCount(const UStaticMesh* Mesh);
 
+	/**
+	 * Get the triangle count of every LOD
+	 * @param Mesh The mesh to analyze
+	 * @param OutTriangles Triangle counts, LOD 0 first
+	 */
+	static void GetLODTriangleCounts(const UStaticMesh* Mesh, TArray<int64>& OutTriangles);
+
+	/**
+	 * Get the screen size at which each LOD becomes active
+	 * @param Mesh The mesh to analyze
+	 * @param OutScreenSizes Default-platform screen sizes, LOD 0 first
+	 */
+	static void GetLODScreenSizes(const UStaticMesh* Mesh, TArray<float>& OutScreenSizes);
+
+	/**
+	 * Check if a mesh could be rendered with Nanite
+	 * Nanite only supports opaque materials.
+	 * @param Mesh The mesh to check
+	 * @return True if every material slot is opaque
+	 */
+	static bool IsNaniteCompatible(const UStaticMesh* Mesh);
+
 	/**
 	 * Check if a mesh has valid collision
 	 * @param Mesh The mesh to check
@@ -55,4 +132,28 @@ public:
 	 * @return Vertex count
 	 */
 	static int32 GetVertexCount(const UStaticMesh* Mesh);
+
+	/**
+	 * Read the LOD 0 triangle count from asset registry tags
+	 * @param AssetData The mesh's asset registry entry
+	 * @param OutTriangleCount Triangle count
+	 * @return True if the tag was present
+	 */
+	static bool GetTriangleCountFromTags(const FAssetData& AssetData, int64& OutTriangleCount);
+
+	/**
+	 * Read the number of LODs from asset registry tags
+	 * @param AssetData The mesh's asset registry entry
+	 * @param OutLODCount Number of LODs
+	 * @return True if the tag was present
+	 */
+	static bool GetLODCountFromTags(const FAssetData& AssetData, int32& OutLODCount);
+
+	/**
+	 * Read the number of simple collision primitives from asset registry tags
+	 * @param AssetData The mesh's asset registry entry
+	 * @param OutCollisionPrims Number of simple collision primitives
+	 * @return True if the tag was present
+	 */
+	static bool GetCollisionPrimCountFromTags(const FAssetData& AssetData, int32& OutCollisionPrims);
 };
@@ -6,6 +6,11 @@
 #include "Rules/AtlasNamingConventionRule.h"
 #include "Rules/AtlasTextureCompressionRule.h"
 #include "Rules/AtlasStaticMeshCollisionRule.h"
+#include "Rules/AtlasStaticMeshLODRule.h"
+#include "Rules/AtlasLevelTextureBudgetRule.h"
+#include "Rules/AtlasMaterialInstanceDupRule.h"
+#include "Rules/AtlasShaderPermutationRule.h"
+#include "Rules/AtlasDuplicateRule.h"
 
 void FAtlasRuleInitializer::RegisterDefaultRules()
 {
@@ -22,10 +27,23 @@ void FAtlasRuleInitializer::RegisterDefaultRules()
 	// Register Static Mesh Collision Rule
 	Registry.Register(MakeShared<FAtlasStaticMeshCollisionRule>());
 
+	// Register Static Mesh LOD Rule
+	Registry.Register(MakeShared<FAtlasStaticMeshLODRule>());
+
+	// Register Level Texture Budget Rule
+	Registry.Register(MakeShared<FAtlasLevelTextureBudgetRule>());
+
+	// Register Material Instance Duplicate Rule
+	Registry.Register(MakeShared<FAtlasMaterialInstanceDupRule>());
+
+	// Register Shader Permutation Rule
+	Registry.Register(MakeShared<FAtlasShaderPermutationRule>());
+
+	// Register Duplicate Rule (disabled for scans; rebuilds the fixes of dedup issues)
+	Registry.Register(MakeShared<FAtlasDuplicateRule>());
+
 	// Additional rules can be registered here following the same pattern
 	// Registry.Register(MakeShared<FAtlasTextureSizeRule>());
-	// Registry.Register(MakeShared<FAtlasStaticMeshLODRule>());
-	// Registry.Register(MakeShared<FAtlasMaterialInstanceDupRule>());
 	// etc.
 
 	UE_LOG(LogAtlas, Log, TEXT("Registered %d validation rules"), Registry.All().Num());
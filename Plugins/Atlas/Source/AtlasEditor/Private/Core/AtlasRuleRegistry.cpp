@@ -14,16 +14,19 @@ void FAtlasRuleRegistry::Register(TSharedRef<IAtlasRule> Rule)
 {
 	// Check if rule with this name already exists
 	FName RuleName = Rule->GetRuleName();
-	for (const TSharedRef<IAtlasRule>& ExistingRule : Rules)
+	if (RulesByName.Contains(RuleName))
 	{
-		if (ExistingRule->GetRuleName() == RuleName)
-		{
-			UE_LOG(LogAtlas, Warning, TEXT("Rule '%s' is already registered. Skipping."), *RuleName.ToString());
-			return;
-		}
+		UE_LOG(LogAtlas, Warning, TEXT("Rule '%s' is already registered. Skipping."), *RuleName.ToString());
+		return;
 	}
 
 	Rules.Add(Rule);
+	RulesByName.Add(RuleName, Rule);
+
+	TArray<const UClass*>& Classes = RuleClasses.AddDefaulted_GetRef();
+	Rule->GetSupportedClasses(Classes);
+
+	DispatchTable.Reset();
 	UE_LOG(LogAtlas, Log, TEXT("Registered Atlas rule: %s"), *RuleName.ToString());
 }
 
@@ -32,20 +35,56 @@ const TArray<TSharedRef<IAtlasRule>>& FAtlasRuleRegistry::All() const
 	return Rules;
 }
 
-TSharedPtr<IAtlasRule> FAtlasRuleRegistry::FindRule(FName RuleName) const
+TConstArrayView<TSharedRef<IAtlasRule>> FAtlasRuleRegistry::GetRulesForClass(const UClass* Class)
 {
-	for (const TSharedRef<IAtlasRule>& Rule : Rules)
+	if (!Class)
+	{
+		return Rules;
+	}
+
+	if (const TArray<TSharedRef<IAtlasRule>>* Cached = DispatchTable.Find(Class))
+	{
+		return *Cached;
+	}
+
+	TArray<TSharedRef<IAtlasRule>> ClassRules;
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
 	{
-		if (Rule->GetRuleName() == RuleName)
+		const TArray<const UClass*>& Classes = RuleClasses[RuleIndex];
+
+		bool bApplies = Classes.Num() == 0;
+		for (const UClass* SupportedClass : Classes)
+		{
+			if (Class->IsChildOf(SupportedClass))
+			{
+				bApplies = true;
+				break;
+			}
+		}
+
+		if (bApplies)
 		{
-			return Rule;
+			ClassRules.Add(Rules[RuleIndex]);
 		}
 	}
+
+	return DispatchTable.Add(Class, MoveTemp(ClassRules));
+}
+
+TSharedPtr<IAtlasRule> FAtlasRuleRegistry::FindRule(FName RuleName) const
+{
+	if (const TSharedRef<IAtlasRule>* Rule = RulesByName.Find(RuleName))
+	{
+		return *Rule;
+	}
 	return nullptr;
 }
 
 void FAtlasRuleRegistry::Clear()
 {
 	Rules.Empty();
+	RuleClasses.Empty();
+	RulesByName.Empty();
+	DispatchTable.Empty();
 	UE_LOG(LogAtlas, Log, TEXT("Cleared all Atlas rules"));
 }
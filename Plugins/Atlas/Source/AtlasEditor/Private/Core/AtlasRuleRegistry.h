@@ -30,6 +30,16 @@ public:
 	 */
 	const TArray<TSharedRef<IAtlasRule>>& All() const;
 
+	/**
+	 * Get the rules that apply to an asset class, in registration order
+	 * The dispatch table is built lazily per class and reset whenever rules change.
+	 * Game thread only. The returned view points at the class's own allocation, which later lookups of
+	 * other classes never move, so it stays valid until the registry changes.
+	 * @param Class The asset class, or nullptr if unknown (returns every rule)
+	 * @return Rules whose supported classes include Class or one of its parents
+	 */
+	TConstArrayView<TSharedRef<IAtlasRule>> GetRulesForClass(const UClass* Class);
+
 	/**
 	 * Find a rule by name
 	 * @param RuleName The name of the rule to find
@@ -52,4 +62,13 @@ private:
 
 private:
 	TArray<TSharedRef<IAtlasRule>> Rules;
+
+	/** Supported classes of each rule, parallel to Rules; empty means every class */
+	TArray<TArray<const UClass*>> RuleClasses;
+
+	/** Rules by name for O(1) lookup */
+	TMap<FName, TSharedRef<IAtlasRule>> RulesByName;
+
+	/** Class to applicable rules, filled on demand; rehashing moves the arrays but not their elements */
+	TMap<const UClass*, TArray<TSharedRef<IAtlasRule>>> DispatchTable;
 };
@@ -0,0 +1,257 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasScanCache.h"
+#include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/NameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+namespace AtlasScanCache
+{
+	static constexpr uint32 FileMagic = 0x41534331; // "ASC1"
+	static constexpr int32 FileVersion = 1;
+}
+
+FAtlasScanCache& FAtlasScanCache::Get()
+{
+	static FAtlasScanCache Instance;
+	return Instance;
+}
+
+FAtlasScanCache::FAtlasScanCache()
+	: SettingsHash(0)
+	, bDirty(false)
+{
+	Load();
+}
+
+FString FAtlasScanCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Atlas") / TEXT("ScanCache.bin");
+}
+
+void FAtlasScanCache::SetSettingsHash(uint32 InSettingsHash)
+{
+	if (InSettingsHash != SettingsHash)
+	{
+		if (Entries.Num() > 0)
+		{
+			UE_LOG(LogAtlas, Log, TEXT("Validation settings changed, discarding %d cached packages"), Entries.Num());
+		}
+
+		Entries.Reset();
+		SettingsHash = InSettingsHash;
+		bDirty = true;
+	}
+}
+
+void FAtlasScanCache::BeginScan(uint32 InSettingsHash)
+{
+	SetSettingsHash(InSettingsHash);
+
+	for (TPair<FName, FPackageEntry>& Pair : Entries)
+	{
+		Pair.Value.bTouched = false;
+	}
+}
+
+void FAtlasScanCache::EndScan(bool bPruneUntouched)
+{
+	if (bPruneUntouched)
+	{
+		const int32 NumBefore = Entries.Num();
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().bTouched)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		bDirty |= Entries.Num() != NumBefore;
+	}
+
+	Flush();
+}
+
+void FAtlasScanCache::Flush()
+{
+	if (bDirty)
+	{
+		Save();
+	}
+}
+
+bool FAtlasScanCache::GetPackageStamp(const FAssetData& AssetData, uint64& OutStamp)
+{
+	// In-memory edits are not reflected on disk yet
+	if (const UPackage* Package = FindPackage(nullptr, *AssetData.PackageName.ToString()))
+	{
+		if (Package->IsDirty())
+		{
+			return false;
+		}
+	}
+
+	FString Filename;
+	if (!FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &Filename))
+	{
+		return false;
+	}
+
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*Filename);
+	if (!StatData.bIsValid)
+	{
+		return false;
+	}
+
+	OutStamp = static_cast<uint64>(StatData.ModificationTime.GetTicks()) ^ (static_cast<uint64>(StatData.FileSize) * 0x9E3779B97F4A7C15ull);
+	return true;
+}
+
+bool FAtlasScanCache::Find(FName PackageName, uint64 PackageStamp, FName RuleName, int32 RuleVersion, TArray<FAtlasIssue>& OutIssues)
+{
+	FPackageEntry* Entry = Entries.Find(PackageName);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	Entry->bTouched = true;
+
+	if (Entry->PackageStamp != PackageStamp)
+	{
+		// The package was saved since it was cached; every rule result is stale
+		Entry->PackageStamp = PackageStamp;
+		Entry->Rules.Reset();
+		bDirty = true;
+		return false;
+	}
+
+	for (const FRuleResult& Result : Entry->Rules)
+	{
+		if (Result.RuleName == RuleName)
+		{
+			if (Result.RuleVersion != RuleVersion)
+			{
+				return false;
+			}
+
+			for (const FCachedIssue& Cached : Result.Issues)
+			{
+				OutIssues.Add(FAtlasIssue(Cached.AssetPath, RuleName, Cached.Severity, Cached.Message, Cached.bCanFix));
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FAtlasScanCache::Store(FName PackageName, uint64 PackageStamp, FName RuleName, int32 RuleVersion, TArrayView<const FAtlasIssue> Issues)
+{
+	FPackageEntry& Entry = Entries.FindOrAdd(PackageName);
+	if (Entry.PackageStamp != PackageStamp)
+	{
+		Entry.PackageStamp = PackageStamp;
+		Entry.Rules.Reset();
+	}
+	Entry.bTouched = true;
+
+	FRuleResult* Result = Entry.Rules.FindByPredicate([RuleName](const FRuleResult& Existing)
+	{
+		return Existing.RuleName == RuleName;
+	});
+
+	if (!Result)
+	{
+		Result = &Entry.Rules.AddDefaulted_GetRef();
+		Result->RuleName = RuleName;
+	}
+
+	Result->RuleVersion = RuleVersion;
+	Result->Issues.Reset(Issues.Num());
+	for (const FAtlasIssue& Issue : Issues)
+	{
+		FCachedIssue& Cached = Result->Issues.AddDefaulted_GetRef();
+		Cached.AssetPath = Issue.AssetPath;
+		Cached.Message = Issue.Message;
+		Cached.Severity = Issue.Severity;
+		Cached.bCanFix = Issue.bCanFix;
+	}
+
+	bDirty = true;
+}
+
+void FAtlasScanCache::Invalidate(FName PackageName)
+{
+	if (Entries.Remove(PackageName) > 0)
+	{
+		bDirty = true;
+	}
+}
+
+void FAtlasScanCache::Clear()
+{
+	Entries.Reset();
+	bDirty = false;
+	IFileManager::Get().Delete(*GetCacheFilePath(), false, true, true);
+	UE_LOG(LogAtlas, Log, TEXT("Cleared Atlas scan cache"));
+}
+
+void FAtlasScanCache::Load()
+{
+	TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*GetCacheFilePath()));
+	if (!FileReader)
+	{
+		return;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileReader);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic << Version;
+	if (Magic != AtlasScanCache::FileMagic || Version != AtlasScanCache::FileVersion)
+	{
+		UE_LOG(LogAtlas, Log, TEXT("Ignoring scan cache with unknown format: %s"), *GetCacheFilePath());
+		return;
+	}
+
+	Ar << SettingsHash;
+	Ar << Entries;
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Scan cache is corrupt, starting fresh: %s"), *GetCacheFilePath());
+		Entries.Reset();
+		SettingsHash = 0;
+		return;
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Loaded scan cache with %d packages"), Entries.Num());
+}
+
+void FAtlasScanCache::Save()
+{
+	const FString CacheFilePath = GetCacheFilePath();
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*CacheFilePath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Could not write scan cache: %s"), *CacheFilePath);
+		return;
+	}
+
+	FNameAsStringProxyArchive Ar(*FileWriter);
+
+	uint32 Magic = AtlasScanCache::FileMagic;
+	int32 Version = AtlasScanCache::FileVersion;
+	Ar << Magic << Version;
+	Ar << SettingsHash;
+	Ar << Entries;
+
+	bDirty = false;
+}
@@ -0,0 +1,150 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+struct FAssetData;
+
+/**
+ * Persistent cache of per-package, per-rule scan results
+ * Stored in Saved/Atlas/ScanCache.bin and keyed by package path, package file stamp,
+ * rule version and the validation settings hash. Fix functions are never cached.
+ * Not thread-safe: lookups and stores happen on the game thread.
+ */
+class FAtlasScanCache
+{
+public:
+	/**
+	 * Get the singleton instance, loading the cache file on first use
+	 */
+	static FAtlasScanCache& Get();
+
+	/**
+	 * Discard everything if the validation settings changed since the results were cached
+	 * @param SettingsHash Current UAtlasSettings::GetValidationHash()
+	 */
+	void SetSettingsHash(uint32 SettingsHash);
+
+	/**
+	 * Prepare the cache for a scan, discarding everything if the validation settings changed
+	 * @param SettingsHash Current UAtlasSettings::GetValidationHash()
+	 */
+	void BeginScan(uint32 SettingsHash);
+
+	/**
+	 * Write the cache back to disk if it changed
+	 * @param bPruneUntouched Drop packages that were not visited since BeginScan (use after full scans)
+	 */
+	void EndScan(bool bPruneUntouched);
+
+	/**
+	 * Write the cache back to disk if it changed, outside of a scan
+	 */
+	void Flush();
+
+	/**
+	 * Compute the stamp identifying the saved state of an asset's package
+	 * @param AssetData The asset registry entry
+	 * @param OutStamp Hash of the package file timestamp and size
+	 * @return False if the package has unsaved changes or no file on disk, in which case it must not be cached
+	 */
+	static bool GetPackageStamp(const FAssetData& AssetData, uint64& OutStamp);
+
+	/**
+	 * Look up cached issues for one rule on one package
+	 * @param PackageName The package to look up
+	 * @param PackageStamp Current package stamp
+	 * @param RuleName The rule
+	 * @param RuleVersion Current rule version
+	 * @param OutIssues Array to append the cached issues to
+	 * @return True if a valid entry was found
+	 */
+	bool Find(FName PackageName, uint64 PackageStamp, FName RuleName, int32 RuleVersion, TArray<FAtlasIssue>& OutIssues);
+
+	/**
+	 * Store the issues a rule produced for one package
+	 * @param PackageName The package
+	 * @param PackageStamp Current package stamp
+	 * @param RuleName The rule
+	 * @param RuleVersion Current rule version
+	 * @param Issues The issues the rule reported
+	 */
+	void Store(FName PackageName, uint64 PackageStamp, FName RuleName, int32 RuleVersion, TArrayView<const FAtlasIssue> Issues);
+
+	/**
+	 * Forget everything cached for a package
+	 * @param PackageName The package to invalidate
+	 */
+	void Invalidate(FName PackageName);
+
+	/**
+	 * Drop all cached results and delete the cache file
+	 */
+	void Clear();
+
+	/**
+	 * Get the path of the cache file
+	 */
+	static FString GetCacheFilePath();
+
+private:
+	FAtlasScanCache();
+
+	// Non-copyable
+	FAtlasScanCache(const FAtlasScanCache&) = delete;
+	FAtlasScanCache& operator=(const FAtlasScanCache&) = delete;
+
+	void Load();
+	void Save();
+
+	struct FCachedIssue
+	{
+		FString AssetPath;
+		FString Message;
+		EAtlasSeverity Severity;
+		bool bCanFix;
+
+		friend FArchive& operator<<(FArchive& Ar, FCachedIssue& Issue)
+		{
+			return Ar << Issue.AssetPath << Issue.Message << Issue.Severity << Issue.bCanFix;
+		}
+	};
+
+	struct FRuleResult
+	{
+		FName RuleName;
+		int32 RuleVersion;
+		TArray<FCachedIssue> Issues;
+
+		friend FArchive& operator<<(FArchive& Ar, FRuleResult& Result)
+		{
+			return Ar << Result.RuleName << Result.RuleVersion << Result.Issues;
+		}
+	};
+
+	struct FPackageEntry
+	{
+		uint64 PackageStamp;
+		TArray<FRuleResult> Rules;
+
+		/** Visited since the last BeginScan (not serialized) */
+		bool bTouched;
+
+		FPackageEntry()
+			: PackageStamp(0)
+			, bTouched(false)
+		{
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FPackageEntry& Entry)
+		{
+			return Ar << Entry.PackageStamp << Entry.Rules;
+		}
+	};
+
+	TMap<FName, FPackageEntry> Entries;
+	uint32 SettingsHash;
+	bool bDirty;
+};
@@ -3,10 +3,50 @@
 #include "AtlasScanExecutor.h"
 #include "AtlasRuleRegistry.h"
 #include "AtlasAssetUtils.h"
+#include "AtlasScanCache.h"
+#include "AtlasIssueStore.h"
+#include "AtlasScanProfiler.h"
+#include "AtlasSettings.h"
 #include "IAtlasRule.h"
 #include "AtlasRuntime.h"
+#include "AssetCompilingManager.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/App.h"
 #include "Misc/ScopedSlowTask.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace AtlasScanExecutor
+{
+	/** Assets loaded and evaluated per batch in parallel mode; bounds how many loaded objects are alive at once */
+	static constexpr int32 ParallelBatchSize = 512;
+
+	/** Assets per worker chunk; each chunk owns one issue buffer */
+	static constexpr int32 ParallelChunkSize = 32;
+
+	/** How a rule is evaluated for one asset */
+	enum class ERuleTier : uint8
+	{
+		Skipped,
+		Cached,
+		Metadata,
+		Object
+	};
+
+	/**
+	 * Time a rule call that started at StartCycles
+	 * @return The call's duration, also recorded for the rule if Profiler is set
+	 */
+	static double EndRuleCall(FAtlasScanProfiler* Profiler, const IAtlasRule& Rule, uint64 StartCycles)
+	{
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		if (Profiler)
+		{
+			Profiler->AddRuleCall(Rule.GetRuleName(), Seconds);
+		}
+		return Seconds;
+	}
+}
 
 const TArray<FName> FAtlasScanExecutor::ScannableAssetClasses = {
 	TEXT("StaticMesh"),
@@ -16,29 +56,93 @@ const TArray<FName> FAtlasScanExecutor::ScannableAssetClasses = {
 	TEXT("MaterialInstance"),
 	TEXT("MaterialInstanceConstant"),
 	TEXT("SoundWave"),
-	TEXT("Blueprint")
+	TEXT("Blueprint"),
+	TEXT("World")
 };
 
-void FAtlasScanExecutor::ScanAll(TArray<FAtlasIssue>& OutIssues)
+void FAtlasScanExecutor::ScanAll(TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats)
 {
 	TArray<FAssetData> AllAssets;
-	GetAllScannableAssets(AllAssets);
+	const bool bComplete = GetAllScannableAssets(AllAssets);
 
 	UE_LOG(LogAtlas, Log, TEXT("Starting full scan of %d assets"), AllAssets.Num());
 
 	FScopedSlowTask Progress(AllAssets.Num(), FText::FromString(TEXT("Scanning all assets...")));
 	Progress.MakeDialog();
 
-	ScanSelection(AllAssets, OutIssues);
+	// A complete enumeration visits every package, so cache entries it did not touch belong to deleted assets
+	FIssueSink Sink(OutIssues);
+	ScanSelectionInternal(AllAssets, Sink, OutStats, bComplete);
 
 	UE_LOG(LogAtlas, Log, TEXT("Scan complete. Found %d issues"), OutIssues.Num());
 }
 
-void FAtlasScanExecutor::ScanSelection(const TArray<FAssetData>& Selection, TArray<FAtlasIssue>& OutIssues)
+void FAtlasScanExecutor::ScanAll(FAtlasIssueStore& OutStore, FAtlasScanStats* OutStats)
+{
+	TArray<FAssetData> AllAssets;
+	const bool bComplete = GetAllScannableAssets(AllAssets);
+
+	UE_LOG(LogAtlas, Log, TEXT("Starting full scan of %d assets"), AllAssets.Num());
+
+	FScopedSlowTask Progress(AllAssets.Num(), FText::FromString(TEXT("Scanning all assets...")));
+	Progress.MakeDialog();
+
+	FIssueSink Sink(OutStore);
+	ScanSelectionInternal(AllAssets, Sink, OutStats, bComplete);
+
+	UE_LOG(LogAtlas, Log, TEXT("Scan complete. Found %d issues"), OutStore.Num());
+}
+
+void FAtlasScanExecutor::ScanSelection(const TArray<FAssetData>& Selection, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats)
 {
-	const TArray<TSharedRef<IAtlasRule>>& Rules = FAtlasRuleRegistry::Get().All();
+	FIssueSink Sink(OutIssues);
+	ScanSelectionInternal(Selection, Sink, OutStats, false);
+}
+
+void FAtlasScanExecutor::ScanSelection(const TArray<FAssetData>& Selection, FAtlasIssueStore& OutStore, FAtlasScanStats* OutStats)
+{
+	FIssueSink Sink(OutStore);
+	ScanSelectionInternal(Selection, Sink, OutStats, false);
+}
+
+void FAtlasScanExecutor::ScanSelection(const TArray<FAssetData>& Selection, TFunctionRef<void(TArray<FAtlasIssue>&)> OnIssues, FAtlasScanStats* OutStats)
+{
+	FIssueSink Sink(OnIssues);
+	ScanSelectionInternal(Selection, Sink, OutStats, false);
+}
+
+void FAtlasScanExecutor::FIssueSink::Consume(TArray<FAtlasIssue>& Issues)
+{
+	if (Issues.Num() == 0)
+	{
+		return;
+	}
 
-	if (Rules.Num() == 0)
+	if (Store)
+	{
+		Store->Append(Issues);
+	}
+	else if (Callback)
+	{
+		(*Callback)(Issues);
+	}
+	else if (Array->Num() == 0)
+	{
+		*Array = MoveTemp(Issues);
+	}
+	else
+	{
+		Array->Append(MoveTemp(Issues));
+	}
+
+	Issues.Reset();
+}
+
+void FAtlasScanExecutor::ScanSelectionInternal(const TArray<FAssetData>& Selection, FIssueSink& Sink, FAtlasScanStats* OutStats, bool bFullScan)
+{
+	FAtlasRuleRegistry& Registry = FAtlasRuleRegistry::Get();
+
+	if (Registry.All().Num() == 0)
 	{
 		UE_LOG(LogAtlas, Warning, TEXT("No validation rules registered"));
 		return;
@@ -47,18 +151,515 @@ void FAtlasScanExecutor::ScanSelection(const TArray<FAssetData>& Selection, TArr
 	FScopedSlowTask Progress(Selection.Num(), FText::FromString(TEXT("Scanning selected assets...")));
 	Progress.MakeDialog();
 
-	for (const FAssetData& AssetData : Selection)
+	const double StartTime = FPlatformTime::Seconds();
+	FAtlasScanStats Stats;
+	FAtlasScanProfiler Profiler;
+
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+
+	FAtlasScanCache* Cache = nullptr;
+	if (Settings && Settings->bUseScanCache)
+	{
+		Cache = &FAtlasScanCache::Get();
+		Cache->BeginScan(Settings->GetValidationHash());
+	}
+
+	BeginRuleScan();
+
+	if (Settings && Settings->bParallelScan && FApp::ShouldUseThreadingForPerformance())
+	{
+		ScanSelectionParallel(Selection, Cache, Sink, Stats, Profiler, Progress);
+	}
+	else
+	{
+		TArray<FAtlasIssue> AssetIssues;
+		for (const FAssetData& AssetData : Selection)
+		{
+			Progress.EnterProgressFrame(1.0f);
+
+			ScanAssetDataWithRules(AssetData, Registry.GetRulesForClass(AssetData.GetClass()), Cache, AssetIssues, Stats, &Profiler);
+			Sink.Consume(AssetIssues);
+		}
+	}
+
+	EndRuleScan();
+
+	if (Cache)
+	{
+		Cache->EndScan(bFullScan);
+	}
+
+	Profiler.GetProfile(FPlatformTime::Seconds() - StartTime, Stats.Profile);
+
+	UE_LOG(LogAtlas, Log, TEXT("Scanned %d assets in %.2fs: %d loaded, %d loads avoided, %d cached rule results reused"),
+		Stats.NumAssets, Stats.Profile.ScanSeconds, Stats.NumLoaded, Stats.NumLoadsAvoided, Stats.NumCacheHits);
+
+	if (OutStats)
 	{
-		Progress.EnterProgressFrame(1.0f);
+		*OutStats = Stats;
+	}
+}
+
+void FAtlasScanExecutor::BeginRuleScan()
+{
+	for (const TSharedRef<IAtlasRule>& Rule : FAtlasRuleRegistry::Get().All())
+	{
+		Rule->BeginScan();
+	}
+}
+
+void FAtlasScanExecutor::EndRuleScan()
+{
+	for (const TSharedRef<IAtlasRule>& Rule : FAtlasRuleRegistry::Get().All())
+	{
+		Rule->EndScan();
+	}
+}
+
+FAtlasScanCache* FAtlasScanExecutor::GetSingleAssetCache()
+{
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+
+	// Single-asset scans run often (e.g. live validation), so the cache is only flushed by its owner
+	FAtlasScanCache* Cache = nullptr;
+	if (Settings && Settings->bUseScanCache)
+	{
+		Cache = &FAtlasScanCache::Get();
+		Cache->SetSettingsHash(Settings->GetValidationHash());
+	}
+	return Cache;
+}
+
+void FAtlasScanExecutor::ScanAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats)
+{
+	FAtlasScanStats Stats;
+	ScanAssetDataWithRules(AssetData, FAtlasRuleRegistry::Get().GetRulesForClass(AssetData.GetClass()), GetSingleAssetCache(), OutIssues, Stats, nullptr);
 
-		// Load the asset
-		UObject* Asset = AssetData.GetAsset();
-		if (!Asset)
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+void FAtlasScanExecutor::ScanAssetDataDeferred(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues, TArray<FName>& OutObjectRules)
+{
+	TArray<TSharedRef<IAtlasRule>> LiveRules;
+	for (const TSharedRef<IAtlasRule>& Rule : FAtlasRuleRegistry::Get().GetRulesForClass(AssetData.GetClass()))
+	{
+		if (Rule->SupportsLiveValidation())
+		{
+			LiveRules.Add(Rule);
+		}
+	}
+
+	FAtlasScanStats Stats;
+	TArray<IAtlasRule*> ObjectRules;
+	ScanAssetDataWithRules(AssetData, LiveRules, GetSingleAssetCache(), OutIssues, Stats, nullptr, &ObjectRules);
+
+	for (const IAtlasRule* Rule : ObjectRules)
+	{
+		OutObjectRules.Add(Rule->GetRuleName());
+	}
+}
+
+void FAtlasScanExecutor::ScanAssetObjectRules(const FAssetData& AssetData, TConstArrayView<FName> RuleNames, TArray<FAtlasIssue>& OutIssues)
+{
+	FAtlasRuleRegistry& Registry = FAtlasRuleRegistry::Get();
+	FAtlasScanCache* Cache = GetSingleAssetCache();
+
+	UObject* Asset = nullptr;
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Atlas Load", AtlasChannel);
+		Asset = AssetData.GetAsset();
+	}
+
+	if (!Asset)
+	{
+		return;
+	}
+
+	uint64 PackageStamp = 0;
+	const bool bCacheable = Cache && FAtlasScanCache::GetPackageStamp(AssetData, PackageStamp);
+
+	for (const FName RuleName : RuleNames)
+	{
+		TSharedPtr<IAtlasRule> Rule = Registry.FindRule(RuleName);
+		if (!Rule.IsValid() || !Rule->IsEnabled())
 		{
 			continue;
 		}
 
-		ScanAsset(Asset, OutIssues);
+		const int32 FirstIssue = OutIssues.Num();
+		{
+			FAtlasTraceScope TraceScope(TEXT("Validate"), RuleName);
+			Rule->Validate(Asset, OutIssues);
+		}
+
+		if (bCacheable && Rule->SupportsCaching())
+		{
+			Cache->Store(AssetData.PackageName, PackageStamp, RuleName, Rule->GetRuleVersion(), MakeArrayView(OutIssues).Slice(FirstIssue, OutIssues.Num() - FirstIssue));
+		}
+	}
+}
+
+void FAtlasScanExecutor::ScanAssetDataWithRules(const FAssetData& AssetData, TConstArrayView<TSharedRef<IAtlasRule>> Rules, FAtlasScanCache* Cache, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats& Stats, FAtlasScanProfiler* Profiler, TArray<IAtlasRule*>* OutObjectRules)
+{
+	using namespace AtlasScanExecutor;
+
+	++Stats.NumAssets;
+	double AssetSeconds = 0.0;
+
+	uint64 PackageStamp = 0;
+	const bool bCacheable = Cache && FAtlasScanCache::GetPackageStamp(AssetData, PackageStamp);
+
+	// First tier: everything that is cached or can be answered from registry tags
+	TArray<IAtlasRule*, TInlineAllocator<16>> ObjectRules;
+	for (const TSharedRef<IAtlasRule>& Rule : Rules)
+	{
+		if (!Rule->IsEnabled())
+		{
+			continue;
+		}
+
+		if (bCacheable && Rule->SupportsCaching() && Cache->Find(AssetData.PackageName, PackageStamp, Rule->GetRuleName(), Rule->GetRuleVersion(), OutIssues))
+		{
+			++Stats.NumCacheHits;
+			continue;
+		}
+
+		if (Rule->CanValidateAssetData(AssetData))
+		{
+			const int32 FirstIssue = OutIssues.Num();
+			{
+				FAtlasTraceScope TraceScope(TEXT("ValidateAssetData"), Rule->GetRuleName());
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Rule->ValidateAssetData(AssetData, OutIssues);
+				AssetSeconds += EndRuleCall(Profiler, *Rule, StartCycles);
+			}
+
+			if (bCacheable && Rule->SupportsCaching())
+			{
+				Cache->Store(AssetData.PackageName, PackageStamp, Rule->GetRuleName(), Rule->GetRuleVersion(), MakeArrayView(OutIssues).Slice(FirstIssue, OutIssues.Num() - FirstIssue));
+			}
+		}
+		else
+		{
+			ObjectRules.Add(&Rule.Get());
+		}
+	}
+
+	if (OutObjectRules)
+	{
+		OutObjectRules->Append(ObjectRules);
+		return;
+	}
+
+	const bool bWasLoaded = AssetData.IsAssetLoaded();
+	if (ObjectRules.Num() == 0)
+	{
+		if (!bWasLoaded)
+		{
+			++Stats.NumLoadsAvoided;
+		}
+
+		if (Profiler)
+		{
+			Profiler->AddAsset(AssetData, AssetSeconds, 0.0);
+		}
+		return;
+	}
+
+	// Second tier: only rules that really need the object pay for the load
+	UObject* Asset = nullptr;
+	double LoadSeconds = 0.0;
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Atlas Load", AtlasChannel);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Asset = AssetData.GetAsset();
+		LoadSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		AssetSeconds += LoadSeconds;
+	}
+
+	if (!Asset)
+	{
+		if (Profiler)
+		{
+			Profiler->AddAsset(AssetData, AssetSeconds, LoadSeconds);
+		}
+		return;
+	}
+
+	if (!bWasLoaded)
+	{
+		++Stats.NumLoaded;
+	}
+
+	for (IAtlasRule* Rule : ObjectRules)
+	{
+		const int32 FirstIssue = OutIssues.Num();
+		{
+			FAtlasTraceScope TraceScope(TEXT("Validate"), Rule->GetRuleName());
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Rule->Validate(Asset, OutIssues);
+			AssetSeconds += EndRuleCall(Profiler, *Rule, StartCycles);
+		}
+
+		if (bCacheable && Rule->SupportsCaching())
+		{
+			Cache->Store(AssetData.PackageName, PackageStamp, Rule->GetRuleName(), Rule->GetRuleVersion(), MakeArrayView(OutIssues).Slice(FirstIssue, OutIssues.Num() - FirstIssue));
+		}
+	}
+
+	if (Profiler)
+	{
+		Profiler->AddAsset(AssetData, AssetSeconds, LoadSeconds);
+	}
+}
+
+void FAtlasScanExecutor::ScanSelectionParallel(const TArray<FAssetData>& Selection, FAtlasScanCache* Cache, FIssueSink& Sink, FAtlasScanStats& Stats, FAtlasScanProfiler& Profiler, FScopedSlowTask& Progress)
+{
+	using namespace AtlasScanExecutor;
+
+	FAtlasRuleRegistry& Registry = FAtlasRuleRegistry::Get();
+
+	// Per-batch state. (asset, rule) pairs are stored flat: the pairs of item I are [PairStarts[I], PairStarts[I + 1])
+	TArray<UObject*> Assets;
+	TArray<UObject*> CompilingAssets;
+	TArray<uint64> PackageStamps;
+	TBitArray<> Cacheable;
+	TArray<int32> PairStarts;
+	TArray<IAtlasRule*> PairRules;
+	TBitArray<> PairThreadSafe;
+	TArray<ERuleTier> Tiers;
+	TArray<int32> FirstIssues;
+	TArray<int32> LastIssues;
+	TArray<double> LoadSeconds;
+	TArray<double> PairSeconds;
+	TArray<TArray<FAtlasIssue>> ChunkIssues;
+
+	for (int32 BatchStart = 0; BatchStart < Selection.Num(); BatchStart += ParallelBatchSize)
+	{
+		const int32 BatchNum = FMath::Min(ParallelBatchSize, Selection.Num() - BatchStart);
+		const int32 NumChunks = FMath::DivideAndRoundUp(BatchNum, ParallelChunkSize);
+
+		Progress.EnterProgressFrame(static_cast<float>(BatchNum));
+
+		Assets.Reset();
+		Assets.AddZeroed(BatchNum);
+		PackageStamps.Reset();
+		PackageStamps.AddZeroed(BatchNum);
+		LoadSeconds.Reset();
+		LoadSeconds.AddZeroed(BatchNum);
+		Cacheable.Init(false, BatchNum);
+		PairStarts.Reset();
+		PairRules.Reset();
+		PairThreadSafe.Reset();
+		Tiers.Reset();
+
+		ChunkIssues.SetNum(NumChunks);
+		for (TArray<FAtlasIssue>& Buffer : ChunkIssues)
+		{
+			Buffer.Reset();
+		}
+
+		// Game thread: dispatch by class, resolve cached results, decide the tier of every pair and load what is needed
+		for (int32 ItemIndex = 0; ItemIndex < BatchNum; ++ItemIndex)
+		{
+			const FAssetData& AssetData = Selection[BatchStart + ItemIndex];
+			TArray<FAtlasIssue>& Buffer = ChunkIssues[ItemIndex / ParallelChunkSize];
+			++Stats.NumAssets;
+
+			PairStarts.Add(PairRules.Num());
+			Cacheable[ItemIndex] = Cache && FAtlasScanCache::GetPackageStamp(AssetData, PackageStamps[ItemIndex]);
+
+			bool bNeedsLoad = false;
+			for (const TSharedRef<IAtlasRule>& RuleRef : Registry.GetRulesForClass(AssetData.GetClass()))
+			{
+				IAtlasRule* Rule = &RuleRef.Get();
+				if (!Rule->IsEnabled())
+				{
+					continue;
+				}
+
+				PairRules.Add(Rule);
+				PairThreadSafe.Add(Rule->IsThreadSafe());
+
+				if (Cacheable[ItemIndex] && Rule->SupportsCaching() && Cache->Find(AssetData.PackageName, PackageStamps[ItemIndex], Rule->GetRuleName(), Rule->GetRuleVersion(), Buffer))
+				{
+					Tiers.Add(ERuleTier::Cached);
+					++Stats.NumCacheHits;
+				}
+				else if (Rule->CanValidateAssetData(AssetData))
+				{
+					Tiers.Add(ERuleTier::Metadata);
+				}
+				else
+				{
+					Tiers.Add(ERuleTier::Object);
+					bNeedsLoad = true;
+				}
+			}
+
+			const bool bWasLoaded = AssetData.IsAssetLoaded();
+			if (!bNeedsLoad)
+			{
+				if (!bWasLoaded)
+				{
+					++Stats.NumLoadsAvoided;
+				}
+				continue;
+			}
+
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Atlas Load", AtlasChannel);
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Assets[ItemIndex] = AssetData.GetAsset();
+				LoadSeconds[ItemIndex] = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+			}
+
+			if (Assets[ItemIndex] && !bWasLoaded)
+			{
+				++Stats.NumLoaded;
+			}
+		}
+
+		PairStarts.Add(PairRules.Num());
+
+		// Worker getters on a mesh or texture that is still compiling would wait for the compile, which only the game thread may do
+		CompilingAssets.Reset();
+		for (int32 ItemIndex = 0; ItemIndex < BatchNum; ++ItemIndex)
+		{
+			if (!Assets[ItemIndex])
+			{
+				continue;
+			}
+
+			for (int32 PairIndex = PairStarts[ItemIndex]; PairIndex < PairStarts[ItemIndex + 1]; ++PairIndex)
+			{
+				if (PairThreadSafe[PairIndex] && Tiers[PairIndex] == ERuleTier::Object)
+				{
+					CompilingAssets.Add(Assets[ItemIndex]);
+					break;
+				}
+			}
+		}
+
+		if (CompilingAssets.Num() > 0)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Atlas FinishCompilation", AtlasChannel);
+			FAssetCompilingManager::Get().FinishCompilationForObjects(CompilingAssets);
+		}
+
+		FirstIssues.SetNumUninitialized(PairRules.Num());
+		LastIssues.SetNumUninitialized(PairRules.Num());
+		PairSeconds.Reset();
+		PairSeconds.AddZeroed(PairRules.Num());
+
+		auto EvaluatePair = [&](int32 ItemIndex, int32 PairIndex, TArray<FAtlasIssue>& Buffer)
+		{
+			IAtlasRule* Rule = PairRules[PairIndex];
+
+			// Timings go to the pair's own slot; the game thread records them after the batch
+			FirstIssues[PairIndex] = Buffer.Num();
+			if (Tiers[PairIndex] == ERuleTier::Metadata)
+			{
+				FAtlasTraceScope TraceScope(TEXT("ValidateAssetData"), Rule->GetRuleName());
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Rule->ValidateAssetData(Selection[BatchStart + ItemIndex], Buffer);
+				PairSeconds[PairIndex] = EndRuleCall(nullptr, *Rule, StartCycles);
+			}
+			else if (Tiers[PairIndex] == ERuleTier::Object)
+			{
+				if (Assets[ItemIndex])
+				{
+					FAtlasTraceScope TraceScope(TEXT("Validate"), Rule->GetRuleName());
+					const uint64 StartCycles = FPlatformTime::Cycles64();
+					Rule->Validate(Assets[ItemIndex], Buffer);
+					PairSeconds[PairIndex] = EndRuleCall(nullptr, *Rule, StartCycles);
+				}
+				else
+				{
+					Tiers[PairIndex] = ERuleTier::Skipped;
+				}
+			}
+			LastIssues[PairIndex] = Buffer.Num();
+		};
+
+		// Workers: thread-safe rules, one private buffer per chunk
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			TArray<FAtlasIssue>& Buffer = ChunkIssues[ChunkIndex];
+			const int32 ItemEnd = FMath::Min((ChunkIndex + 1) * ParallelChunkSize, BatchNum);
+			for (int32 ItemIndex = ChunkIndex * ParallelChunkSize; ItemIndex < ItemEnd; ++ItemIndex)
+			{
+				for (int32 PairIndex = PairStarts[ItemIndex]; PairIndex < PairStarts[ItemIndex + 1]; ++PairIndex)
+				{
+					if (PairThreadSafe[PairIndex])
+					{
+						EvaluatePair(ItemIndex, PairIndex, Buffer);
+					}
+				}
+			}
+		});
+
+		// Game thread: everything else, appended to the same chunk buffers
+		for (int32 ItemIndex = 0; ItemIndex < BatchNum; ++ItemIndex)
+		{
+			TArray<FAtlasIssue>& Buffer = ChunkIssues[ItemIndex / ParallelChunkSize];
+			for (int32 PairIndex = PairStarts[ItemIndex]; PairIndex < PairStarts[ItemIndex + 1]; ++PairIndex)
+			{
+				if (!PairThreadSafe[PairIndex])
+				{
+					EvaluatePair(ItemIndex, PairIndex, Buffer);
+				}
+			}
+		}
+
+		// Game thread: record timings
+		for (int32 ItemIndex = 0; ItemIndex < BatchNum; ++ItemIndex)
+		{
+			double AssetSeconds = LoadSeconds[ItemIndex];
+			for (int32 PairIndex = PairStarts[ItemIndex]; PairIndex < PairStarts[ItemIndex + 1]; ++PairIndex)
+			{
+				if (Tiers[PairIndex] == ERuleTier::Metadata || Tiers[PairIndex] == ERuleTier::Object)
+				{
+					Profiler.AddRuleCall(PairRules[PairIndex]->GetRuleName(), PairSeconds[PairIndex]);
+					AssetSeconds += PairSeconds[PairIndex];
+				}
+			}
+
+			Profiler.AddAsset(Selection[BatchStart + ItemIndex], AssetSeconds, LoadSeconds[ItemIndex]);
+		}
+
+		// Game thread: remember freshly computed results
+		if (Cache)
+		{
+			for (int32 ItemIndex = 0; ItemIndex < BatchNum; ++ItemIndex)
+			{
+				if (!Cacheable[ItemIndex])
+				{
+					continue;
+				}
+
+				const FAssetData& AssetData = Selection[BatchStart + ItemIndex];
+				TArray<FAtlasIssue>& Buffer = ChunkIssues[ItemIndex / ParallelChunkSize];
+				for (int32 PairIndex = PairStarts[ItemIndex]; PairIndex < PairStarts[ItemIndex + 1]; ++PairIndex)
+				{
+					IAtlasRule* Rule = PairRules[PairIndex];
+					if ((Tiers[PairIndex] == ERuleTier::Metadata || Tiers[PairIndex] == ERuleTier::Object) && Rule->SupportsCaching())
+					{
+						Cache->Store(AssetData.PackageName, PackageStamps[ItemIndex], Rule->GetRuleName(), Rule->GetRuleVersion(),
+							MakeArrayView(Buffer).Slice(FirstIssues[PairIndex], LastIssues[PairIndex] - FirstIssues[PairIndex]));
+					}
+				}
+			}
+		}
+
+		// Merge in chunk order
+		for (TArray<FAtlasIssue>& Buffer : ChunkIssues)
+		{
+			Sink.Consume(Buffer);
+		}
 	}
 }
 
@@ -69,7 +670,7 @@ void FAtlasScanExecutor::ScanAsset(UObject* Asset, TArray<FAtlasIssue>& OutIssue
 		return;
 	}
 
-	const TArray<TSharedRef<IAtlasRule>>& Rules = FAtlasRuleRegistry::Get().All();
+	const TConstArrayView<TSharedRef<IAtlasRule>> Rules = FAtlasRuleRegistry::Get().GetRulesForClass(Asset->GetClass());
 
 	for (const TSharedRef<IAtlasRule>& Rule : Rules)
 	{
@@ -78,18 +679,48 @@ void FAtlasScanExecutor::ScanAsset(UObject* Asset, TArray<FAtlasIssue>& OutIssue
 			continue;
 		}
 
-		TArray<FAtlasIssue> RuleIssues;
-		Rule->Validate(Asset, RuleIssues);
+		FAtlasTraceScope TraceScope(TEXT("Validate"), Rule->GetRuleName());
+		Rule->Validate(Asset, OutIssues);
+	}
+}
+
+bool FAtlasScanExecutor::ResolveFixFunction(FAtlasIssue& Issue)
+{
+	if (Issue.FixFunction || !Issue.bCanFix)
+	{
+		return static_cast<bool>(Issue.FixFunction);
+	}
+
+	TSharedPtr<IAtlasRule> Rule = FAtlasRuleRegistry::Get().FindRule(Issue.RuleName);
+	UObject* Asset = FAtlasAssetUtils::LoadAsset(Issue.AssetPath);
+	if (!Rule.IsValid() || !Asset)
+	{
+		return false;
+	}
 
-		OutIssues.Append(RuleIssues);
+	// Re-run the rule on the live object and adopt the fix of the matching issue
+	TArray<FAtlasIssue> LiveIssues;
+	Rule->Validate(Asset, LiveIssues);
+
+	for (FAtlasIssue& LiveIssue : LiveIssues)
+	{
+		if (LiveIssue.Message == Issue.Message && LiveIssue.FixFunction)
+		{
+			Issue.FixFunction = MoveTemp(LiveIssue.FixFunction);
+			return true;
+		}
 	}
+
+	return false;
 }
 
-void FAtlasScanExecutor::GetAllScannableAssets(TArray<FAssetData>& OutAssets)
+bool FAtlasScanExecutor::GetAllScannableAssets(TArray<FAssetData>& OutAssets)
 {
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
+	// Classes are matched with their subclasses, so an asset can match several entries (e.g. MaterialInstanceConstant)
+	TSet<FName> SeenPaths;
 	for (const FName& ClassName : ScannableAssetClasses)
 	{
 		TArray<FAssetData> ClassAssets;
@@ -97,13 +728,63 @@ void FAtlasScanExecutor::GetAllScannableAssets(TArray<FAssetData>& OutAssets)
 		Filter.ClassNames.Add(ClassName);
 		Filter.bRecursiveClasses = true;
 		Filter.PackagePaths.Add("/Game"); // Only scan game content
+		Filter.bRecursivePaths = true;
 
 		AssetRegistry.GetAssets(Filter, ClassAssets);
-		OutAssets.Append(ClassAssets);
+
+		SeenPaths.Reserve(SeenPaths.Num() + ClassAssets.Num());
+		for (FAssetData& AssetData : ClassAssets)
+		{
+			bool bAlreadySeen = false;
+			SeenPaths.Add(AssetData.ObjectPath, &bAlreadySeen);
+			if (!bAlreadySeen)
+			{
+				OutAssets.Add(MoveTemp(AssetData));
+			}
+		}
 	}
+
+	return !AssetRegistry.IsLoadingAssets();
 }
 
 bool FAtlasScanExecutor::ShouldScanAssetType(const FName& ClassName)
 {
 	return ScannableAssetClasses.Contains(ClassName);
 }
+
+bool FAtlasScanExecutor::ShouldScanAsset(const FAssetData& AssetData)
+{
+	if (ShouldScanAssetType(AssetData.AssetClass))
+	{
+		return true;
+	}
+
+	const UClass* AssetClass = AssetData.GetClass();
+	if (!AssetClass)
+	{
+		return false;
+	}
+
+	// Scannable classes are native, so they are resolved once
+	static TArray<const UClass*> ScannableClasses;
+	if (ScannableClasses.Num() == 0)
+	{
+		for (const FName& ClassName : ScannableAssetClasses)
+		{
+			if (const UClass* ScannableClass = FindObject<UClass>(ANY_PACKAGE, *ClassName.ToString()))
+			{
+				ScannableClasses.Add(ScannableClass);
+			}
+		}
+	}
+
+	for (const UClass* ScannableClass : ScannableClasses)
+	{
+		if (AssetClass->IsChildOf(ScannableClass))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -6,25 +6,124 @@
 #include "AtlasTypes.h"
 
 struct FAssetData;
+class IAtlasRule;
+class FAtlasScanCache;
+class FAtlasIssueStore;
+class FAtlasScanProfiler;
+
+/**
+ * Counters collected while running a scan
+ */
+struct FAtlasScanStats
+{
+	/** Number of assets visited */
+	int32 NumAssets;
+
+	/** Number of packages that had to be loaded for object-based rules */
+	int32 NumLoaded;
+
+	/** Number of unloaded assets validated from asset registry data only */
+	int32 NumLoadsAvoided;
+
+	/** Number of (asset, rule) results reused from the scan cache */
+	int32 NumCacheHits;
+
+	/** Time per rule and slowest assets; filled by ScanAll and ScanSelection */
+	FAtlasScanProfile Profile;
+
+	FAtlasScanStats()
+		: NumAssets(0)
+		, NumLoaded(0)
+		, NumLoadsAvoided(0)
+		, NumCacheHits(0)
+	{
+	}
+};
 
 /**
  * Executes validation scans across assets using registered rules
  */
-class FAtlasScanExecutor
+class ATLASEDITOR_API FAtlasScanExecutor
 {
 public:
 	/**
 	 * Scan all assets in the project
 	 * @param OutIssues Array to fill with found issues
+	 * @param OutStats Optional scan counters
 	 */
-	static void ScanAll(TArray<FAtlasIssue>& OutIssues);
+	static void ScanAll(TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats = nullptr);
+
+	/**
+	 * Scan all assets in the project into an issue store
+	 * Results are moved into the store per batch, so the full issue array is never built
+	 * @param OutStore Store to add found issues to
+	 * @param OutStats Optional scan counters
+	 */
+	static void ScanAll(FAtlasIssueStore& OutStore, FAtlasScanStats* OutStats = nullptr);
 
 	/**
 	 * Scan only selected assets
+	 * Assets are only loaded when a rule cannot validate them from asset registry data
 	 * @param Selection Assets to scan
 	 * @param OutIssues Array to fill with found issues
+	 * @param OutStats Optional scan counters
+	 */
+	static void ScanSelection(const TArray<FAssetData>& Selection, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats = nullptr);
+
+	/**
+	 * Scan only selected assets into an issue store
+	 * @param Selection Assets to scan
+	 * @param OutStore Store to add found issues to
+	 * @param OutStats Optional scan counters
+	 */
+	static void ScanSelection(const TArray<FAssetData>& Selection, FAtlasIssueStore& OutStore, FAtlasScanStats* OutStats = nullptr);
+
+	/**
+	 * Scan only selected assets, handing issues to a callback per batch instead of collecting them
+	 * Batches arrive in selection order and each holds the issues of a contiguous run of assets.
+	 * @param Selection Assets to scan
+	 * @param OnIssues Called with each batch; it may move the issues out
+	 * @param OutStats Optional scan counters
+	 */
+	static void ScanSelection(const TArray<FAssetData>& Selection, TFunctionRef<void(TArray<FAtlasIssue>&)> OnIssues, FAtlasScanStats* OutStats = nullptr);
+
+	/**
+	 * Scan a single asset registry entry, loading it only if a rule requires the object
+	 * Uses the scan cache but does not write it to disk; call FAtlasScanCache::Flush when done
+	 * @param AssetData The asset to scan
+	 * @param OutIssues Array to fill with found issues
+	 * @param OutStats Optional scan counters
+	 */
+	static void ScanAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats* OutStats = nullptr);
+
+	/**
+	 * Scan a single asset registry entry without loading it, for live validation
+	 * Only rules that support live validation run. Cached and registry-data results are added to OutIssues;
+	 * rules that need the loaded object are returned instead, to be run later with ScanAssetObjectRules.
+	 * Call between BeginRuleScan and EndRuleScan.
+	 * @param AssetData The asset to scan
+	 * @param OutIssues Array to fill with found issues
+	 * @param OutObjectRules Array to fill with the names of rules that still need the loaded object
 	 */
-	static void ScanSelection(const TArray<FAssetData>& Selection, TArray<FAtlasIssue>& OutIssues);
+	static void ScanAssetDataDeferred(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues, TArray<FName>& OutObjectRules);
+
+	/**
+	 * Load an asset and run the rules ScanAssetDataDeferred left for it, caching their results
+	 * Call between BeginRuleScan and EndRuleScan.
+	 * @param AssetData The asset to scan
+	 * @param RuleNames Rules returned by ScanAssetDataDeferred
+	 * @param OutIssues Array to fill with found issues
+	 */
+	static void ScanAssetObjectRules(const FAssetData& AssetData, TConstArrayView<FName> RuleNames, TArray<FAtlasIssue>& OutIssues);
+
+	/**
+	 * Let every rule set up state shared across the assets of a scan
+	 * Full scans do this themselves; callers that scan single assets in batches bracket each batch
+	 */
+	static void BeginRuleScan();
+
+	/** Release what rules kept since BeginRuleScan */
+	static void EndRuleScan();
 
 	/**
 	 * Scan a single asset
@@ -34,10 +133,19 @@ public:
 	static void ScanAsset(UObject* Asset, TArray<FAtlasIssue>& OutIssues);
 
 	/**
-	 * Get all assets that should be scanned
+	 * Rebuild the fix function of an issue that has none, e.g. one restored from the scan cache
+	 * Loads the asset and re-runs the issue's rule on it
+	 * @param Issue The issue to resolve
+	 * @return True if the issue has a fix function afterwards
+	 */
+	static bool ResolveFixFunction(FAtlasIssue& Issue);
+
+	/**
+	 * Get all assets that should be scanned: game content of the scannable classes, in every subfolder, each once
 	 * @param OutAssets Array to fill with assets
+	 * @return False if the asset registry is still discovering content, so some assets may be missing
 	 */
-	static void GetAllScannableAssets(TArray<FAssetData>& OutAssets);
+	static bool GetAllScannableAssets(TArray<FAssetData>& OutAssets);
 
 	/**
 	 * Check if an asset type should be scanned
@@ -46,7 +154,67 @@ public:
 	 */
 	static bool ShouldScanAssetType(const FName& ClassName);
 
+	/**
+	 * Check if an asset should be scanned by class, subclasses included as in GetAllScannableAssets
+	 * @param AssetData The asset to check
+	 * @return True if the asset's class is or derives from a scannable class
+	 */
+	static bool ShouldScanAsset(const FAssetData& AssetData);
+
 private:
+	/** Destination of scan results: a plain array, an issue store or a batch callback */
+	struct FIssueSink
+	{
+		TArray<FAtlasIssue>* Array;
+		FAtlasIssueStore* Store;
+		const TFunctionRef<void(TArray<FAtlasIssue>&)>* Callback;
+
+		explicit FIssueSink(TArray<FAtlasIssue>& InArray)
+			: Array(&InArray)
+			, Store(nullptr)
+			, Callback(nullptr)
+		{
+		}
+
+		explicit FIssueSink(FAtlasIssueStore& InStore)
+			: Array(nullptr)
+			, Store(&InStore)
+			, Callback(nullptr)
+		{
+		}
+
+		explicit FIssueSink(const TFunctionRef<void(TArray<FAtlasIssue>&)>& InCallback)
+			: Array(nullptr)
+			, Store(nullptr)
+			, Callback(&InCallback)
+		{
+		}
+
+		/** Move the issues into the destination, leaving Issues empty */
+		void Consume(TArray<FAtlasIssue>& Issues);
+	};
+
+	/**
+	 * Shared implementation of ScanAll and ScanSelection
+	 * bFullScan means Selection is known to hold every scannable asset, so cache entries it did not touch are pruned
+	 */
+	static void ScanSelectionInternal(const TArray<FAssetData>& Selection, FIssueSink& Sink, FAtlasScanStats* OutStats, bool bFullScan);
+
+	/**
+	 * Run the given rules (already filtered to the asset's class) against one asset registry entry; Profiler may be null
+	 * If OutObjectRules is set, rules that need the loaded object are added to it instead of loading the asset
+	 */
+	static void ScanAssetDataWithRules(const FAssetData& AssetData, TConstArrayView<TSharedRef<IAtlasRule>> Rules, FAtlasScanCache* Cache, TArray<FAtlasIssue>& OutIssues, FAtlasScanStats& Stats, FAtlasScanProfiler* Profiler, TArray<IAtlasRule*>* OutObjectRules = nullptr);
+
+	/** Get the scan cache if the settings enable it, keyed to the current settings; never written to disk here */
+	static FAtlasScanCache* GetSingleAssetCache();
+
+	/**
+	 * Scan a selection in batches, loading on the game thread and evaluating thread-safe rules on workers
+	 * Issues are collected per chunk and merged in chunk order so results are deterministic
+	 */
+	static void ScanSelectionParallel(const TArray<FAssetData>& Selection, FAtlasScanCache* Cache, FIssueSink& Sink, FAtlasScanStats& Stats, FAtlasScanProfiler& Profiler, class FScopedSlowTask& Progress);
+
 	/** Asset classes that Atlas scans */
 	static const TArray<FName> ScannableAssetClasses;
 };
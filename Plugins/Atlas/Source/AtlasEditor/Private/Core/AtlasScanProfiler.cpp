@@ -0,0 +1,194 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasScanProfiler.h"
+#include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(AtlasChannel);
+
+// FAtlasTraceScope
+
+FAtlasTraceScope::FAtlasTraceScope(const TCHAR* Event, FName Name)
+	: bActive(false)
+{
+#if CPUPROFILERTRACE_ENABLED
+	bActive = UE_TRACE_CHANNELEXPR_IS_ENABLED(AtlasChannel | CpuChannel);
+	if (bActive)
+	{
+		TStringBuilder<128> EventName;
+		EventName << TEXT("Atlas ") << Event << TEXT(' ') << Name;
+		FCpuProfilerTrace::OutputBeginDynamicEvent(*EventName);
+	}
+#endif
+}
+
+FAtlasTraceScope::~FAtlasTraceScope()
+{
+#if CPUPROFILERTRACE_ENABLED
+	if (bActive)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+}
+
+// FAtlasLatencyHistogram
+
+FAtlasLatencyHistogram::FAtlasLatencyHistogram()
+	: NumSamples(0)
+	, TotalSeconds(0.0)
+	, MaxSeconds(0.0)
+{
+	FMemory::Memzero(Buckets);
+}
+
+int32 FAtlasLatencyHistogram::GetBucket(uint64 Nanoseconds)
+{
+	// Values below SubBuckets get a bucket each; above that, the leading bit picks the octave
+	// and the next three bits the sub-bucket
+	if (Nanoseconds < SubBuckets)
+	{
+		return static_cast<int32>(Nanoseconds);
+	}
+
+	const int32 Exponent = static_cast<int32>(FMath::FloorLog2_64(Nanoseconds));
+	const int32 SubBucket = static_cast<int32>((Nanoseconds >> (Exponent - 3)) & (SubBuckets - 1));
+	return FMath::Min((Exponent - 2) * SubBuckets + SubBucket, NumBuckets - 1);
+}
+
+double FAtlasLatencyHistogram::GetBucketMidpoint(int32 Bucket)
+{
+	if (Bucket < SubBuckets)
+	{
+		return Bucket * 1e-9;
+	}
+
+	const int32 Exponent = Bucket / SubBuckets + 2;
+	const double Width = static_cast<double>(1ull << (Exponent - 3));
+	const double Lower = (SubBuckets + Bucket % SubBuckets) * Width;
+	return (Lower + 0.5 * Width) * 1e-9;
+}
+
+void FAtlasLatencyHistogram::Add(double Seconds)
+{
+	const uint64 Nanoseconds = static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1e9);
+	++Buckets[GetBucket(Nanoseconds)];
+	++NumSamples;
+	TotalSeconds += Seconds;
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+double FAtlasLatencyHistogram::GetPercentile(double Fraction) const
+{
+	if (NumSamples == 0)
+	{
+		return 0.0;
+	}
+
+	const int64 Rank = FMath::Max<int64>(1, static_cast<int64>(FMath::CeilToDouble(Fraction * NumSamples)));
+	int64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Rank)
+		{
+			return FMath::Min(GetBucketMidpoint(Bucket), MaxSeconds);
+		}
+	}
+
+	return MaxSeconds;
+}
+
+// FAtlasScanProfiler
+
+FAtlasScanProfiler::FAtlasScanProfiler()
+	: LoadSeconds(0.0)
+{
+}
+
+void FAtlasScanProfiler::AddRuleCall(FName RuleName, double Seconds)
+{
+	RuleTimes.FindOrAdd(RuleName).Add(Seconds);
+}
+
+void FAtlasScanProfiler::AddAsset(const FAssetData& AssetData, double Seconds, double InLoadSeconds)
+{
+	LoadSeconds += InLoadSeconds;
+
+	const auto IsFaster = [](const FAssetTime& A, const FAssetTime& B)
+	{
+		return A.Seconds < B.Seconds;
+	};
+
+	if (SlowestAssets.Num() == NumSlowestAssets)
+	{
+		if (Seconds <= SlowestAssets.HeapTop().Seconds)
+		{
+			return;
+		}
+
+		FAssetTime Discarded;
+		SlowestAssets.HeapPop(Discarded, IsFaster, false);
+	}
+
+	SlowestAssets.HeapPush(FAssetTime{ AssetData.ObjectPath, Seconds, InLoadSeconds }, IsFaster);
+}
+
+void FAtlasScanProfiler::GetProfile(double ScanSeconds, FAtlasScanProfile& OutProfile) const
+{
+	OutProfile.ScanSeconds = ScanSeconds;
+	OutProfile.LoadSeconds = LoadSeconds;
+
+	OutProfile.Rules.Reset(RuleTimes.Num());
+	for (const TPair<FName, FAtlasLatencyHistogram>& Pair : RuleTimes)
+	{
+		FAtlasRuleProfile& Rule = OutProfile.Rules.AddDefaulted_GetRef();
+		Rule.RuleName = Pair.Key;
+		Rule.NumCalls = Pair.Value.Num();
+		Rule.TotalSeconds = Pair.Value.GetTotalSeconds();
+		Rule.P50Seconds = Pair.Value.GetPercentile(0.50);
+		Rule.P95Seconds = Pair.Value.GetPercentile(0.95);
+		Rule.P99Seconds = Pair.Value.GetPercentile(0.99);
+		Rule.MaxSeconds = Pair.Value.GetMaxSeconds();
+	}
+
+	OutProfile.Rules.Sort([](const FAtlasRuleProfile& A, const FAtlasRuleProfile& B)
+	{
+		return A.TotalSeconds != B.TotalSeconds ? A.TotalSeconds > B.TotalSeconds : A.RuleName.LexicalLess(B.RuleName);
+	});
+
+	TArray<FAssetTime> Assets = SlowestAssets;
+	Assets.Sort([](const FAssetTime& A, const FAssetTime& B)
+	{
+		return A.Seconds > B.Seconds;
+	});
+
+	OutProfile.SlowestAssets.Reset(Assets.Num());
+	for (const FAssetTime& Asset : Assets)
+	{
+		FAtlasAssetProfile& Profile = OutProfile.SlowestAssets.AddDefaulted_GetRef();
+		Profile.Path = Asset.ObjectPath.ToString();
+		Profile.Seconds = Asset.Seconds;
+		Profile.LoadSeconds = Asset.LoadSeconds;
+	}
+}
+
+void FAtlasScanProfiler::LogSummary(const FAtlasScanProfile& Profile, int32 MaxEntries)
+{
+	UE_LOG(LogAtlas, Display, TEXT("Atlas profile: scan %.2fs, loading %.2fs"), Profile.ScanSeconds, Profile.LoadSeconds);
+
+	for (int32 Index = 0; Index < FMath::Min(MaxEntries, Profile.Rules.Num()); ++Index)
+	{
+		const FAtlasRuleProfile& Rule = Profile.Rules[Index];
+		UE_LOG(LogAtlas, Display, TEXT("  %-32s %8.3fs %8d calls  p50 %8.3fms  p95 %8.3fms  p99 %8.3fms  max %8.3fms"),
+			*Rule.RuleName.ToString(), Rule.TotalSeconds, Rule.NumCalls,
+			Rule.P50Seconds * 1000.0, Rule.P95Seconds * 1000.0, Rule.P99Seconds * 1000.0, Rule.MaxSeconds * 1000.0);
+	}
+
+	for (int32 Index = 0; Index < FMath::Min(MaxEntries, Profile.SlowestAssets.Num()); ++Index)
+	{
+		const FAtlasAssetProfile& Asset = Profile.SlowestAssets[Index];
+		UE_LOG(LogAtlas, Display, TEXT("  %8.3fs (load %.3fs) %s"), Asset.Seconds, Asset.LoadSeconds, *Asset.Path);
+	}
+}
@@ -0,0 +1,118 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "Trace/Trace.h"
+
+struct FAssetData;
+
+/** Unreal Insights channel for Atlas scopes; enable with -trace=cpu,atlas */
+UE_TRACE_CHANNEL_EXTERN(AtlasChannel);
+
+/**
+ * CPU trace scope on the Atlas channel named "Atlas <Event> <Name>", e.g. "Atlas Validate TextureCompression"
+ * Nothing is formatted or sent unless the channel is enabled.
+ */
+class FAtlasTraceScope
+{
+public:
+	FAtlasTraceScope(const TCHAR* Event, FName Name);
+	~FAtlasTraceScope();
+
+private:
+	bool bActive;
+};
+
+/**
+ * Latency distribution with constant memory
+ * Buckets are log-scale with 8 sub-buckets per power of two nanoseconds, so a percentile is within
+ * about 6% of the exact value however many samples are added.
+ */
+class FAtlasLatencyHistogram
+{
+public:
+	FAtlasLatencyHistogram();
+
+	void Add(double Seconds);
+
+	/**
+	 * Estimate a percentile
+	 * @param Fraction 0.5 for the median, 0.99 for p99
+	 * @return Seconds, 0 if there are no samples
+	 */
+	double GetPercentile(double Fraction) const;
+
+	int32 Num() const { return NumSamples; }
+	double GetTotalSeconds() const { return TotalSeconds; }
+	double GetMaxSeconds() const { return MaxSeconds; }
+
+private:
+	static constexpr int32 SubBuckets = 8;
+	static constexpr int32 NumBuckets = 40 * SubBuckets;
+
+	static int32 GetBucket(uint64 Nanoseconds);
+	static double GetBucketMidpoint(int32 Bucket);
+
+	uint32 Buckets[NumBuckets];
+	int32 NumSamples;
+	double TotalSeconds;
+	double MaxSeconds;
+};
+
+/**
+ * Collects per-rule and per-asset timings of one scan
+ * Not thread-safe: parallel scans time each (asset, rule) pair into its own slot and the game thread
+ * adds them once the batch is done.
+ */
+class FAtlasScanProfiler
+{
+public:
+	/** Assets kept in FAtlasScanProfile::SlowestAssets */
+	static constexpr int32 NumSlowestAssets = 20;
+
+	FAtlasScanProfiler();
+
+	/**
+	 * Record one Validate or ValidateAssetData call
+	 */
+	void AddRuleCall(FName RuleName, double Seconds);
+
+	/**
+	 * Record the total time of one asset
+	 * @param AssetData The asset
+	 * @param Seconds Load plus every rule evaluated on it
+	 * @param LoadSeconds Time spent loading it, 0 if it was not loaded
+	 */
+	void AddAsset(const FAssetData& AssetData, double Seconds, double LoadSeconds);
+
+	/**
+	 * Build the profile of everything recorded so far
+	 * @param ScanSeconds Wall time of the scan
+	 * @param OutProfile Profile to fill
+	 */
+	void GetProfile(double ScanSeconds, FAtlasScanProfile& OutProfile) const;
+
+	/**
+	 * Log the most expensive rules and assets of a profile
+	 * @param Profile The profile to summarize
+	 * @param MaxEntries Rules and assets to list
+	 */
+	static void LogSummary(const FAtlasScanProfile& Profile, int32 MaxEntries = 10);
+
+private:
+	struct FAssetTime
+	{
+		FName ObjectPath;
+		double Seconds;
+		double LoadSeconds;
+	};
+
+	TMap<FName, FAtlasLatencyHistogram> RuleTimes;
+
+	/** Min-heap by Seconds, so the fastest of the slowest is replaced first */
+	TArray<FAssetTime> SlowestAssets;
+
+	double LoadSeconds;
+};
@@ -1,49 +1,61 @@
 // Copyright Atlas Team. All Rights Reserved.
 
 #include "AtlasTextureUtils.h"
+#include "AtlasMapTypeClassifier.h"
 #include "AtlasRuntime.h"
+#include "AtlasSettings.h"
 #include "Engine/Texture2D.h"
 #include "Engine/Texture.h"
+#include "Engine/TextureLODSettings.h"
+#include "DeviceProfiles/DeviceProfile.h"
+#include "DeviceProfiles/DeviceProfileManager.h"
+#include "AssetRegistry/AssetData.h"
 
-EAtlasMapType FAtlasTextureUtils::DetectMapTypeByName(const FString& Name)
+namespace AtlasTextureUtils
 {
-	FString LowerName = Name.ToLower();
+	/** Mips at or below this size stay resident even when the texture streams */
+	static constexpr int32 ResidentMipTailSize = 64;
 
-	// Check for common naming patterns
-	if (LowerName.Contains(TEXT("normal")) || LowerName.Contains(TEXT("_n")) || LowerName.EndsWith(TEXT("_n")))
-	{
-		return EAtlasMapType::Normal;
-	}
-	else if (LowerName.Contains(TEXT("basecolor")) || LowerName.Contains(TEXT("albedo")) || LowerName.Contains(TEXT("diffuse")) || LowerName.Contains(TEXT("_d")) || LowerName.Contains(TEXT("_bc")))
-	{
-		return EAtlasMapType::BaseColor;
-	}
-	else if (LowerName.Contains(TEXT("roughness")) || LowerName.Contains(TEXT("_r")))
-	{
-		return EAtlasMapType::Roughness;
-	}
-	else if (LowerName.Contains(TEXT("metallic")) || LowerName.Contains(TEXT("metalness")) || LowerName.Contains(TEXT("_m")))
-	{
-		return EAtlasMapType::Metalness;
-	}
-	else if (LowerName.Contains(TEXT("ao")) || LowerName.Contains(TEXT("ambient")) || LowerName.Contains(TEXT("occlusion")))
-	{
-		return EAtlasMapType::AO;
-	}
-	else if (LowerName.Contains(TEXT("height")) || LowerName.Contains(TEXT("displacement")) || LowerName.Contains(TEXT("_h")))
-	{
-		return EAtlasMapType::Height;
-	}
-	else if (LowerName.Contains(TEXT("emissive")) || LowerName.Contains(TEXT("emission")) || LowerName.Contains(TEXT("_e")))
+	/** Device profiles whose texture LOD groups stand in for each platform class */
+	static const TCHAR* DesktopProfileName = TEXT("Windows");
+	static const TCHAR* MobileProfileName = TEXT("Android");
+
+	static int64 GetMipBytes(int32 SizeX, int32 SizeY, EPixelFormat Format)
 	{
-		return EAtlasMapType::Emissive;
+		const FPixelFormatInfo& FormatInfo = GPixelFormats[Format];
+		if (FormatInfo.BlockSizeX <= 0 || FormatInfo.BlockSizeY <= 0)
+		{
+			return 0;
+		}
+
+		const int64 BlocksX = FMath::DivideAndRoundUp(SizeX, FormatInfo.BlockSizeX);
+		const int64 BlocksY = FMath::DivideAndRoundUp(SizeY, FormatInfo.BlockSizeY);
+		return BlocksX * BlocksY * FormatInfo.BlockBytes;
 	}
-	else if (LowerName.Contains(TEXT("opacity")) || LowerName.Contains(TEXT("alpha")) || LowerName.Contains(TEXT("_o")))
+
+	template <typename EnumType>
+	static bool GetEnumTagValue(const FAssetData& AssetData, FName TagName, uint8& OutValue)
 	{
-		return EAtlasMapType::Opacity;
+		FString ValueStr;
+		if (!AssetData.GetTagValue(TagName, ValueStr))
+		{
+			return false;
+		}
+
+		const int64 Value = StaticEnum<EnumType>()->GetValueByNameString(ValueStr);
+		if (Value == INDEX_NONE)
+		{
+			return false;
+		}
+
+		OutValue = static_cast<uint8>(Value);
+		return true;
 	}
+}
 
-	return EAtlasMapType::Unknown;
+EAtlasMapType FAtlasTextureUtils::DetectMapTypeByName(const FString& Name)
+{
+	return FAtlasMapTypeClassifier::Get().Classify(Name);
 }
 
 bool FAtlasTextureUtils::IsLikelyNormal(const UTexture2D* Texture)
@@ -53,18 +65,23 @@ bool FAtlasTextureUtils::IsLikelyNormal(const UTexture2D* Texture)
 		return false;
 	}
 
+	return IsLikelyNormal(static_cast<uint8>(Texture->CompressionSettings.GetValue()), Texture->SRGB, Texture->GetName());
+}
+
+bool FAtlasTextureUtils::IsLikelyNormal(uint8 Compression, bool bSRGB, const FString& Name)
+{
 	// Check compression settings
-	if (Texture->CompressionSettings == TextureCompressionSettings::TC_Normalmap ||
-		Texture->CompressionSettings == TextureCompressionSettings::TC_BC5)
+	if (Compression == TextureCompressionSettings::TC_Normalmap ||
+		Compression == TextureCompressionSettings::TC_BC5)
 	{
 		return true;
 	}
 
 	// Check if SRGB is disabled (normal maps should not use SRGB)
-	if (!Texture->SRGB)
+	if (!bSRGB)
 	{
 		// Additional heuristic: check name
-		EAtlasMapType DetectedType = DetectMapTypeByName(Texture->GetName());
+		EAtlasMapType DetectedType = DetectMapTypeByName(Name);
 		if (DetectedType == EAtlasMapType::Normal)
 		{
 			return true;
@@ -81,11 +98,207 @@ int64 FAtlasTextureUtils::EstimateVRAMBytes(const UTexture* Texture)
 		return 0;
 	}
 
-	// This is a rough estimation
-	// Actual VRAM usage depends on platform, compression, mipmaps, etc.
-	int64 EstimatedSize = Texture->CalcTextureMemorySizeEnum(TMC_ResidentMips);
+	if (const UTexture2D* Texture2D = Cast<UTexture2D>(Texture))
+	{
+		const EAtlasCostPlatform Platform = UAtlasSettings::Get()->CostModelPlatform;
+
+		FAtlasTextureCostParams Params;
+		GetCostParams(Texture2D, Params);
+		return EstimateCost(Params, Platform, GetLODSettings(Platform)).TotalBytes;
+	}
+
+	// Other texture types are not modeled; use the size of every mip rather than what is streamed in right now
+	return Texture->CalcTextureMemorySizeEnum(TMC_AllMips);
+}
+
+FAtlasTextureCost FAtlasTextureUtils::EstimateCost(const FAtlasTextureCostParams& Params, EAtlasCostPlatform Platform, const UTextureLODSettings* LODSettings)
+{
+	using namespace AtlasTextureUtils;
+
+	FAtlasTextureCost Cost;
+	Cost.PixelFormat = GetPlatformPixelFormat(Params.Compression, Params.bHasAlpha, Platform);
+
+	int32 SizeX = Params.SizeX;
+	int32 SizeY = Params.SizeY;
+	if (SizeX <= 0 || SizeY <= 0)
+	{
+		return Cost;
+	}
+
+	// MaxTextureSize downsizes the source before compression, so the larger mips never exist
+	while (Params.MaxTextureSize > 0 && FMath::Max(SizeX, SizeY) > Params.MaxTextureSize)
+	{
+		SizeX = FMath::Max(SizeX >> 1, 1);
+		SizeY = FMath::Max(SizeY >> 1, 1);
+	}
+
+	const int32 TopMipLog2 = FMath::CeilLogTwo(FMath::Max(SizeX, SizeY));
+	int32 NumMips = Params.bNoMipmaps ? 1 : FMath::FloorLog2(FMath::Max(SizeX, SizeY)) + 1;
+
+	// Same clamping as UTextureLODSettings::CalculateLODBias: group bias, then keep the top mip within the group's size range
+	int32 Bias = Params.LODBias;
+	bool bGroupStreams = true;
+	if (LODSettings && LODSettings->TextureLODGroups.IsValidIndex(Params.LODGroup))
+	{
+		const FTextureLODGroup& Group = LODSettings->TextureLODGroups[Params.LODGroup];
+		Bias += Group.LODBias;
+		if (Group.MaxLODSize > 0)
+		{
+			Bias = FMath::Max(Bias, TopMipLog2 - static_cast<int32>(FMath::CeilLogTwo(Group.MaxLODSize)));
+		}
+		if (Group.MinLODSize > 0)
+		{
+			Bias = FMath::Min(Bias, TopMipLog2 - static_cast<int32>(FMath::CeilLogTwo(Group.MinLODSize)));
+		}
+		bGroupStreams = Group.NumStreamedMips != 0;
+	}
+	Bias = FMath::Clamp(Bias, 0, NumMips - 1);
+
+	SizeX = FMath::Max(SizeX >> Bias, 1);
+	SizeY = FMath::Max(SizeY >> Bias, 1);
+	NumMips -= Bias;
+
+	Cost.SizeX = SizeX;
+	Cost.SizeY = SizeY;
+	Cost.NumMips = NumMips;
+
+	// Only power-of-two textures with mips stream
+	const bool bStreams = !Params.bNeverStream && bGroupStreams && NumMips > 1 && FMath::IsPowerOfTwo(SizeX) && FMath::IsPowerOfTwo(SizeY);
+
+	for (int32 Mip = 0; Mip < NumMips; ++Mip)
+	{
+		const int64 MipBytes = GetMipBytes(SizeX, SizeY, Cost.PixelFormat);
+		Cost.TotalBytes += MipBytes;
+
+		if (!bStreams || FMath::Max(SizeX, SizeY) <= ResidentMipTailSize)
+		{
+			Cost.ResidentBytes += MipBytes;
+		}
+
+		SizeX = FMath::Max(SizeX >> 1, 1);
+		SizeY = FMath::Max(SizeY >> 1, 1);
+	}
+
+	Cost.StreamedBytes = Cost.TotalBytes - Cost.ResidentBytes;
+	return Cost;
+}
+
+const UTextureLODSettings* FAtlasTextureUtils::GetLODSettings(EAtlasCostPlatform Platform)
+{
+	using namespace AtlasTextureUtils;
+
+	check(IsInGameThread());
+
+	const TCHAR* ProfileName = Platform == EAtlasCostPlatform::Mobile ? MobileProfileName : DesktopProfileName;
+	if (const UDeviceProfile* Profile = UDeviceProfileManager::Get().FindProfile(ProfileName, false))
+	{
+		return Profile->GetTextureLODSettings();
+	}
 
-	return EstimatedSize;
+	UE_LOG(LogAtlas, Warning, TEXT("Device profile '%s' not found, texture costs ignore LOD groups"), ProfileName);
+	return nullptr;
+}
+
+EPixelFormat FAtlasTextureUtils::GetPlatformPixelFormat(uint8 Compression, bool bHasAlpha, EAtlasCostPlatform Platform)
+{
+	const bool bMobile = Platform == EAtlasCostPlatform::Mobile;
+
+	switch (Compression)
+	{
+	case TextureCompressionSettings::TC_Default:
+	case TextureCompressionSettings::TC_Masks:
+		return bMobile ? PF_ASTC_6x6 : (bHasAlpha ? PF_DXT5 : PF_DXT1);
+
+	case TextureCompressionSettings::TC_Normalmap:
+		return bMobile ? PF_ASTC_6x6 : PF_BC5;
+
+	case TextureCompressionSettings::TC_BC7:
+		return bMobile ? PF_ASTC_6x6 : PF_BC7;
+
+	case TextureCompressionSettings::TC_Alpha:
+		return bMobile ? PF_G8 : PF_BC4;
+
+	case TextureCompressionSettings::TC_HDR_Compressed:
+		return bMobile ? PF_FloatRGBA : PF_BC6H;
+
+	case TextureCompressionSettings::TC_Grayscale:
+	case TextureCompressionSettings::TC_Displacementmap:
+	case TextureCompressionSettings::TC_DistanceFieldFont:
+		return PF_G8;
+
+	case TextureCompressionSettings::TC_HDR:
+		return PF_FloatRGBA;
+
+	case TextureCompressionSettings::TC_HalfFloat:
+		return PF_R16F;
+
+	default:
+		return PF_B8G8R8A8;
+	}
+}
+
+void FAtlasTextureUtils::GetCostParams(const UTexture2D* Texture, FAtlasTextureCostParams& OutParams)
+{
+	if (!Texture)
+	{
+		return;
+	}
+
+	// Source size, not the platform data of the running editor, which already has MaxTextureSize applied
+	if (Texture->Source.IsValid())
+	{
+		OutParams.SizeX = Texture->Source.GetSizeX();
+		OutParams.SizeY = Texture->Source.GetSizeY();
+	}
+	else
+	{
+		OutParams.SizeX = Texture->GetSizeX();
+		OutParams.SizeY = Texture->GetSizeY();
+	}
+
+	OutParams.Compression = static_cast<uint8>(Texture->CompressionSettings.GetValue());
+	OutParams.LODGroup = static_cast<uint8>(Texture->LODGroup.GetValue());
+	OutParams.LODBias = Texture->LODBias;
+	OutParams.MaxTextureSize = Texture->MaxTextureSize;
+	OutParams.bHasAlpha = Texture->HasAlphaChannel();
+	OutParams.bNeverStream = Texture->NeverStream;
+	OutParams.bNoMipmaps = Texture->MipGenSettings == TMGS_NoMipmaps;
+}
+
+bool FAtlasTextureUtils::GetCostParamsFromTags(const FAssetData& AssetData, FAtlasTextureCostParams& OutParams)
+{
+	using namespace AtlasTextureUtils;
+
+	FIntPoint Dimensions;
+	if (!GetDimensionsFromTags(AssetData, Dimensions) || !GetCompressionFromTags(AssetData, OutParams.Compression))
+	{
+		return false;
+	}
+
+	OutParams.SizeX = Dimensions.X;
+	OutParams.SizeY = Dimensions.Y;
+
+	GetEnumTagValue<TextureGroup>(AssetData, GET_MEMBER_NAME_CHECKED(UTexture, LODGroup), OutParams.LODGroup);
+	AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture, LODBias), OutParams.LODBias);
+	AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture, MaxTextureSize), OutParams.MaxTextureSize);
+
+	FString BoolStr;
+	if (AssetData.GetTagValue(TEXT("HasAlphaChannel"), BoolStr))
+	{
+		OutParams.bHasAlpha = BoolStr.ToBool();
+	}
+	if (AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture, NeverStream), BoolStr))
+	{
+		OutParams.bNeverStream = BoolStr.ToBool();
+	}
+
+	uint8 MipGenSettings = 0;
+	if (GetEnumTagValue<TextureMipGenSettings>(AssetData, GET_MEMBER_NAME_CHECKED(UTexture, MipGenSettings), MipGenSettings))
+	{
+		OutParams.bNoMipmaps = MipGenSettings == TMGS_NoMipmaps;
+	}
+
+	return true;
 }
 
 int32 FAtlasTextureUtils::GetMaxDimension(const UTexture2D* Texture)
@@ -108,16 +321,21 @@ bool FAtlasTextureUtils::HasCorrectCompression(const UTexture2D* Texture, EAtlas
 		return false;
 	}
 
+	return HasCorrectCompression(static_cast<uint8>(Texture->CompressionSettings.GetValue()), MapType);
+}
+
+bool FAtlasTextureUtils::HasCorrectCompression(uint8 Compression, EAtlasMapType MapType)
+{
 	switch (MapType)
 	{
 	case EAtlasMapType::Normal:
-		return Texture->CompressionSettings == TextureCompressionSettings::TC_Normalmap ||
-			   Texture->CompressionSettings == TextureCompressionSettings::TC_BC5;
+		return Compression == TextureCompressionSettings::TC_Normalmap ||
+			   Compression == TextureCompressionSettings::TC_BC5;
 
 	case EAtlasMapType::BaseColor:
 	case EAtlasMapType::Emissive:
-		return Texture->CompressionSettings == TextureCompressionSettings::TC_Default ||
-			   Texture->CompressionSettings == TextureCompressionSettings::TC_BC7;
+		return Compression == TextureCompressionSettings::TC_Default ||
+			   Compression == TextureCompressionSettings::TC_BC7;
 
 	case EAtlasMapType::Roughness:
 	case EAtlasMapType::Metalness:
@@ -162,3 +380,43 @@ FString FAtlasTextureUtils::GetPixelFormatName(const UTexture* Texture)
 	EPixelFormat Format = Texture->GetPixelFormat();
 	return GetPixelFormatString(Format);
 }
+
+bool FAtlasTextureUtils::GetDimensionsFromTags(const FAssetData& AssetData, FIntPoint& OutDimensions)
+{
+	// UTexture2D registers its size as "<Width>x<Height>"
+	FString DimensionsStr;
+	if (!AssetData.GetTagValue(TEXT("Dimensions"), DimensionsStr))
+	{
+		return false;
+	}
+
+	FString WidthStr;
+	FString HeightStr;
+	if (!DimensionsStr.Split(TEXT("x"), &WidthStr, &HeightStr))
+	{
+		return false;
+	}
+
+	OutDimensions.X = FCString::Atoi(*WidthStr);
+	OutDimensions.Y = FCString::Atoi(*HeightStr);
+	return OutDimensions.X > 0 && OutDimensions.Y > 0;
+}
+
+bool FAtlasTextureUtils::GetCompressionFromTags(const FAssetData& AssetData, uint8& OutCompression)
+{
+	using namespace AtlasTextureUtils;
+
+	return GetEnumTagValue<TextureCompressionSettings>(AssetData, GET_MEMBER_NAME_CHECKED(UTexture, CompressionSettings), OutCompression);
+}
+
+bool FAtlasTextureUtils::GetSRGBFromTags(const FAssetData& AssetData, bool& bOutSRGB)
+{
+	FString SRGBStr;
+	if (!AssetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UTexture, SRGB), SRGBStr))
+	{
+		return false;
+	}
+
+	bOutSRGB = SRGBStr.ToBool();
+	return true;
+}
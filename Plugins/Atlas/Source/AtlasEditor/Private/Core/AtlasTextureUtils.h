@@ -7,15 +7,90 @@
 
 class UTexture2D;
 class UTexture;
+class UTextureLODSettings;
+struct FAssetData;
+
+/**
+ * Texture properties that determine its VRAM cost, readable from asset registry tags or a loaded texture
+ */
+struct FAtlasTextureCostParams
+{
+	/** Source dimensions */
+	int32 SizeX;
+	int32 SizeY;
+
+	/** TextureCompressionSettings enum value */
+	uint8 Compression;
+
+	/** TextureGroup enum value */
+	uint8 LODGroup;
+
+	/** Per-texture LOD bias */
+	int32 LODBias;
+
+	/** Per-texture maximum size, 0 for none */
+	int32 MaxTextureSize;
+
+	bool bHasAlpha;
+	bool bNeverStream;
+	bool bNoMipmaps;
+
+	FAtlasTextureCostParams()
+		: SizeX(0)
+		, SizeY(0)
+		, Compression(0)
+		, LODGroup(0)
+		, LODBias(0)
+		, MaxTextureSize(0)
+		, bHasAlpha(false)
+		, bNeverStream(false)
+		, bNoMipmaps(false)
+	{
+	}
+};
+
+/**
+ * Deterministic VRAM cost of a texture on a target platform
+ */
+struct FAtlasTextureCost
+{
+	/** Format the texture is compressed to on the platform */
+	EPixelFormat PixelFormat;
+
+	/** Top mip after MaxTextureSize and LOD bias */
+	int32 SizeX;
+	int32 SizeY;
+	int32 NumMips;
+
+	/** Bytes of every mip from the top mip down */
+	int64 TotalBytes;
+
+	/** Bytes always in memory: the whole texture if it does not stream, its mip tail otherwise */
+	int64 ResidentBytes;
+
+	/** Bytes that come and go through the streaming pool */
+	int64 StreamedBytes;
+
+	FAtlasTextureCost()
+		: PixelFormat(PF_Unknown)
+		, SizeX(0)
+		, SizeY(0)
+		, NumMips(0)
+		, TotalBytes(0)
+		, ResidentBytes(0)
+		, StreamedBytes(0)
+	{
+	}
+};
 
 /**
  * Utility functions for texture operations
  */
-class FAtlasTextureUtils
+class ATLASEDITOR_API FAtlasTextureUtils
 {
 public:
 	/**
-	 * Detect texture map type based on filename
+	 * Detect texture map type based on filename, using FAtlasMapTypeClassifier
 	 * @param Name The texture name or filename
 	 * @return The detected map type
 	 */
@@ -28,13 +103,68 @@ public:
 	 */
 	static bool IsLikelyNormal(const UTexture2D* Texture);
 
+	/**
+	 * Check if a set of texture settings is likely that of a normal map
+	 * @param Compression The texture's compression settings enum value
+	 * @param bSRGB Whether the texture is sampled as sRGB
+	 * @param Name The texture name
+	 * @return True if likely a normal map
+	 */
+	static bool IsLikelyNormal(uint8 Compression, bool bSRGB, const FString& Name);
+
 	/**
 	 * Estimate VRAM usage for a texture
+	 * 2D textures use the cost model for UAtlasSettings::CostModelPlatform, so the result does not
+	 * depend on what is currently streamed in.
 	 * @param Texture The texture to analyze
 	 * @return Estimated VRAM bytes
 	 */
 	static int64 EstimateVRAMBytes(const UTexture* Texture);
 
+	/**
+	 * Compute the VRAM cost of a texture on a platform
+	 * Applies MaxTextureSize, the per-texture and LOD group bias, the group's size limits, and the full
+	 * mip chain in the platform's pixel format. Safe to call from worker threads.
+	 * @param Params Texture properties
+	 * @param Platform Target platform class
+	 * @param LODSettings Texture LOD groups of the platform (see GetLODSettings); null ignores groups
+	 * @return The cost breakdown
+	 */
+	static FAtlasTextureCost EstimateCost(const FAtlasTextureCostParams& Params, EAtlasCostPlatform Platform, const UTextureLODSettings* LODSettings);
+
+	/**
+	 * Get the texture LOD groups of the device profile representing a platform class
+	 * Must be called on the game thread.
+	 * @param Platform Target platform class
+	 * @return LOD settings, or null if the device profile is missing
+	 */
+	static const UTextureLODSettings* GetLODSettings(EAtlasCostPlatform Platform);
+
+	/**
+	 * Get the pixel format a compression setting produces on a platform
+	 * @param Compression The compression settings enum value
+	 * @param bHasAlpha Whether the source has an alpha channel
+	 * @param Platform Target platform class
+	 * @return The pixel format
+	 */
+	static EPixelFormat GetPlatformPixelFormat(uint8 Compression, bool bHasAlpha, EAtlasCostPlatform Platform);
+
+	/**
+	 * Read cost model inputs from a loaded texture
+	 * @param Texture The texture
+	 * @param OutParams Parameters to fill
+	 */
+	static void GetCostParams(const UTexture2D* Texture, FAtlasTextureCostParams& OutParams);
+
+	/**
+	 * Read cost model inputs from asset registry tags
+	 * Dimensions and compression are required; properties without a tag keep their defaults.
+	 * @param AssetData The texture's asset registry entry
+	 * @param OutParams Parameters to fill
+	 * @return True if the required tags were present
+	 */
+	static bool GetCostParamsFromTags(const FAssetData& AssetData, FAtlasTextureCostParams& OutParams);
+
 	/**
 	 * Get the maximum dimension (width or height) of a texture
 	 * @param Texture The texture to measure
@@ -50,6 +180,14 @@ public:
 	 */
 	static bool HasCorrectCompression(const UTexture2D* Texture, EAtlasMapType MapType);
 
+	/**
+	 * Check if a compression setting is appropriate for a map type
+	 * @param Compression The compression settings enum value
+	 * @param MapType The texture's map type
+	 * @return True if compression is appropriate
+	 */
+	static bool HasCorrectCompression(uint8 Compression, EAtlasMapType MapType);
+
 	/**
 	 * Get the recommended compression settings for a texture map type
 	 * @param MapType The texture's map type
@@ -63,4 +201,29 @@ public:
 	 * @return Pixel format name
 	 */
 	static FString GetPixelFormatName(const UTexture* Texture);
+
+	/**
+	 * Read the texture dimensions from asset registry tags
+	 * @param AssetData The texture's asset registry entry
+	 * @param OutDimensions Width and height of the texture
+	 * @return True if the tag was present
+	 */
+	static bool GetDimensionsFromTags(const FAssetData& AssetData, FIntPoint& OutDimensions);
+
+	/**
+	 * Read the compression settings from asset registry tags
+	 * @param AssetData The texture's asset registry entry
+	 * @param OutCompression Compression settings enum value
+	 * @return True if the tag was present and valid
+	 */
+	static bool GetCompressionFromTags(const FAssetData& AssetData, uint8& OutCompression);
+
+	/**
+	 * Read the sRGB flag from asset registry tags
+	 * @param AssetData The texture's asset registry entry
+	 * @param bOutSRGB Whether the texture is sampled as sRGB
+	 * @return True if the tag was present
+	 */
+	static bool GetSRGBFromTags(const FAssetData& AssetData, bool& bOutSRGB);
+
 };
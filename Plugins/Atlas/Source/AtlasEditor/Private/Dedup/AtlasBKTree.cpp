@@ -0,0 +1,67 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBKTree.h"
+
+void FAtlasBKTree::Add(uint64 Hash, int32 Value)
+{
+	const int32 NewIndex = Nodes.Num();
+
+	int32 NodeIndex = 0;
+	while (NodeIndex < Nodes.Num())
+	{
+		const int32 NodeDistance = Distance(Nodes[NodeIndex].Hash, Hash);
+
+		int32 ChildIndex = INDEX_NONE;
+		for (const TPair<int32, int32>& Child : Nodes[NodeIndex].Children)
+		{
+			if (Child.Key == NodeDistance)
+			{
+				ChildIndex = Child.Value;
+				break;
+			}
+		}
+
+		if (ChildIndex == INDEX_NONE)
+		{
+			Nodes[NodeIndex].Children.Emplace(NodeDistance, NewIndex);
+			break;
+		}
+
+		NodeIndex = ChildIndex;
+	}
+
+	FNode& Node = Nodes.AddDefaulted_GetRef();
+	Node.Hash = Hash;
+	Node.Value = Value;
+}
+
+void FAtlasBKTree::Query(uint64 Hash, int32 MaxDistance, TArray<TPair<int32, int32>>& OutMatches) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Pending;
+	Pending.Add(0);
+
+	while (Pending.Num() > 0)
+	{
+		const FNode& Node = Nodes[Pending.Pop(false)];
+		const int32 NodeDistance = Distance(Node.Hash, Hash);
+
+		if (NodeDistance <= MaxDistance)
+		{
+			OutMatches.Emplace(Node.Value, NodeDistance);
+		}
+
+		// Triangle inequality: only subtrees at distance within MaxDistance of NodeDistance can match
+		for (const TPair<int32, int32>& Child : Node.Children)
+		{
+			if (FMath::Abs(Child.Key - NodeDistance) <= MaxDistance)
+			{
+				Pending.Add(Child.Value);
+			}
+		}
+	}
+}
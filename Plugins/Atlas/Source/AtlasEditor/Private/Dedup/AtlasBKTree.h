@@ -0,0 +1,49 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * BK-tree over 64-bit hashes with Hamming distance
+ * Finds every hash within a distance of a query without comparing against all stored hashes.
+ */
+class FAtlasBKTree
+{
+public:
+	/**
+	 * Add a hash
+	 * @param Hash The hash to store
+	 * @param Value Caller-defined value returned by queries, e.g. an asset index
+	 */
+	void Add(uint64 Hash, int32 Value);
+
+	/**
+	 * Find every stored hash within a Hamming distance of a query
+	 * @param Hash The query hash
+	 * @param MaxDistance Maximum number of differing bits
+	 * @param OutMatches Values and distances of the matches
+	 */
+	void Query(uint64 Hash, int32 MaxDistance, TArray<TPair<int32, int32>>& OutMatches) const;
+
+	/** Number of stored hashes */
+	int32 Num() const { return Nodes.Num(); }
+
+	/** Number of differing bits between two hashes */
+	static int32 Distance(uint64 A, uint64 B)
+	{
+		return static_cast<int32>(FMath::CountBits(A ^ B));
+	}
+
+private:
+	struct FNode
+	{
+		uint64 Hash;
+		int32 Value;
+
+		/** Distance to this node and node index of each child; distances are unique per node */
+		TArray<TPair<int32, int32>, TInlineAllocator<4>> Children;
+	};
+
+	TArray<FNode> Nodes;
+};
@@ -0,0 +1,707 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasDedupEngine.h"
+#include "AtlasBKTree.h"
+#include "AtlasPerceptualHash.h"
+#include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasMeshUtils.h"
+#include "Core/AtlasTextureUtils.h"
+#include "Overview/AtlasOverviewStats.h"
+#include "AtlasRuntime.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "MeshDescription.h"
+#include "Misc/PackageName.h"
+#include "StaticMeshAttributes.h"
+
+namespace AtlasDedupEngine
+{
+	/** Source bytes extracted before the batch is handed to the hashing workers */
+	static constexpr int64 BatchBytes = 256ll * 1024 * 1024;
+
+	/** Type tags hashed ahead of the content, so a texture and a mesh never share a hash */
+	static constexpr uint8 TextureTag = 'T';
+	static constexpr uint8 MeshTag = 'M';
+
+	/** Source content of one asset, extracted on the game thread */
+	struct FPayload
+	{
+		int32 AssetIndex;
+
+		/** Type tag, format and settings */
+		TArray<uint8> Header;
+
+		/** Raw content */
+		TArray64<uint8> Data;
+
+		int64 GetSize() const { return Header.Num() + Data.Num(); }
+	};
+
+	/** Smallest useful source mip of a texture, fingerprinted on a worker */
+	struct FMipPayload
+	{
+		int32 AssetIndex;
+		int32 SizeX;
+		int32 SizeY;
+		ETextureSourceFormat Format;
+		TArray64<uint8> Data;
+
+		int64 GetSize() const { return Data.Num(); }
+	};
+
+	/**
+	 * Extract a payload from every candidate on the game thread and process the payloads on worker threads
+	 * Processing one batch overlaps with extracting the next, so at most two batches of source data are
+	 * alive at once. Assets loaded for extraction are released by garbage collection between batches.
+	 * @param Extract Fills a payload from a loaded asset; the payload's AssetIndex is already set
+	 * @param Process Consumes one payload; called concurrently for different payloads
+	 * @param bCollectGarbage Release loaded assets between batches; off when the caller may hold object pointers
+	 */
+	template <typename PayloadType>
+	static void ProcessInBatches(const TArray<FAssetData>& Assets, const TArray<int32>& Candidates, TFunctionRef<bool(UObject*, PayloadType&)> Extract, TFunctionRef<void(const PayloadType&)> Process, FAtlasDedupStats& Stats, bool bCollectGarbage)
+	{
+		TArray<PayloadType> Batch;
+		int64 BatchSize = 0;
+		bool bLoadedSinceCollect = false;
+		TFuture<void> PendingBatch;
+
+		const auto FlushBatch = [&]()
+		{
+			if (PendingBatch.IsValid())
+			{
+				PendingBatch.Wait();
+			}
+
+			// Payloads are plain bytes, so assets loaded for them can go now
+			if (bLoadedSinceCollect && bCollectGarbage)
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+				bLoadedSinceCollect = false;
+			}
+
+			PendingBatch = Async(EAsyncExecution::TaskGraph, [Payloads = MoveTemp(Batch), &Process]()
+			{
+				ParallelFor(Payloads.Num(), [&Payloads, &Process](int32 Index)
+				{
+					Process(Payloads[Index]);
+				});
+			});
+
+			Batch.Reset();
+			BatchSize = 0;
+		};
+
+		for (const int32 AssetIndex : Candidates)
+		{
+			const FAssetData& AssetData = Assets[AssetIndex];
+
+			if (!AssetData.IsAssetLoaded())
+			{
+				++Stats.NumLoaded;
+				bLoadedSinceCollect = true;
+			}
+
+			UObject* Asset = AssetData.GetAsset();
+			if (!Asset)
+			{
+				continue;
+			}
+
+			PayloadType Payload;
+			Payload.AssetIndex = AssetIndex;
+			if (!Extract(Asset, Payload))
+			{
+				UE_LOG(LogAtlas, Verbose, TEXT("No source data to hash for %s"), *AssetData.ObjectPath.ToString());
+				continue;
+			}
+
+			++Stats.NumHashed;
+			Stats.HashedBytes += Payload.GetSize();
+			BatchSize += Payload.GetSize();
+			Batch.Add(MoveTemp(Payload));
+
+			if (BatchSize >= BatchBytes)
+			{
+				FlushBatch();
+			}
+		}
+
+		if (Batch.Num() > 0 || bLoadedSinceCollect)
+		{
+			FlushBatch();
+		}
+
+		if (PendingBatch.IsValid())
+		{
+			PendingBatch.Wait();
+		}
+	}
+
+	template <typename ValueType>
+	static void Append(TArray<uint8>& Data, const ValueType& Value)
+	{
+		Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(ValueType));
+	}
+
+	template <typename ValueType>
+	static void Append(TArray64<uint8>& Data, const ValueType& Value)
+	{
+		Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(ValueType));
+	}
+
+	/** Registry tags identical assets must share; empty if a tag is missing */
+	static FString GetPrefilterKey(const FAssetData& AssetData, bool bIsTexture)
+	{
+		if (bIsTexture)
+		{
+			FAtlasTextureCostParams Params;
+			if (!FAtlasTextureUtils::GetCostParamsFromTags(AssetData, Params))
+			{
+				return FString();
+			}
+
+			return FString::Printf(TEXT("T%dx%d:%d"), Params.SizeX, Params.SizeY, Params.Compression);
+		}
+
+		int64 Triangles = 0;
+		int32 Vertices = 0;
+		if (!FAtlasMeshUtils::GetTriangleCountFromTags(AssetData, Triangles) || !AssetData.GetTagValue(TEXT("Vertices"), Vertices))
+		{
+			return FString();
+		}
+
+		return FString::Printf(TEXT("M%lld:%d"), Triangles, Vertices);
+	}
+
+	/** Top source mip, with the settings that change the cooked texture as part of its identity */
+	static bool ExtractTexture(UTexture2D* Texture, FPayload& OutPayload)
+	{
+		FTextureSource& Source = Texture->Source;
+		if (!Source.IsValid() || !Source.GetMipData(OutPayload.Data, 0, 0, 0))
+		{
+			return false;
+		}
+
+		Append(OutPayload.Header, TextureTag);
+		Append(OutPayload.Header, static_cast<int32>(Source.GetFormat()));
+		Append(OutPayload.Header, Source.GetSizeX());
+		Append(OutPayload.Header, Source.GetSizeY());
+		Append(OutPayload.Header, static_cast<uint8>(Texture->CompressionSettings.GetValue()));
+		Append(OutPayload.Header, static_cast<uint8>(Texture->SRGB));
+		return true;
+	}
+
+	/** Vertex positions and triangle vertex indices of the LOD 0 mesh description */
+	static bool ExtractMesh(UStaticMesh* Mesh, FPayload& OutPayload)
+	{
+		const FMeshDescription* MeshDescription = Mesh->GetMeshDescription(0);
+		if (!MeshDescription)
+		{
+			return false;
+		}
+
+		const int32 NumVertices = MeshDescription->Vertices().Num();
+		const int32 NumTriangles = MeshDescription->Triangles().Num();
+
+		Append(OutPayload.Header, MeshTag);
+		Append(OutPayload.Header, NumVertices);
+		Append(OutPayload.Header, NumTriangles);
+
+		OutPayload.Data.Reserve(static_cast<int64>(NumVertices) * sizeof(FVector3f) + static_cast<int64>(NumTriangles) * 3 * sizeof(int32));
+
+		FStaticMeshConstAttributes Attributes(*MeshDescription);
+		TVertexAttributesConstRef<FVector3f> Positions = Attributes.GetVertexPositions();
+		for (const FVertexID VertexID : MeshDescription->Vertices().GetElementIDs())
+		{
+			Append(OutPayload.Data, Positions[VertexID]);
+		}
+
+		for (const FTriangleID TriangleID : MeshDescription->Triangles().GetElementIDs())
+		{
+			for (const FVertexInstanceID VertexInstanceID : MeshDescription->GetTriangleVertexInstances(TriangleID))
+			{
+				Append(OutPayload.Data, MeshDescription->GetVertexInstanceVertex(VertexInstanceID).GetValue());
+			}
+		}
+
+		return true;
+	}
+
+	/** The source mip FAtlasPerceptualHash fingerprints */
+	static bool ExtractMip(UTexture2D* Texture, FMipPayload& OutPayload)
+	{
+		FTextureSource& Source = Texture->Source;
+		if (!Source.IsValid())
+		{
+			return false;
+		}
+
+		const int32 MipIndex = FAtlasPerceptualHash::GetSourceMipIndex(Texture);
+		OutPayload.SizeX = FMath::Max(Source.GetSizeX() >> MipIndex, 1);
+		OutPayload.SizeY = FMath::Max(Source.GetSizeY() >> MipIndex, 1);
+		OutPayload.Format = Source.GetFormat();
+		return Source.GetMipData(OutPayload.Data, 0, 0, MipIndex);
+	}
+
+	static FString GetShortName(FName ObjectPath)
+	{
+		return FPackageName::ObjectPathToObjectName(ObjectPath.ToString());
+	}
+}
+
+void FAtlasDedupEngine::FindDuplicatesAll(TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add("/Game");
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	Filter.ClassNames.Add(UTexture2D::StaticClass()->GetFName());
+	Filter.ClassNames.Add(UStaticMesh::StaticClass()->GetFName());
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	FindDuplicates(Assets, OutGroups, OutStats);
+}
+
+void FAtlasDedupEngine::FindDuplicates(const TArray<FAssetData>& Assets, TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats)
+{
+	FindDuplicatesInternal(Assets, OutGroups, OutStats, true);
+}
+
+bool FAtlasDedupEngine::FindDuplicatesOf(const FAssetData& AssetData, FAtlasDuplicateGroup& OutGroup)
+{
+	using namespace AtlasDedupEngine;
+
+	const bool bIsTexture = AssetData.AssetClass == UTexture2D::StaticClass()->GetFName();
+	if (!bIsTexture && AssetData.AssetClass != UStaticMesh::StaticClass()->GetFName())
+	{
+		return false;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add("/Game");
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	Filter.ClassNames.Add(AssetData.AssetClass);
+
+	TArray<FAssetData> ClassAssets;
+	AssetRegistry.GetAssets(Filter, ClassAssets);
+
+	// Identical assets share the registry key or are untagged, so the rest of the class cannot change the group
+	const FString Key = GetPrefilterKey(AssetData, bIsTexture);
+	TArray<FAssetData> Candidates;
+	for (FAssetData& Other : ClassAssets)
+	{
+		const FString OtherKey = Key.IsEmpty() ? FString() : GetPrefilterKey(Other, bIsTexture);
+		if (OtherKey.IsEmpty() || OtherKey == Key)
+		{
+			Candidates.Add(MoveTemp(Other));
+		}
+	}
+
+	TArray<FAtlasDuplicateGroup> Groups;
+	FindDuplicatesInternal(Candidates, Groups, nullptr, false);
+
+	for (FAtlasDuplicateGroup& Group : Groups)
+	{
+		if (Group.AssetPaths.Contains(AssetData.ObjectPath))
+		{
+			OutGroup = MoveTemp(Group);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FAtlasDedupEngine::FindDuplicatesInternal(const TArray<FAssetData>& Assets, TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats, bool bCollectGarbage)
+{
+	using namespace AtlasDedupEngine;
+
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FAtlasDedupStats Stats;
+	OutGroups.Reset();
+
+	const FName TextureClassName = UTexture2D::StaticClass()->GetFName();
+	const FName MeshClassName = UStaticMesh::StaticClass()->GetFName();
+
+	// Only assets whose registry tags collide with another asset's can be duplicates. A class with
+	// untagged assets is hashed in full, since an untagged asset may match any tagged one.
+	TArray<int32> Supported;
+	TArray<FString> Keys;
+	TMap<FString, int32> KeyCounts;
+	bool bUntaggedTextures = false;
+	bool bUntaggedMeshes = false;
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = Assets[AssetIndex];
+		const bool bIsTexture = AssetData.AssetClass == TextureClassName;
+		if (!bIsTexture && AssetData.AssetClass != MeshClassName)
+		{
+			continue;
+		}
+
+		Supported.Add(AssetIndex);
+		FString& Key = Keys.Add_GetRef(GetPrefilterKey(AssetData, bIsTexture));
+		if (Key.IsEmpty())
+		{
+			(bIsTexture ? bUntaggedTextures : bUntaggedMeshes) = true;
+		}
+		else
+		{
+			++KeyCounts.FindOrAdd(Key);
+		}
+	}
+
+	Stats.NumAssets = Supported.Num();
+
+	TArray<int32> Candidates;
+	for (int32 Index = 0; Index < Supported.Num(); ++Index)
+	{
+		const bool bIsTexture = Assets[Supported[Index]].AssetClass == TextureClassName;
+		if ((bIsTexture ? bUntaggedTextures : bUntaggedMeshes) || KeyCounts.FindRef(Keys[Index]) > 1)
+		{
+			Candidates.Add(Supported[Index]);
+		}
+	}
+
+	TArray<FBlake3Hash> Hashes;
+	Hashes.SetNum(Assets.Num());
+	TArray<bool> Hashed;
+	Hashed.SetNumZeroed(Assets.Num());
+	TArray<int64> VRAMBytes;
+	VRAMBytes.SetNumZeroed(Assets.Num());
+
+	ProcessInBatches<FPayload>(Assets, Candidates,
+		[&VRAMBytes](UObject* Asset, FPayload& Payload)
+		{
+			if (UTexture2D* Texture = Cast<UTexture2D>(Asset))
+			{
+				VRAMBytes[Payload.AssetIndex] = FAtlasTextureUtils::EstimateVRAMBytes(Texture);
+				return ExtractTexture(Texture, Payload);
+			}
+
+			if (UStaticMesh* Mesh = Cast<UStaticMesh>(Asset))
+			{
+				return ExtractMesh(Mesh, Payload);
+			}
+
+			return false;
+		},
+		[&Hashes, &Hashed](const FPayload& Payload)
+		{
+			FBlake3 Hasher;
+			Hasher.Update(Payload.Header.GetData(), Payload.Header.Num());
+			Hasher.Update(Payload.Data.GetData(), Payload.Data.Num());
+			Hashes[Payload.AssetIndex] = Hasher.Finalize();
+			Hashed[Payload.AssetIndex] = true;
+		},
+		Stats, bCollectGarbage);
+
+	// Group by hash in candidate order, so group contents are deterministic
+	TMap<FBlake3Hash, int32> GroupIndices;
+	TArray<TArray<int32>> Members;
+	for (const int32 AssetIndex : Candidates)
+	{
+		if (!Hashed[AssetIndex])
+		{
+			continue;
+		}
+
+		if (const int32* GroupIndex = GroupIndices.Find(Hashes[AssetIndex]))
+		{
+			Members[*GroupIndex].Add(AssetIndex);
+		}
+		else
+		{
+			GroupIndices.Add(Hashes[AssetIndex], Members.Num());
+			Members.AddDefaulted_GetRef().Add(AssetIndex);
+		}
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FName> Referencers;
+
+	for (TArray<int32>& Group : Members)
+	{
+		if (Group.Num() < 2)
+		{
+			continue;
+		}
+
+		// Keep the most referenced asset so consolidation rewrites the fewest packages
+		TMap<int32, int32> NumReferencers;
+		for (const int32 AssetIndex : Group)
+		{
+			Referencers.Reset();
+			AssetRegistry.GetReferencers(Assets[AssetIndex].PackageName, Referencers);
+			NumReferencers.Add(AssetIndex, Referencers.Num());
+		}
+
+		Group.Sort([&Assets, &NumReferencers](int32 A, int32 B)
+		{
+			const int32 RefsA = NumReferencers[A];
+			const int32 RefsB = NumReferencers[B];
+			return RefsA != RefsB ? RefsA > RefsB : Assets[A].ObjectPath.LexicalLess(Assets[B].ObjectPath);
+		});
+
+		FAtlasDuplicateGroup& OutGroup = OutGroups.AddDefaulted_GetRef();
+		OutGroup.Hash = Hashes[Group[0]];
+		OutGroup.AssetClass = Assets[Group[0]].AssetClass;
+
+		for (int32 MemberIndex = 0; MemberIndex < Group.Num(); ++MemberIndex)
+		{
+			const FAssetData& AssetData = Assets[Group[MemberIndex]];
+			OutGroup.AssetPaths.Add(AssetData.ObjectPath);
+
+			if (MemberIndex > 0)
+			{
+				OutGroup.ReclaimableBytes += FAtlasOverviewStats::GetPackageDiskSize(AssetData.PackageName);
+				OutGroup.ReclaimableVRAMBytes += VRAMBytes[Group[MemberIndex]];
+			}
+		}
+	}
+
+	OutGroups.Sort([](const FAtlasDuplicateGroup& A, const FAtlasDuplicateGroup& B)
+	{
+		return A.ReclaimableBytes > B.ReclaimableBytes;
+	});
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogAtlas, Log, TEXT("Found %d duplicate groups among %d assets (%d hashed, %d loaded, %.1f MB hashed) in %.2fs"),
+		OutGroups.Num(), Stats.NumAssets, Stats.NumHashed, Stats.NumLoaded, Stats.HashedBytes / (1024.0 * 1024.0), Stats.Seconds);
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+void FAtlasDedupEngine::FindNearDuplicates(const TArray<FAssetData>& Assets, int32 MaxDistance, const TArray<FAtlasDuplicateGroup>& ExactGroups, TArray<FAtlasNearDuplicatePair>& OutPairs, FAtlasDedupStats* OutStats)
+{
+	using namespace AtlasDedupEngine;
+
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FAtlasDedupStats Stats;
+	OutPairs.Reset();
+
+	const FName TextureClassName = UTexture2D::StaticClass()->GetFName();
+
+	TArray<int32> Candidates;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		if (Assets[AssetIndex].AssetClass == TextureClassName)
+		{
+			Candidates.Add(AssetIndex);
+		}
+	}
+
+	Stats.NumAssets = Candidates.Num();
+
+	TArray<uint64> Fingerprints;
+	Fingerprints.SetNumZeroed(Assets.Num());
+	TArray<bool> Fingerprinted;
+	Fingerprinted.SetNumZeroed(Assets.Num());
+	TArray<int64> VRAMBytes;
+	VRAMBytes.SetNumZeroed(Assets.Num());
+
+	ProcessInBatches<FMipPayload>(Assets, Candidates,
+		[&VRAMBytes](UObject* Asset, FMipPayload& Payload)
+		{
+			UTexture2D* Texture = Cast<UTexture2D>(Asset);
+			if (!Texture)
+			{
+				return false;
+			}
+
+			VRAMBytes[Payload.AssetIndex] = FAtlasTextureUtils::EstimateVRAMBytes(Texture);
+			return ExtractMip(Texture, Payload);
+		},
+		[&Fingerprints, &Fingerprinted](const FMipPayload& Payload)
+		{
+			Fingerprinted[Payload.AssetIndex] = FAtlasPerceptualHash::Compute(Payload.Data.GetData(), Payload.SizeX, Payload.SizeY, Payload.Format, Fingerprints[Payload.AssetIndex]);
+		},
+		Stats, true);
+
+	// Exact duplicates are already reported by FindDuplicates
+	TMap<FName, int32> ExactGroupIndices;
+	for (int32 GroupIndex = 0; GroupIndex < ExactGroups.Num(); ++GroupIndex)
+	{
+		for (const FName AssetPath : ExactGroups[GroupIndex].AssetPaths)
+		{
+			ExactGroupIndices.Add(AssetPath, GroupIndex);
+		}
+	}
+
+	// Query before adding, so each texture is only matched against the ones before it
+	FAtlasBKTree Tree;
+	TArray<TPair<int32, int32>> Matches;
+	for (const int32 AssetIndex : Candidates)
+	{
+		if (!Fingerprinted[AssetIndex])
+		{
+			continue;
+		}
+
+		const FAssetData& AssetData = Assets[AssetIndex];
+		const int32* ExactGroup = ExactGroupIndices.Find(AssetData.ObjectPath);
+
+		Matches.Reset();
+		Tree.Query(Fingerprints[AssetIndex], MaxDistance, Matches);
+
+		int32 BestMatch = INDEX_NONE;
+		int32 BestDistance = MAX_int32;
+		for (const TPair<int32, int32>& Match : Matches)
+		{
+			const int32* MatchGroup = ExactGroupIndices.Find(Assets[Match.Key].ObjectPath);
+			if (ExactGroup && MatchGroup && *ExactGroup == *MatchGroup)
+			{
+				continue;
+			}
+
+			if (Match.Value < BestDistance || (Match.Value == BestDistance && Match.Key < BestMatch))
+			{
+				BestMatch = Match.Key;
+				BestDistance = Match.Value;
+			}
+		}
+
+		if (BestMatch != INDEX_NONE)
+		{
+			FAtlasNearDuplicatePair& Pair = OutPairs.AddDefaulted_GetRef();
+			Pair.OriginalPath = Assets[BestMatch].ObjectPath;
+			Pair.DuplicatePath = AssetData.ObjectPath;
+			Pair.Distance = BestDistance;
+			Pair.VRAMBytes = VRAMBytes[AssetIndex];
+		}
+
+		Tree.Add(Fingerprints[AssetIndex], AssetIndex);
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogAtlas, Log, TEXT("Found %d near-duplicate textures among %d (%d fingerprinted, %d loaded) in %.2fs"),
+		OutPairs.Num(), Stats.NumAssets, Stats.NumHashed, Stats.NumLoaded, Stats.Seconds);
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+bool FAtlasDedupEngine::Consolidate(const FAtlasDuplicateGroup& Group)
+{
+	if (Group.AssetPaths.Num() < 2)
+	{
+		return false;
+	}
+
+	UObject* AssetToKeep = FAtlasAssetUtils::LoadAsset(Group.AssetPaths[0].ToString());
+	if (!AssetToKeep)
+	{
+		return false;
+	}
+
+	TArray<UObject*> Duplicates;
+	for (int32 Index = 1; Index < Group.AssetPaths.Num(); ++Index)
+	{
+		if (UObject* Duplicate = FAtlasAssetUtils::LoadAsset(Group.AssetPaths[Index].ToString()))
+		{
+			Duplicates.Add(Duplicate);
+		}
+	}
+
+	// Every duplicate is already gone
+	if (Duplicates.Num() == 0)
+	{
+		return true;
+	}
+
+	return FAtlasAssetUtils::ConsolidateAssets(AssetToKeep, Duplicates);
+}
+
+void FAtlasDedupEngine::MakeIssues(const TArray<FAtlasDuplicateGroup>& Groups, TArray<FAtlasIssue>& OutIssues)
+{
+	using namespace AtlasDedupEngine;
+
+	for (const FAtlasDuplicateGroup& Group : Groups)
+	{
+		if (Group.AssetPaths.Num() < 2)
+		{
+			continue;
+		}
+
+		const FString KeepPath = Group.AssetPaths[0].ToString();
+		const FString KeepName = GetShortName(Group.AssetPaths[0]);
+
+		for (int32 Index = 1; Index < Group.AssetPaths.Num(); ++Index)
+		{
+			const FString DuplicatePath = Group.AssetPaths[Index].ToString();
+
+			FString Message = FString::Printf(
+				TEXT("'%s' is identical to '%s' (%d copies, %.1f MB reclaimable)"),
+				*GetShortName(Group.AssetPaths[Index]), *KeepName, Group.AssetPaths.Num(), Group.ReclaimableBytes / (1024.0 * 1024.0));
+
+			FAtlasIssue Issue(DuplicatePath, TEXT("Duplicate"), EAtlasSeverity::Warning, Message, true);
+
+			// Each issue consolidates only its own asset, so fixing a subset of a group works
+			Issue.FixFunction = [KeepPath, DuplicatePath]() -> bool
+			{
+				UObject* AssetToKeep = FAtlasAssetUtils::LoadAsset(KeepPath);
+				UObject* Duplicate = FAtlasAssetUtils::LoadAsset(DuplicatePath);
+				if (!AssetToKeep || !Duplicate)
+				{
+					return false;
+				}
+
+				return FAtlasAssetUtils::ConsolidateAssets(AssetToKeep, { Duplicate });
+			};
+
+			OutIssues.Add(Issue);
+		}
+	}
+}
+
+void FAtlasDedupEngine::MakeNearDuplicateIssues(const TArray<FAtlasNearDuplicatePair>& Pairs, int32 MaxDistance, TArray<FAtlasIssue>& OutIssues)
+{
+	using namespace AtlasDedupEngine;
+
+	for (const FAtlasNearDuplicatePair& Pair : Pairs)
+	{
+		const EAtlasSeverity Severity = Pair.Distance <= MaxDistance / 2 ? EAtlasSeverity::Warning : EAtlasSeverity::Info;
+
+		FString Message = FString::Printf(
+			TEXT("Texture '%s' looks like '%s' (%d of 63 fingerprint bits differ, %.1f MB of texture memory)"),
+			*GetShortName(Pair.DuplicatePath), *GetShortName(Pair.OriginalPath), Pair.Distance, Pair.VRAMBytes / (1024.0 * 1024.0));
+
+		OutIssues.Add(FAtlasIssue(Pair.DuplicatePath.ToString(), TEXT("NearDuplicate"), Severity, Message, false));
+	}
+}
+
+void FAtlasDedupEngine::FillReport(const TArray<FAtlasDuplicateGroup>& Groups, FAtlasReport& OutReport)
+{
+	OutReport.ReclaimableBytes = 0;
+	OutReport.ReclaimableVRAMBytes = 0;
+
+	for (const FAtlasDuplicateGroup& Group : Groups)
+	{
+		OutReport.ReclaimableBytes += Group.ReclaimableBytes;
+		OutReport.ReclaimableVRAMBytes += Group.ReclaimableVRAMBytes;
+	}
+}
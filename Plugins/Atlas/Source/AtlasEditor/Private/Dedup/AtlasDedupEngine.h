@@ -0,0 +1,181 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "Hash/Blake3.h"
+
+struct FAssetData;
+
+/**
+ * Assets whose source content is byte-identical
+ */
+struct FAtlasDuplicateGroup
+{
+	/** Content hash shared by every asset in the group */
+	FBlake3Hash Hash;
+
+	/** Class of the assets */
+	FName AssetClass;
+
+	/** Object paths; the first entry is the asset to keep (the one with the most referencers) */
+	TArray<FName> AssetPaths;
+
+	/** Disk bytes of every asset but the kept one */
+	int64 ReclaimableBytes;
+
+	/** Texture memory of every asset but the kept one; 0 for meshes */
+	int64 ReclaimableVRAMBytes;
+
+	FAtlasDuplicateGroup()
+		: ReclaimableBytes(0)
+		, ReclaimableVRAMBytes(0)
+	{
+	}
+};
+
+/**
+ * A texture that looks like another one without being identical
+ */
+struct FAtlasNearDuplicatePair
+{
+	/** Object path of the texture found first */
+	FName OriginalPath;
+
+	/** Object path of the texture resembling it; issues are reported against this one */
+	FName DuplicatePath;
+
+	/** Number of differing fingerprint bits, 0 to 63 */
+	int32 Distance;
+
+	/** Texture memory of the duplicate */
+	int64 VRAMBytes;
+
+	FAtlasNearDuplicatePair()
+		: Distance(0)
+		, VRAMBytes(0)
+	{
+	}
+};
+
+/**
+ * Counters collected while searching for duplicates
+ */
+struct FAtlasDedupStats
+{
+	/** Number of textures and meshes considered */
+	int32 NumAssets;
+
+	/** Number of assets hashed or fingerprinted; exact search skips assets whose registry tags no other asset shares */
+	int32 NumHashed;
+
+	/** Number of assets that had to be loaded for hashing */
+	int32 NumLoaded;
+
+	/** Source bytes hashed */
+	int64 HashedBytes;
+
+	/** Wall time of the search */
+	double Seconds;
+
+	FAtlasDedupStats()
+		: NumAssets(0)
+		, NumHashed(0)
+		, NumLoaded(0)
+		, HashedBytes(0)
+		, Seconds(0.0)
+	{
+	}
+};
+
+/**
+ * Finds textures and meshes with identical source content and consolidates them
+ *
+ * Textures hash their top source mip with its format and the settings that change the cooked result;
+ * meshes hash the vertex positions and triangle indices of their LOD 0 mesh description. Only assets
+ * whose registry tags (dimensions, triangle and vertex counts) match another asset are hashed.
+ * Source data is extracted on the game thread in bounded batches and hashed with BLAKE3 on worker
+ * threads while the next batch is extracted; assets loaded for hashing are released after each batch.
+ *
+ * Near-duplicate textures (re-saved JPEGs, slight recolors) are found with FAtlasPerceptualHash
+ * fingerprints and a BK-tree on their Hamming distance, so each texture is only compared with the few
+ * whose fingerprints can be close.
+ */
+class FAtlasDedupEngine
+{
+public:
+	/**
+	 * Find duplicates among all game textures and meshes
+	 * @param OutGroups Groups of two or more identical assets
+	 * @param OutStats Optional search counters
+	 */
+	static void FindDuplicatesAll(TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats = nullptr);
+
+	/**
+	 * Find duplicates among a set of assets; assets other than 2D textures and static meshes are ignored
+	 * Must be called on the game thread. Runs garbage collection between batches, so callers must not
+	 * hold unreferenced object pointers across the call.
+	 * @param Assets Assets to compare
+	 * @param OutGroups Groups of two or more identical assets
+	 * @param OutStats Optional search counters
+	 */
+	static void FindDuplicates(const TArray<FAssetData>& Assets, TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats = nullptr);
+
+	/**
+	 * Find the duplicate group of one game texture or mesh, as FindDuplicatesAll would report it
+	 * Only assets sharing its registry tags are hashed, and nothing is garbage collected, so this is
+	 * safe to call while fixes hold object pointers. Must be called on the game thread.
+	 * @param AssetData The asset to look up
+	 * @param OutGroup The group containing the asset
+	 * @return False if the asset has no identical copy
+	 */
+	static bool FindDuplicatesOf(const FAssetData& AssetData, FAtlasDuplicateGroup& OutGroup);
+
+	/**
+	 * Find textures whose perceptual fingerprints are within a Hamming distance of an earlier texture
+	 * Every texture is loaded for fingerprinting, in the same batches as FindDuplicates. Each texture
+	 * is paired with its closest match only. Must be called on the game thread.
+	 * @param Assets Assets to compare; assets other than 2D textures are ignored
+	 * @param MaxDistance Maximum number of differing fingerprint bits
+	 * @param ExactGroups Exact duplicates, which are not reported again
+	 * @param OutPairs Near-duplicate pairs
+	 * @param OutStats Optional search counters
+	 */
+	static void FindNearDuplicates(const TArray<FAssetData>& Assets, int32 MaxDistance, const TArray<FAtlasDuplicateGroup>& ExactGroups, TArray<FAtlasNearDuplicatePair>& OutPairs, FAtlasDedupStats* OutStats = nullptr);
+
+	/**
+	 * Redirect every reference in a group to the kept asset and delete the others
+	 * @param Group The group to consolidate
+	 * @return True if every duplicate was consolidated
+	 */
+	static bool Consolidate(const FAtlasDuplicateGroup& Group);
+
+	/**
+	 * Create one fixable issue per duplicate; fixing it consolidates that duplicate into the kept asset
+	 * The issues belong to FAtlasDuplicateRule, which rebuilds the fix of an issue restored without one.
+	 * @param Groups Groups found by FindDuplicates
+	 * @param OutIssues Array to append the issues to
+	 */
+	static void MakeIssues(const TArray<FAtlasDuplicateGroup>& Groups, TArray<FAtlasIssue>& OutIssues);
+
+	/**
+	 * Create one issue per near-duplicate; a warning for the closer half of MaxDistance, info otherwise
+	 * Near-duplicates are not interchangeable, so the issues have no fix.
+	 * @param Pairs Pairs found by FindNearDuplicates
+	 * @param MaxDistance The distance the pairs were searched with
+	 * @param OutIssues Array to append the issues to
+	 */
+	static void MakeNearDuplicateIssues(const TArray<FAtlasNearDuplicatePair>& Pairs, int32 MaxDistance, TArray<FAtlasIssue>& OutIssues);
+
+	/**
+	 * Set the reclaimable totals of a report
+	 * @param Groups Groups found by FindDuplicates
+	 * @param OutReport Report whose ReclaimableBytes and ReclaimableVRAMBytes are replaced
+	 */
+	static void FillReport(const TArray<FAtlasDuplicateGroup>& Groups, FAtlasReport& OutReport);
+
+private:
+	/** Shared implementation of FindDuplicates and FindDuplicatesOf */
+	static void FindDuplicatesInternal(const TArray<FAssetData>& Assets, TArray<FAtlasDuplicateGroup>& OutGroups, FAtlasDedupStats* OutStats, bool bCollectGarbage);
+};
@@ -0,0 +1,251 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasPerceptualHash.h"
+#include "Engine/Texture2D.h"
+
+namespace AtlasPerceptualHash
+{
+	static constexpr int32 SampleSize = FAtlasPerceptualHash::SampleSize;
+
+	/** Lowest frequencies kept per axis; 8x8 gives the 64 hash bits */
+	static constexpr int32 NumFrequencies = 8;
+
+	static_assert(SampleSize % 4 == 0, "Dot products process four lanes at a time");
+
+	/** DCT-II basis, one row per frequency: Values[U][X] = cos((2X + 1) U pi / (2 SampleSize)) */
+	struct FBasis
+	{
+		alignas(16) float Values[NumFrequencies][SampleSize];
+
+		FBasis()
+		{
+			for (int32 U = 0; U < NumFrequencies; ++U)
+			{
+				for (int32 X = 0; X < SampleSize; ++X)
+				{
+					Values[U][X] = FMath::Cos((2 * X + 1) * U * PI / (2 * SampleSize));
+				}
+			}
+		}
+	};
+
+	static const FBasis& GetBasis()
+	{
+		static const FBasis Basis;
+		return Basis;
+	}
+
+	/** Dot product of two SampleSize-long rows, four lanes at a time */
+	static float Dot(const float* A, const float* B)
+	{
+		VectorRegister4Float Sum = VectorZeroFloat();
+		for (int32 Index = 0; Index < SampleSize; Index += 4)
+		{
+			Sum = VectorMultiplyAdd(VectorLoad(A + Index), VectorLoad(B + Index), Sum);
+		}
+
+		alignas(16) float Lanes[4];
+		VectorStoreAligned(Sum, Lanes);
+		return Lanes[0] + Lanes[1] + Lanes[2] + Lanes[3];
+	}
+
+	static float GetLuminance(float R, float G, float B)
+	{
+		return 0.299f * R + 0.587f * G + 0.114f * B;
+	}
+
+	static int32 GetBytesPerPixel(ETextureSourceFormat Format)
+	{
+		switch (Format)
+		{
+		case TSF_G8:
+			return 1;
+		case TSF_G16:
+			return 2;
+		case TSF_BGRA8:
+		case TSF_BGRE8:
+			return 4;
+		case TSF_RGBA16:
+		case TSF_RGBA16F:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	/** Convert one row of source pixels to luminance in [0, 1] */
+	static void ConvertRow(const uint8* Row, int32 SizeX, ETextureSourceFormat Format, float* OutLuminance)
+	{
+		switch (Format)
+		{
+		case TSF_G8:
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				OutLuminance[X] = Row[X] / 255.0f;
+			}
+			break;
+
+		case TSF_G16:
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				OutLuminance[X] = reinterpret_cast<const uint16*>(Row)[X] / 65535.0f;
+			}
+			break;
+
+		case TSF_BGRA8:
+		case TSF_BGRE8:
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				const uint8* Pixel = Row + X * 4;
+				OutLuminance[X] = GetLuminance(Pixel[2], Pixel[1], Pixel[0]) / 255.0f;
+			}
+			break;
+
+		case TSF_RGBA16:
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				const uint16* Pixel = reinterpret_cast<const uint16*>(Row) + X * 4;
+				OutLuminance[X] = GetLuminance(Pixel[0], Pixel[1], Pixel[2]) / 65535.0f;
+			}
+			break;
+
+		case TSF_RGBA16F:
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				// HDR values are clamped so one bright spot does not dominate the hash
+				const FFloat16* Pixel = reinterpret_cast<const FFloat16*>(Row) + X * 4;
+				OutLuminance[X] = FMath::Clamp(GetLuminance(Pixel[0].GetFloat(), Pixel[1].GetFloat(), Pixel[2].GetFloat()), 0.0f, 1.0f);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	/** Source range [OutStart, OutEnd) covered by one sample; never empty, so small images are upsampled */
+	static void GetSourceRange(int32 Sample, int32 SourceSize, int32& OutStart, int32& OutEnd)
+	{
+		OutStart = FMath::Min(Sample * SourceSize / SampleSize, SourceSize - 1);
+		OutEnd = FMath::Max((Sample + 1) * SourceSize / SampleSize, OutStart + 1);
+	}
+}
+
+int32 FAtlasPerceptualHash::GetSourceMipIndex(const UTexture2D* Texture)
+{
+	const FTextureSource& Source = Texture->Source;
+
+	int32 MipIndex = 0;
+	while (MipIndex + 1 < Source.GetNumMips()
+		&& FMath::Min(Source.GetSizeX() >> (MipIndex + 1), Source.GetSizeY() >> (MipIndex + 1)) >= SampleSize)
+	{
+		++MipIndex;
+	}
+
+	return MipIndex;
+}
+
+bool FAtlasPerceptualHash::Compute(const uint8* Data, int32 SizeX, int32 SizeY, ETextureSourceFormat Format, uint64& OutHash)
+{
+	alignas(16) float Luminance[SampleSize * SampleSize];
+	if (!Downsample(Data, SizeX, SizeY, Format, Luminance))
+	{
+		return false;
+	}
+
+	OutHash = ComputeFromLuminance(Luminance);
+	return true;
+}
+
+uint64 FAtlasPerceptualHash::ComputeFromLuminance(const float* Luminance)
+{
+	using namespace AtlasPerceptualHash;
+
+	const FBasis& Basis = GetBasis();
+
+	// Row pass, stored transposed so the column pass is also a dot product over contiguous memory
+	alignas(16) float RowCoefficients[NumFrequencies][SampleSize];
+	for (int32 Y = 0; Y < SampleSize; ++Y)
+	{
+		for (int32 U = 0; U < NumFrequencies; ++U)
+		{
+			RowCoefficients[U][Y] = Dot(Luminance + Y * SampleSize, Basis.Values[U]);
+		}
+	}
+
+	float Coefficients[NumFrequencies * NumFrequencies];
+	for (int32 V = 0; V < NumFrequencies; ++V)
+	{
+		for (int32 U = 0; U < NumFrequencies; ++U)
+		{
+			Coefficients[V * NumFrequencies + U] = Dot(Basis.Values[V], RowCoefficients[U]);
+		}
+	}
+
+	// DC only carries average brightness and is left out of the median and the hash
+	TArray<float, TInlineAllocator<NumFrequencies * NumFrequencies>> Sorted(Coefficients + 1, NumFrequencies * NumFrequencies - 1);
+	Sorted.Sort();
+	const float Median = Sorted[Sorted.Num() / 2];
+
+	uint64 Hash = 0;
+	for (int32 Index = 1; Index < NumFrequencies * NumFrequencies; ++Index)
+	{
+		if (Coefficients[Index] > Median)
+		{
+			Hash |= 1ull << Index;
+		}
+	}
+
+	return Hash;
+}
+
+bool FAtlasPerceptualHash::Downsample(const uint8* Data, int32 SizeX, int32 SizeY, ETextureSourceFormat Format, float* OutLuminance)
+{
+	using namespace AtlasPerceptualHash;
+
+	const int32 BytesPerPixel = GetBytesPerPixel(Format);
+	if (BytesPerPixel == 0 || SizeX <= 0 || SizeY <= 0)
+	{
+		return false;
+	}
+
+	int32 ColumnStarts[SampleSize];
+	int32 ColumnEnds[SampleSize];
+	for (int32 SampleX = 0; SampleX < SampleSize; ++SampleX)
+	{
+		GetSourceRange(SampleX, SizeX, ColumnStarts[SampleX], ColumnEnds[SampleX]);
+	}
+
+	TArray<float> RowLuminance;
+	RowLuminance.SetNumUninitialized(SizeX);
+
+	for (int32 SampleY = 0; SampleY < SampleSize; ++SampleY)
+	{
+		int32 RowStart = 0;
+		int32 RowEnd = 0;
+		GetSourceRange(SampleY, SizeY, RowStart, RowEnd);
+
+		float* OutRow = OutLuminance + SampleY * SampleSize;
+		FMemory::Memzero(OutRow, SampleSize * sizeof(float));
+
+		for (int32 Y = RowStart; Y < RowEnd; ++Y)
+		{
+			ConvertRow(Data + static_cast<int64>(Y) * SizeX * BytesPerPixel, SizeX, Format, RowLuminance.GetData());
+
+			for (int32 SampleX = 0; SampleX < SampleSize; ++SampleX)
+			{
+				for (int32 X = ColumnStarts[SampleX]; X < ColumnEnds[SampleX]; ++X)
+				{
+					OutRow[SampleX] += RowLuminance[X];
+				}
+			}
+		}
+
+		for (int32 SampleX = 0; SampleX < SampleSize; ++SampleX)
+		{
+			OutRow[SampleX] /= static_cast<float>((RowEnd - RowStart) * (ColumnEnds[SampleX] - ColumnStarts[SampleX]));
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,58 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Texture.h"
+
+class UTexture2D;
+
+/**
+ * Perceptual fingerprint of an image: a 64-bit DCT hash of its downsampled luminance
+ *
+ * The image is box-filtered to 32x32 luminance, transformed with a 2D DCT, and each of the lowest 8x8
+ * frequencies (except DC) sets one bit when it is above their median. Re-encoding, small color shifts
+ * and resizing flip few bits, so similar images have a small Hamming distance.
+ */
+class FAtlasPerceptualHash
+{
+public:
+	/** Side of the downsampled luminance image */
+	static constexpr int32 SampleSize = 32;
+
+	/**
+	 * Get the source mip to fingerprint: the smallest one still at least SampleSize on both sides
+	 * @param Texture The texture
+	 * @return Source mip index
+	 */
+	static int32 GetSourceMipIndex(const UTexture2D* Texture);
+
+	/**
+	 * Fingerprint raw texture source data; safe to call from worker threads
+	 * @param Data Pixels of one mip, rows tightly packed
+	 * @param SizeX Width of the mip
+	 * @param SizeY Height of the mip
+	 * @param Format Source format of the pixels
+	 * @param OutHash The fingerprint
+	 * @return False if the format is not supported
+	 */
+	static bool Compute(const uint8* Data, int32 SizeX, int32 SizeY, ETextureSourceFormat Format, uint64& OutHash);
+
+	/**
+	 * Fingerprint a SampleSize x SampleSize luminance image
+	 * @param Luminance Row-major luminance values
+	 * @return The fingerprint
+	 */
+	static uint64 ComputeFromLuminance(const float* Luminance);
+
+	/**
+	 * Box-filter a mip to SampleSize x SampleSize Rec. 601 luminance
+	 * @param Data Pixels of one mip, rows tightly packed
+	 * @param SizeX Width of the mip
+	 * @param SizeY Height of the mip
+	 * @param Format Source format of the pixels
+	 * @param OutLuminance SampleSize * SampleSize values to fill
+	 * @return False if the format is not supported
+	 */
+	static bool Downsample(const uint8* Data, int32 SizeX, int32 SizeY, ETextureSourceFormat Format, float* OutLuminance);
+};
@@ -0,0 +1,415 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasMaterialBuilder.h"
+#include "AtlasSettings.h"
+#include "AtlasRuntime.h"
+#include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasFixExecutor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "MaterialEditingLibrary.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionConstant.h"
+#include "Materials/MaterialExpressionConstant3Vector.h"
+#include "Materials/MaterialExpressionStaticSwitchParameter.h"
+#include "Materials/MaterialExpressionTextureBase.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "UObject/MetaData.h"
+#include "UObject/Package.h"
+
+namespace AtlasMaterialBuilder
+{
+	/** Switch sets an instance may use (normal, roughness, metalness, AO, emissive); the master compiles at most one shader map per entry */
+	static const FAtlasMaterialFeatureSet FeatureSets[] =
+	{
+		{ TEXT("Color"), false, false, false, false, false },
+		{ TEXT("Normal"), true, false, false, false, false },
+		{ TEXT("NormalRough"), true, true, false, false, false },
+		{ TEXT("PBR"), true, true, true, true, false },
+		{ TEXT("PBREmissive"), true, true, true, true, true },
+	};
+
+	static const FName UseNormalName(TEXT("UseNormal"));
+	static const FName UseRoughnessName(TEXT("UseRoughness"));
+	static const FName UseMetalnessName(TEXT("UseMetalness"));
+	static const FName UseAOName(TEXT("UseAO"));
+	static const FName UseEmissiveName(TEXT("UseEmissive"));
+
+	/** Package metadata key marking instances this builder created; any other instance is left alone */
+	static const FName BuiltByKey(TEXT("AtlasMaterialBuilder"));
+
+	/** Placeholder textures are tiny, they only stand in for maps an instance does not have */
+	static constexpr int32 PlaceholderSize = 4;
+
+	static EMaterialSamplerType GetSamplerType(EAtlasMapType MapType)
+	{
+		switch (MapType)
+		{
+		case EAtlasMapType::Normal:
+			return SAMPLERTYPE_Normal;
+
+		case EAtlasMapType::Roughness:
+		case EAtlasMapType::Metalness:
+		case EAtlasMapType::AO:
+			return SAMPLERTYPE_LinearGrayscale;
+
+		default:
+			return SAMPLERTYPE_Color;
+		}
+	}
+
+	static bool IsCovered(const FAtlasMaterialFeatureSet& Set, EAtlasMapType MapType)
+	{
+		switch (MapType)
+		{
+		case EAtlasMapType::BaseColor:
+			return true;
+		case EAtlasMapType::Normal:
+			return Set.bNormal;
+		case EAtlasMapType::Roughness:
+			return Set.bRoughness;
+		case EAtlasMapType::Metalness:
+			return Set.bMetalness;
+		case EAtlasMapType::AO:
+			return Set.bAO;
+		case EAtlasMapType::Emissive:
+			return Set.bEmissive;
+		default:
+			// Not connected in the master, so no set needs to cover it
+			return true;
+		}
+	}
+
+	static UMaterialExpressionTextureSampleParameter2D* AddSampler(UMaterial* Material, EAtlasMapType MapType, UTexture* DefaultTexture, int32 PosY)
+	{
+		UMaterialExpressionTextureSampleParameter2D* Sampler = Cast<UMaterialExpressionTextureSampleParameter2D>(
+			UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionTextureSampleParameter2D::StaticClass(), -800, PosY));
+
+		Sampler->ParameterName = FAtlasMaterialBuilder::GetTextureParameterName(MapType);
+		Sampler->Texture = DefaultTexture;
+		Sampler->SamplerType = GetSamplerType(MapType);
+		return Sampler;
+	}
+
+	/** Route TrueExpression through a static switch, falling back to FalseExpression */
+	static UMaterialExpression* AddSwitch(UMaterial* Material, FName SwitchName, UMaterialExpression* TrueExpression, const FString& TrueOutput, UMaterialExpression* FalseExpression, int32 PosY)
+	{
+		UMaterialExpressionStaticSwitchParameter* Switch = Cast<UMaterialExpressionStaticSwitchParameter>(
+			UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionStaticSwitchParameter::StaticClass(), -300, PosY));
+
+		Switch->ParameterName = SwitchName;
+		Switch->DefaultValue = false;
+		UMaterialEditingLibrary::ConnectMaterialExpressions(TrueExpression, TrueOutput, Switch, TEXT("True"));
+		UMaterialEditingLibrary::ConnectMaterialExpressions(FalseExpression, FString(), Switch, TEXT("False"));
+		return Switch;
+	}
+
+	static UMaterialExpression* AddConstant(UMaterial* Material, float Value, int32 PosY)
+	{
+		UMaterialExpressionConstant* Constant = Cast<UMaterialExpressionConstant>(
+			UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionConstant::StaticClass(), -500, PosY));
+
+		Constant->R = Value;
+		return Constant;
+	}
+
+	static UMaterialExpression* AddConstant3(UMaterial* Material, const FLinearColor& Value, int32 PosY)
+	{
+		UMaterialExpressionConstant3Vector* Constant = Cast<UMaterialExpressionConstant3Vector>(
+			UMaterialEditingLibrary::CreateMaterialExpression(Material, UMaterialExpressionConstant3Vector::StaticClass(), -500, PosY));
+
+		Constant->Constant = Value;
+		return Constant;
+	}
+}
+
+TWeakObjectPtr<UMaterial> FAtlasMaterialBuilder::CachedMaster;
+
+void FAtlasMaterialBuilder::BuildMaterials(const TArray<FAtlasMaterialRequest>& Requests, TArray<UMaterialInstanceConstant*>* OutInstances)
+{
+	using namespace AtlasMaterialBuilder;
+
+	check(IsInGameThread());
+
+	if (Requests.Num() == 0)
+	{
+		return;
+	}
+
+	// The whole build is one undo transaction
+	if (!FAtlasFixExecutor::IsBatching())
+	{
+		FAtlasFixExecutor::RunBatch(FText::FromString(FString::Printf(TEXT("Atlas: Build %d Materials"), Requests.Num())), [&Requests, OutInstances]()
+		{
+			BuildMaterials(Requests, OutInstances);
+		}, false);
+		return;
+	}
+
+	UMaterial* Master = GetMasterMaterial();
+	if (!Master)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FString Prefix = FAtlasAssetUtils::GetPrefixForAssetType(TEXT("MaterialInstance"));
+
+	TSet<int32> UsedFeatureSets;
+	int32 NumCreated = 0;
+	int32 NumMismatched = 0;
+	{
+		// Render state and static permutations of the whole batch are updated once, when this goes out of scope
+		FMaterialUpdateContext UpdateContext;
+
+		for (const FAtlasMaterialRequest& Request : Requests)
+		{
+			const FString AssetName = Prefix + Request.BaseName;
+			const FString PackageName = Request.PackagePath / AssetName;
+			const FString ObjectPath = PackageName + TEXT(".") + AssetName;
+
+			UMaterialInstanceConstant* Instance = LoadObject<UMaterialInstanceConstant>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+			if (Instance)
+			{
+				// Reimports rebuild our own instances; a hand-authored one with the same name is not ours to reparent
+				if (!Instance->GetOutermost()->GetMetaData()->HasValue(Instance, BuiltByKey))
+				{
+					UE_LOG(LogAtlas, Warning, TEXT("Skipping material %s: it was not created by the material builder"), *ObjectPath);
+					continue;
+				}
+			}
+			else
+			{
+				if (FindObject<UObject>(nullptr, *ObjectPath) || FPackageName::DoesPackageExist(PackageName))
+				{
+					UE_LOG(LogAtlas, Warning, TEXT("Cannot build material %s: the path holds another asset"), *ObjectPath);
+					continue;
+				}
+
+				UPackage* Package = CreatePackage(*PackageName);
+				Instance = NewObject<UMaterialInstanceConstant>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+				Package->GetMetaData()->SetValue(Instance, BuiltByKey, TEXT("true"));
+				FAssetRegistryModule::AssetCreated(Instance);
+				++NumCreated;
+			}
+
+			FAtlasFixExecutor::BeginEdit(Instance);
+
+			// No recache here, the update context recompiles once for the whole batch
+			Instance->SetParentEditorOnly(Master, false);
+
+			// Textures whose compression does not fit the parameter's sampler would break the instance's
+			// shaders. They are left out rather than recompressed: the name may be misleading, the texture
+			// may be used elsewhere, and the TextureCompression rule reports the mismatch.
+			TMap<EAtlasMapType, UTexture2D*> AssignedTextures;
+			for (const TPair<EAtlasMapType, UTexture2D*>& Pair : Request.TexturesByType)
+			{
+				const FName ParameterName = GetTextureParameterName(Pair.Key);
+				if (ParameterName.IsNone() || !Pair.Value)
+				{
+					continue;
+				}
+
+				if (!HasMatchingSamplerType(Pair.Value, Pair.Key))
+				{
+					UE_LOG(LogAtlas, Warning, TEXT("Not assigning %s to %s of %s: its compression does not match the parameter's sampler type"),
+						*Pair.Value->GetName(), *ParameterName.ToString(), *AssetName);
+					++NumMismatched;
+					continue;
+				}
+
+				Instance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ParameterName), Pair.Value);
+				AssignedTextures.Add(Pair.Key, Pair.Value);
+			}
+
+			const int32 SetIndex = SelectFeatureSet(AssignedTextures);
+			const FAtlasMaterialFeatureSet& Set = FeatureSets[SetIndex];
+			UsedFeatureSets.Add(SetIndex);
+
+			FStaticParameterSet StaticParameters = Instance->GetStaticParameters();
+			StaticParameters.StaticSwitchParameters.Reset();
+			StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(UseNormalName), Set.bNormal, true, FGuid());
+			StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(UseRoughnessName), Set.bRoughness, true, FGuid());
+			StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(UseMetalnessName), Set.bMetalness, true, FGuid());
+			StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(UseAOName), Set.bAO, true, FGuid());
+			StaticParameters.StaticSwitchParameters.Emplace(FMaterialParameterInfo(UseEmissiveName), Set.bEmissive, true, FGuid());
+			Instance->UpdateStaticPermutation(StaticParameters, &UpdateContext);
+
+			FAtlasFixExecutor::EndEdit(Instance);
+
+			if (OutInstances)
+			{
+				OutInstances->Add(Instance);
+			}
+		}
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Built %d material instances (%d new, %d textures left out for their compression) using %d static switch sets in %.2fs; shaders compile in the background"),
+		Requests.Num(), NumCreated, NumMismatched, UsedFeatureSets.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+UMaterial* FAtlasMaterialBuilder::GetMasterMaterial()
+{
+	if (UMaterial* Master = CachedMaster.Get())
+	{
+		return Master;
+	}
+
+	const FSoftObjectPath& Path = UAtlasSettings::Get()->MasterMaterial;
+	if (!Path.IsValid())
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("No master material configured for the material builder"));
+		return nullptr;
+	}
+
+	UMaterial* Master = Cast<UMaterial>(Path.TryLoad());
+	if (!Master)
+	{
+		Master = CreateMasterMaterial(Path);
+	}
+
+	CachedMaster = Master;
+	return Master;
+}
+
+TConstArrayView<FAtlasMaterialFeatureSet> FAtlasMaterialBuilder::GetFeatureSets()
+{
+	return AtlasMaterialBuilder::FeatureSets;
+}
+
+int32 FAtlasMaterialBuilder::SelectFeatureSet(const TMap<EAtlasMapType, UTexture2D*>& TexturesByType)
+{
+	using namespace AtlasMaterialBuilder;
+
+	const TConstArrayView<FAtlasMaterialFeatureSet> Sets = GetFeatureSets();
+	for (int32 Index = 0; Index < Sets.Num(); ++Index)
+	{
+		bool bCoversAll = true;
+		for (const TPair<EAtlasMapType, UTexture2D*>& Pair : TexturesByType)
+		{
+			if (!IsCovered(Sets[Index], Pair.Key))
+			{
+				bCoversAll = false;
+				break;
+			}
+		}
+
+		if (bCoversAll)
+		{
+			return Index;
+		}
+	}
+
+	return Sets.Num() - 1;
+}
+
+FName FAtlasMaterialBuilder::GetTextureParameterName(EAtlasMapType MapType)
+{
+	switch (MapType)
+	{
+	case EAtlasMapType::BaseColor:
+		return TEXT("BaseColorTex");
+	case EAtlasMapType::Normal:
+		return TEXT("NormalTex");
+	case EAtlasMapType::Roughness:
+		return TEXT("RoughnessTex");
+	case EAtlasMapType::Metalness:
+		return TEXT("MetalnessTex");
+	case EAtlasMapType::AO:
+		return TEXT("AOTex");
+	case EAtlasMapType::Emissive:
+		return TEXT("EmissiveTex");
+	default:
+		return NAME_None;
+	}
+}
+
+UMaterial* FAtlasMaterialBuilder::CreateMasterMaterial(const FSoftObjectPath& Path)
+{
+	using namespace AtlasMaterialBuilder;
+
+	const FString PackageName = Path.GetLongPackageName();
+	const FString AssetName = Path.GetAssetName();
+	const FString Folder = FPackageName::GetLongPackagePath(PackageName);
+
+	UTexture* DefaultColor = LoadObject<UTexture>(nullptr, TEXT("/Engine/EngineMaterials/DefaultDiffuse.DefaultDiffuse"));
+	UTexture* DefaultNormal = LoadObject<UTexture>(nullptr, TEXT("/Engine/EngineMaterials/FlatNormal.FlatNormal"));
+	UTexture* White = GetPlaceholderTexture(Folder, true);
+	UTexture* Black = GetPlaceholderTexture(Folder, false);
+	if (!DefaultColor || !DefaultNormal || !White || !Black)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Cannot create master material %s: default textures are missing"), *PackageName);
+		return nullptr;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UMaterial* Master = NewObject<UMaterial>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	FAssetRegistryModule::AssetCreated(Master);
+
+	// Base color is always sampled; every other input is behind a switch with a neutral fallback
+	UMaterialExpression* BaseColor = AddSampler(Master, EAtlasMapType::BaseColor, DefaultColor, 0);
+	UMaterialEditingLibrary::ConnectMaterialProperty(BaseColor, TEXT("RGB"), MP_BaseColor);
+
+	UMaterialExpression* Normal = AddSwitch(Master, UseNormalName,
+		AddSampler(Master, EAtlasMapType::Normal, DefaultNormal, 300), TEXT("RGB"), AddConstant3(Master, FLinearColor(0.0f, 0.0f, 1.0f), 450), 300);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Normal, FString(), MP_Normal);
+
+	UMaterialExpression* Roughness = AddSwitch(Master, UseRoughnessName,
+		AddSampler(Master, EAtlasMapType::Roughness, White, 600), TEXT("R"), AddConstant(Master, 0.5f, 750), 600);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Roughness, FString(), MP_Roughness);
+
+	UMaterialExpression* Metalness = AddSwitch(Master, UseMetalnessName,
+		AddSampler(Master, EAtlasMapType::Metalness, Black, 900), TEXT("R"), AddConstant(Master, 0.0f, 1050), 900);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Metalness, FString(), MP_Metallic);
+
+	UMaterialExpression* AO = AddSwitch(Master, UseAOName,
+		AddSampler(Master, EAtlasMapType::AO, White, 1200), TEXT("R"), AddConstant(Master, 1.0f, 1350), 1200);
+	UMaterialEditingLibrary::ConnectMaterialProperty(AO, FString(), MP_AmbientOcclusion);
+
+	UMaterialExpression* Emissive = AddSwitch(Master, UseEmissiveName,
+		AddSampler(Master, EAtlasMapType::Emissive, DefaultColor, 1500), TEXT("RGB"), AddConstant3(Master, FLinearColor::Black, 1650), 1500);
+	UMaterialEditingLibrary::ConnectMaterialProperty(Emissive, FString(), MP_EmissiveColor);
+
+	UMaterialEditingLibrary::RecompileMaterial(Master);
+	Master->MarkPackageDirty();
+
+	UE_LOG(LogAtlas, Log, TEXT("Created master material %s"), *Master->GetPathName());
+	return Master;
+}
+
+UTexture* FAtlasMaterialBuilder::GetPlaceholderTexture(const FString& Folder, bool bWhite)
+{
+	using namespace AtlasMaterialBuilder;
+
+	const FString AssetName = bWhite ? TEXT("T_Placeholder_White") : TEXT("T_Placeholder_Black");
+	const FString PackageName = Folder / AssetName;
+
+	if (UTexture* Existing = LoadObject<UTexture>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet))
+	{
+		return Existing;
+	}
+
+	UPackage* Package = CreatePackage(*PackageName);
+	UTexture2D* Texture = NewObject<UTexture2D>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+
+	TArray<uint8> Pixels;
+	Pixels.Init(static_cast<uint8>(bWhite ? 255 : 0), PlaceholderSize * PlaceholderSize);
+	Texture->Source.Init(PlaceholderSize, PlaceholderSize, 1, 1, TSF_G8, Pixels.GetData());
+
+	// Linear grayscale, the sampler type of the mask parameters
+	Texture->CompressionSettings = TC_Grayscale;
+	Texture->SRGB = false;
+
+	// Built with the rest of the batch; the master only needs the sampler type, which the settings above decide
+	FAtlasFixExecutor::EndEdit(Texture);
+
+	FAssetRegistryModule::AssetCreated(Texture);
+	return Texture;
+}
+
+bool FAtlasMaterialBuilder::HasMatchingSamplerType(const UTexture2D* Texture, EAtlasMapType MapType)
+{
+	return UMaterialExpressionTextureBase::GetSamplerTypeForTexture(Texture, true) == AtlasMaterialBuilder::GetSamplerType(MapType);
+}
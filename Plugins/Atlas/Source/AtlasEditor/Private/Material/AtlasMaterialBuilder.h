@@ -0,0 +1,105 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+class UMaterial;
+class UMaterialInstanceConstant;
+class UTexture;
+class UTexture2D;
+
+/**
+ * One material instance to build from a set of textures
+ */
+struct FAtlasMaterialRequest
+{
+	/** Base name; the instance is named <MaterialInstance prefix><BaseName> */
+	FString BaseName;
+
+	/** Folder the instance is created in */
+	FString PackagePath;
+
+	/** Textures by map type */
+	TMap<EAtlasMapType, UTexture2D*> TexturesByType;
+};
+
+/**
+ * A fixed combination of the master material's static switches
+ */
+struct FAtlasMaterialFeatureSet
+{
+	const TCHAR* Name;
+	bool bNormal;
+	bool bRoughness;
+	bool bMetalness;
+	bool bAO;
+	bool bEmissive;
+};
+
+/**
+ * Builds PBR material instances against one shared master material
+ *
+ * Every instance is a UMaterialInstanceConstant of UAtlasSettings::MasterMaterial (M_MegaPBR_Master),
+ * which is created on first use if it does not exist. Textures are assigned to the master's texture
+ * parameters by map type. Static switches are never set one by one: each instance gets the smallest
+ * entry of a fixed feature set table that covers its textures, so the master compiles at most one
+ * shader map per table entry however many instances exist. Static permutations of a batch are updated
+ * under one FMaterialUpdateContext and compile asynchronously in the shader compiling manager.
+ * Textures whose compression does not fit their parameter's sampler type are left unassigned and
+ * reported, and instances the builder did not create (no AtlasMaterialBuilder package metadata) are
+ * skipped, so reimports never change hand-authored assets.
+ * Height and opacity maps are not connected: they would need parallax or a second blend mode.
+ */
+class FAtlasMaterialBuilder
+{
+public:
+	/**
+	 * Create or update material instances for a batch of requests
+	 * Runs inside the active FAtlasFixExecutor batch, or as its own batch. Existing instances are only
+	 * updated if this builder created them; textures are never modified.
+	 * @param Requests Instances to build
+	 * @param OutInstances Optional array to fill with the built instances
+	 */
+	static void BuildMaterials(const TArray<FAtlasMaterialRequest>& Requests, TArray<UMaterialInstanceConstant*>* OutInstances = nullptr);
+
+	/**
+	 * Get the master material, loading or creating it once per editor session
+	 * @return The master material, or null if it could not be created
+	 */
+	static UMaterial* GetMasterMaterial();
+
+	/**
+	 * Get the fixed feature set table
+	 * @return Entries ordered from fewest to most features
+	 */
+	static TConstArrayView<FAtlasMaterialFeatureSet> GetFeatureSets();
+
+	/**
+	 * Pick the smallest feature set that covers a set of textures
+	 * @param TexturesByType Textures by map type
+	 * @return Index into GetFeatureSets()
+	 */
+	static int32 SelectFeatureSet(const TMap<EAtlasMapType, UTexture2D*>& TexturesByType);
+
+	/**
+	 * Get the master's texture parameter for a map type
+	 * @param MapType The map type
+	 * @return Parameter name, or NAME_None for map types the master does not use
+	 */
+	static FName GetTextureParameterName(EAtlasMapType MapType);
+
+private:
+	/** Build the master's graph in a new package */
+	static UMaterial* CreateMasterMaterial(const FSoftObjectPath& Path);
+
+	/** Load or create a 4x4 linear grayscale texture next to the master */
+	static UTexture* GetPlaceholderTexture(const FString& Folder, bool bWhite);
+
+	/** Check that a texture's compression fits the sampler type of the master's parameter */
+	static bool HasMatchingSamplerType(const UTexture2D* Texture, EAtlasMapType MapType);
+
+	/** Master cached for the editor session */
+	static TWeakObjectPtr<UMaterial> CachedMaster;
+};
@@ -0,0 +1,385 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasOrganizer.h"
+#include "AtlasSettings.h"
+#include "AtlasRuntime.h"
+#include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasFixExecutor.h"
+#include "Core/AtlasMapTypeClassifier.h"
+#include "Material/AtlasMaterialBuilder.h"
+#include "Editor.h"
+#include "EditorAssetLibrary.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/CoreDelegates.h"
+#include "Subsystems/ImportSubsystem.h"
+
+namespace AtlasOrganizer
+{
+	enum class EDestination : uint8
+	{
+		None,
+		Mesh,
+		Material,
+		Texture
+	};
+
+	static EDestination GetDestination(const UObject* Asset)
+	{
+		if (Asset->IsA<UTexture2D>())
+		{
+			return EDestination::Texture;
+		}
+		if (Asset->IsA<UStaticMesh>() || Asset->IsA<USkeletalMesh>())
+		{
+			return EDestination::Mesh;
+		}
+		if (Asset->IsA<UMaterialInterface>())
+		{
+			return EDestination::Material;
+		}
+		return EDestination::None;
+	}
+
+	static bool IsSeparator(TCHAR Char)
+	{
+		return Char == TEXT('_') || Char == TEXT('-') || Char == TEXT('.') || Char == TEXT(' ');
+	}
+
+	/** An asset and the package it moves to */
+	struct FPlannedMove
+	{
+		UObject* Asset;
+		FString DestPath;
+
+		FPlannedMove(UObject* InAsset, const FString& InDestPath)
+			: Asset(InAsset)
+			, DestPath(InDestPath)
+		{
+		}
+	};
+}
+
+FAtlasOrganizer::FAtlasOrganizer()
+	: LastImportTime(0.0)
+	, bRunning(false)
+{
+}
+
+FAtlasOrganizer::~FAtlasOrganizer()
+{
+	Stop();
+}
+
+void FAtlasOrganizer::Start()
+{
+	if (bRunning)
+	{
+		return;
+	}
+
+	bRunning = true;
+
+	// Editor modules load before the editor engine exists
+	if (GEditor)
+	{
+		BindImportEvents();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FAtlasOrganizer::BindImportEvents);
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Atlas organizer started"));
+}
+
+void FAtlasOrganizer::Stop()
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	if (UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr)
+	{
+		ImportSubsystem->OnAssetPostImport.Remove(PostImportHandle);
+		ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+	}
+
+	PendingObjects.Reset();
+	PendingKeys.Reset();
+	bRunning = false;
+
+	UE_LOG(LogAtlas, Log, TEXT("Atlas organizer stopped"));
+}
+
+void FAtlasOrganizer::BindImportEvents()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	UImportSubsystem* ImportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UImportSubsystem>() : nullptr;
+	if (!ImportSubsystem)
+	{
+		UE_LOG(LogAtlas, Warning, TEXT("Atlas organizer could not find the import subsystem"));
+		return;
+	}
+
+	PostImportHandle = ImportSubsystem->OnAssetPostImport.AddRaw(this, &FAtlasOrganizer::OnAssetPostImport);
+	ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FAtlasOrganizer::OnAssetReimport);
+}
+
+void FAtlasOrganizer::OnAssetPostImport(UFactory* Factory, UObject* Object)
+{
+	Enqueue(Object);
+}
+
+void FAtlasOrganizer::OnAssetReimport(UObject* Object)
+{
+	// Organized assets are already at their destination and are skipped
+	Enqueue(Object);
+}
+
+void FAtlasOrganizer::Enqueue(UObject* Object)
+{
+	if (!Object || !Object->IsAsset())
+	{
+		return;
+	}
+
+	bool bAlreadyPending = false;
+	PendingKeys.Add(FObjectKey(Object), &bAlreadyPending);
+	if (!bAlreadyPending)
+	{
+		PendingObjects.Add(Object);
+	}
+
+	LastImportTime = FPlatformTime::Seconds();
+}
+
+bool FAtlasOrganizer::IsTickable() const
+{
+	return bRunning && PendingObjects.Num() > 0;
+}
+
+TStatId FAtlasOrganizer::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FAtlasOrganizer, STATGROUP_Tickables);
+}
+
+void FAtlasOrganizer::Tick(float DeltaTime)
+{
+	// The session ends once imports have stopped arriving
+	if (FPlatformTime::Seconds() - LastImportTime < UAtlasSettings::Get()->OrganizerDebounceSeconds || FAtlasFixExecutor::IsBatching())
+	{
+		return;
+	}
+
+	TArray<UObject*> Session;
+	Session.Reserve(PendingObjects.Num());
+	for (const TWeakObjectPtr<UObject>& WeakObject : PendingObjects)
+	{
+		if (UObject* Object = WeakObject.Get())
+		{
+			Session.Add(Object);
+		}
+	}
+
+	PendingObjects.Reset();
+	PendingKeys.Reset();
+
+	if (Session.Num() > 0)
+	{
+		OrganizeAssets(Session);
+	}
+}
+
+void FAtlasOrganizer::OrganizeAssets(const TArray<UObject*>& Assets, TArray<FAtlasOrganizerGroup>* OutGroups)
+{
+	using namespace AtlasOrganizer;
+
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<UObject*> Organizable;
+	TArray<EDestination> Destinations;
+	TArray<FString> TextureNames;
+	for (UObject* Asset : Assets)
+	{
+		const EDestination Destination = Asset ? GetDestination(Asset) : EDestination::None;
+		if (Destination == EDestination::None)
+		{
+			continue;
+		}
+
+		Organizable.Add(Asset);
+		Destinations.Add(Destination);
+		if (Destination == EDestination::Texture)
+		{
+			TextureNames.Add(Asset->GetName());
+		}
+	}
+
+	// One classification pass over every texture of the session
+	TArray<EAtlasMapType> TextureTypes;
+	TArray<int32> SuffixStarts;
+	FAtlasMapTypeClassifier::Get().ClassifyBatch(TextureNames, TextureTypes, &SuffixStarts);
+
+	// Group by base name (case-insensitive), so T_Rock_N, SM_Rock and M_Rock share a folder
+	TMap<FString, FAtlasOrganizerGroup> Groups;
+
+	int32 TextureIndex = 0;
+	for (int32 Index = 0; Index < Organizable.Num(); ++Index)
+	{
+		UObject* Asset = Organizable[Index];
+		const bool bIsTexture = Destinations[Index] == EDestination::Texture;
+		const FString BaseName = SuggestBaseName(Asset->GetName(), bIsTexture ? SuffixStarts[TextureIndex] : INDEX_NONE);
+
+		FAtlasOrganizerGroup* Group = Groups.Find(BaseName);
+		if (!Group)
+		{
+			Group = &Groups.Add(BaseName);
+			Group->BaseName = BaseName;
+		}
+
+		Group->Assets.Add(Asset);
+		if (bIsTexture)
+		{
+			const EAtlasMapType MapType = TextureTypes[TextureIndex++];
+			if (MapType != EAtlasMapType::Unknown && !Group->TexturesByType.Contains(MapType))
+			{
+				Group->TexturesByType.Add(MapType, CastChecked<UTexture2D>(Asset));
+			}
+		}
+	}
+
+	// Plan every move first, so clashes within the session are caught before anything is renamed
+	TArray<FPlannedMove> Moves;
+	TArray<FAtlasMaterialRequest> MaterialRequests;
+	TSet<FString> PlannedPaths;
+	for (const TPair<FString, FAtlasOrganizerGroup>& Pair : Groups)
+	{
+		const FAtlasOrganizerGroup& Group = Pair.Value;
+
+		FString MeshPath;
+		FString MaterialPath;
+		FString TexturePath;
+		ComputeDestPaths(Group.BaseName, MeshPath, MaterialPath, TexturePath);
+
+		if (Group.TexturesByType.Num() > 0)
+		{
+			FAtlasMaterialRequest& Request = MaterialRequests.AddDefaulted_GetRef();
+			Request.BaseName = Group.BaseName;
+			Request.PackagePath = MaterialPath;
+			Request.TexturesByType = Group.TexturesByType;
+			PlannedPaths.Add(MaterialPath / (GetPrefixForClass(UMaterialInstanceConstant::StaticClass()) + Group.BaseName));
+		}
+
+		for (UObject* Asset : Group.Assets)
+		{
+			const EDestination Destination = GetDestination(Asset);
+			const FString& Folder = Destination == EDestination::Mesh ? MeshPath : (Destination == EDestination::Material ? MaterialPath : TexturePath);
+			const FString DestPath = Folder / (GetPrefixForClass(Asset->GetClass()) + StripPrefix(Asset->GetName()));
+
+			if (DestPath == Asset->GetOutermost()->GetName())
+			{
+				continue;
+			}
+
+			bool bAlreadyPlanned = false;
+			PlannedPaths.Add(DestPath, &bAlreadyPlanned);
+			if (bAlreadyPlanned || UEditorAssetLibrary::DoesAssetExist(DestPath))
+			{
+				UE_LOG(LogAtlas, Warning, TEXT("Organizer left %s in place: %s is already taken"), *Asset->GetPathName(), *DestPath);
+				continue;
+			}
+
+			Moves.Emplace(Asset, DestPath);
+		}
+	}
+
+	// One rename pass, one redirector fixup and one material build for the whole session
+	FAtlasFixStats Stats;
+	if (Moves.Num() > 0 || MaterialRequests.Num() > 0)
+	{
+		FAtlasFixExecutor::RunBatch(FText::FromString(FString::Printf(TEXT("Atlas: Organize %d Assets"), Organizable.Num())), [&Moves, &MaterialRequests]()
+		{
+			for (const FPlannedMove& Move : Moves)
+			{
+				FAtlasFixExecutor::MoveAsset(Move.Asset->GetPathName(), Move.DestPath);
+			}
+
+			FAtlasMaterialBuilder::BuildMaterials(MaterialRequests);
+		}, false, &Stats);
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Organized %d assets into %d groups in %.2fs (%d moved, %d materials)"),
+		Organizable.Num(), Groups.Num(), FPlatformTime::Seconds() - StartTime, Stats.NumRenamed, MaterialRequests.Num());
+
+	if (OutGroups)
+	{
+		Groups.GenerateValueArray(*OutGroups);
+	}
+}
+
+FString FAtlasOrganizer::SuggestBaseName(const FString& RawName, int32 SuffixStart)
+{
+	using namespace AtlasOrganizer;
+
+	const int32 PrefixLen = RawName.Len() - StripPrefix(RawName).Len();
+	const int32 End = SuffixStart > PrefixLen ? SuffixStart : RawName.Len();
+
+	FString BaseName = RawName.Mid(PrefixLen, End - PrefixLen);
+	while (BaseName.Len() > 0 && IsSeparator(BaseName[BaseName.Len() - 1]))
+	{
+		BaseName.LeftChopInline(1, false);
+	}
+
+	return BaseName.IsEmpty() ? RawName.Mid(PrefixLen) : BaseName;
+}
+
+FString FAtlasOrganizer::StripPrefix(const FString& Name)
+{
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+
+	// Longest match first, so MI_ wins over M_
+	int32 PrefixLen = 0;
+	for (const TPair<FName, FString>& Pair : Settings->NamingPrefixes)
+	{
+		if (Pair.Value.Len() > PrefixLen && Pair.Value.Len() < Name.Len() && Name.StartsWith(Pair.Value, ESearchCase::IgnoreCase))
+		{
+			PrefixLen = Pair.Value.Len();
+		}
+	}
+
+	return Name.RightChop(PrefixLen);
+}
+
+void FAtlasOrganizer::ComputeDestPaths(const FString& BaseName, FString& OutMeshPath, FString& OutMaterialPath, FString& OutTexturePath)
+{
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+
+	OutMeshPath = Settings->MeshRoot.Path / BaseName;
+	OutMaterialPath = Settings->MaterialRoot.Path / BaseName;
+	OutTexturePath = Settings->TextureRoot.Path / BaseName;
+}
+
+FString FAtlasOrganizer::GetPrefixForClass(const UClass* Class)
+{
+	// MaterialInstanceConstant has no prefix of its own but MaterialInstance does
+	for (const UClass* Current = Class; Current; Current = Current->GetSuperClass())
+	{
+		FString Prefix = FAtlasAssetUtils::GetPrefixForAssetType(Current->GetFName());
+		if (!Prefix.IsEmpty())
+		{
+			return Prefix;
+		}
+	}
+
+	return FString();
+}
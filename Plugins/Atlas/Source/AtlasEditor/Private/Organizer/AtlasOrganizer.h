@@ -0,0 +1,121 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "TickableEditorObject.h"
+#include "UObject/ObjectKey.h"
+
+class UFactory;
+class UTexture2D;
+
+/**
+ * Imported assets that share a base name
+ */
+struct FAtlasOrganizerGroup
+{
+	/** Base name without type prefix or map type suffix, e.g. "Rock" for T_Rock_N */
+	FString BaseName;
+
+	/** Meshes, materials and textures of the group */
+	TArray<UObject*> Assets;
+
+	/** Textures by detected map type; the first texture of each type wins */
+	TMap<EAtlasMapType, UTexture2D*> TexturesByType;
+};
+
+/**
+ * Normalizes imported content into MeshRoot, MaterialRoot and TextureRoot
+ *
+ * Import events are collected into one session until no import arrived for OrganizerDebounceSeconds,
+ * so a pack of hundreds of files is organized once rather than once per object. The whole session is
+ * classified in one pass, grouped by base name, and moved with a single batched rename and redirector
+ * fixup through FAtlasFixExecutor. Each asset ends up at <Root>/<BaseName>/<Prefix><Name>, and each
+ * group with textures gets one material instance from FAtlasMaterialBuilder in the same batch.
+ */
+class FAtlasOrganizer : public FTickableEditorObject
+{
+public:
+	FAtlasOrganizer();
+	virtual ~FAtlasOrganizer();
+
+	/**
+	 * Subscribe to import events; waits for engine init if the editor does not exist yet
+	 */
+	void Start();
+
+	/**
+	 * Unsubscribe from import events and drop the pending session
+	 */
+	void Stop();
+
+	/**
+	 * Organize a set of assets as one group: one classification pass, one rename pass, one material build
+	 * Assets already at their destination are left alone, and assets whose destination is taken stay in place.
+	 * @param Assets Assets to organize; types other than meshes, materials and textures are ignored
+	 * @param OutGroups Optional array to fill with the groups by base name
+	 */
+	static void OrganizeAssets(const TArray<UObject*>& Assets, TArray<FAtlasOrganizerGroup>* OutGroups = nullptr);
+
+	/**
+	 * Suggest the base name an asset is grouped under
+	 * @param RawName Asset name as imported
+	 * @param SuffixStart Index of the map type suffix in RawName (see FAtlasMapTypeClassifier::Classify), or INDEX_NONE
+	 * @return RawName without its naming prefix and map type suffix
+	 */
+	static FString SuggestBaseName(const FString& RawName, int32 SuffixStart = INDEX_NONE);
+
+	/**
+	 * Remove a naming prefix from UAtlasSettings::NamingPrefixes, e.g. "T_Rock_N" -> "Rock_N"
+	 * @param Name The name to strip
+	 * @return Name without its prefix
+	 */
+	static FString StripPrefix(const FString& Name);
+
+	/**
+	 * Compute the folders the assets of a group go to
+	 * @param BaseName The group's base name
+	 * @param OutMeshPath Folder for meshes
+	 * @param OutMaterialPath Folder for materials
+	 * @param OutTexturePath Folder for textures
+	 */
+	static void ComputeDestPaths(const FString& BaseName, FString& OutMeshPath, FString& OutMaterialPath, FString& OutTexturePath);
+
+	/**
+	 * Find the naming prefix of a class or its closest configured parent
+	 * @param Class The asset class
+	 * @return The prefix, or an empty string
+	 */
+	static FString GetPrefixForClass(const UClass* Class);
+
+	//~ Begin FTickableEditorObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableEditorObject Interface
+
+private:
+	void BindImportEvents();
+
+	void OnAssetPostImport(UFactory* Factory, UObject* Object);
+	void OnAssetReimport(UObject* Object);
+
+	/** Add an object to the current import session, restarting the debounce timer */
+	void Enqueue(UObject* Object);
+
+private:
+	/** Objects of the current import session, in import order */
+	TArray<TWeakObjectPtr<UObject>> PendingObjects;
+	TSet<FObjectKey> PendingKeys;
+
+	/** Time of the last import event */
+	double LastImportTime;
+
+	bool bRunning;
+
+	FDelegateHandle PostEngineInitHandle;
+	FDelegateHandle PostImportHandle;
+	FDelegateHandle ReimportHandle;
+};
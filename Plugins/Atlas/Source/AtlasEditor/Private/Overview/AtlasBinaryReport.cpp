@@ -0,0 +1,572 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBinaryReport.h"
+#include "AtlasReportWriter.h"
+#include "AtlasRuntime.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace AtlasBinaryReport
+{
+	static constexpr uint32 FileMagic = 0x42525441; // "ATRB"
+	static constexpr uint32 FileVersion = 3;
+
+	static constexpr uint64 SectionAlignment = 8;
+
+	static_assert(sizeof(FAtlasBinaryReportHeader) == 136, "Binary report header layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasBinaryIssueRecord) == 24, "Binary issue record layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasBinaryTextureRecord) == 24, "Binary texture record layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasBinaryMeshRecord) == 24, "Binary mesh record layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasBinaryLevelRecord) == 16, "Binary level record layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasBinaryShaderRecord) == 40, "Binary shader record layout changed, bump FileVersion");
+
+	/** Write an array and pad the archive to the next section boundary */
+	template <typename ElementType>
+	static void WriteSection(FArchive& Ar, const TArray<ElementType>& Elements)
+	{
+		Ar.Serialize(const_cast<ElementType*>(Elements.GetData()), Elements.Num() * sizeof(ElementType));
+
+		static const uint8 Zeros[SectionAlignment] = {};
+		const int64 Padding = Align(Ar.Tell(), SectionAlignment) - Ar.Tell();
+		Ar.Serialize(const_cast<uint8*>(Zeros), Padding);
+	}
+
+	/** Check that Count elements of ElementType starting at Offset lie inside the file */
+	template <typename ElementType>
+	static bool IsSectionInBounds(uint64 Offset, uint64 Count, int64 DataSize)
+	{
+		return Offset % SectionAlignment == 0 && Offset <= static_cast<uint64>(DataSize)
+			&& Count <= (static_cast<uint64>(DataSize) - Offset) / sizeof(ElementType);
+	}
+}
+
+// FAtlasBinaryReportWriter
+
+FAtlasBinaryReportWriter::FAtlasBinaryReportWriter()
+	: TotalProjectBytes(0)
+	, TotalVRAMBytes(0)
+	, ReclaimableBytes(0)
+	, ReclaimableVRAMBytes(0)
+{
+	StringOffsets.Add(0);
+}
+
+uint32 FAtlasBinaryReportWriter::Intern(const FString& String)
+{
+	if (const uint32* ExistingId = StringIds.Find(String))
+	{
+		return *ExistingId;
+	}
+
+	const uint32 NewId = StringOffsets.Num() - 1;
+
+	FTCHARToUTF8 Utf8(*String, String.Len());
+	StringData.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	StringOffsets.Add(StringData.Num());
+
+	StringIds.Add(String, NewId);
+	return NewId;
+}
+
+void FAtlasBinaryReportWriter::InternPath(const FString& Path, uint32& OutDir, uint32& OutLeaf)
+{
+	int32 SlashIndex = INDEX_NONE;
+	if (Path.FindLastChar(TEXT('/'), SlashIndex) && SlashIndex > 0)
+	{
+		OutDir = Intern(Path.Left(SlashIndex));
+		OutLeaf = Intern(Path.Mid(SlashIndex + 1));
+	}
+	else
+	{
+		OutDir = Intern(FString());
+		OutLeaf = Intern(Path);
+	}
+}
+
+void FAtlasBinaryReportWriter::WriteIssue(const FAtlasIssue& Issue)
+{
+	FString Template;
+	TArray<FString> MessageArgs;
+	FAtlasIssueStore::SplitMessage(Issue.Message, Template, MessageArgs);
+
+	// Pathological messages with more arguments than a record can index are stored verbatim
+	if (MessageArgs.Num() > MAX_uint16)
+	{
+		Template = Issue.Message;
+		MessageArgs.Reset();
+	}
+
+	FAtlasBinaryIssueRecord& Record = Issues.AddZeroed_GetRef();
+	InternPath(Issue.AssetPath, Record.PathDir, Record.PathLeaf);
+	Record.RuleName = Intern(Issue.RuleName.ToString());
+	Record.MessageTemplate = Intern(Template);
+	Record.FirstArg = Args.Num();
+	Record.NumArgs = static_cast<uint16>(MessageArgs.Num());
+	Record.Severity = static_cast<uint8>(Issue.Severity);
+	Record.bCanFix = Issue.bCanFix ? 1 : 0;
+
+	for (const FString& Arg : MessageArgs)
+	{
+		Args.Add(Intern(Arg));
+	}
+}
+
+void FAtlasBinaryReportWriter::WriteTexture(const FAtlasTextureStat& Texture)
+{
+	FAtlasBinaryTextureRecord& Record = Textures.AddZeroed_GetRef();
+	InternPath(Texture.Path, Record.PathDir, Record.PathLeaf);
+	Record.PixelFormat = Intern(Texture.PixelFormat);
+	Record.MaxDimension = Texture.MaxDimension;
+	Record.VRAMBytes = Texture.VRAMBytes;
+}
+
+void FAtlasBinaryReportWriter::WriteMesh(const FAtlasMeshStat& Mesh)
+{
+	FAtlasBinaryMeshRecord& Record = Meshes.AddZeroed_GetRef();
+	InternPath(Mesh.Path, Record.PathDir, Record.PathLeaf);
+	Record.NumLODs = Mesh.NumLODs;
+	Record.TriangleCount = Mesh.TriangleCount;
+}
+
+void FAtlasBinaryReportWriter::WriteLevel(const FAtlasLevelStat& Level)
+{
+	FAtlasBinaryLevelRecord& Record = Levels.AddZeroed_GetRef();
+	InternPath(Level.Path, Record.PathDir, Record.PathLeaf);
+	Record.TotalBytes = Level.TotalBytes;
+}
+
+void FAtlasBinaryReportWriter::WriteShader(const FAtlasShaderStat& Shader)
+{
+	FAtlasBinaryShaderRecord& Record = Shaders.AddZeroed_GetRef();
+	InternPath(Shader.Path, Record.PathDir, Record.PathLeaf);
+	Record.NumInstances = Shader.NumInstances;
+	Record.NumStaticCombinations = Shader.NumStaticCombinations;
+	Record.NumVertexFactories = Shader.NumVertexFactories;
+	Record.EstimatedPermutations = Shader.EstimatedPermutations;
+	Record.EstimatedBytes = Shader.EstimatedBytes;
+}
+
+void FAtlasBinaryReportWriter::SetTotals(int64 InTotalProjectBytes, int64 InTotalVRAMBytes, int64 InReclaimableBytes, int64 InReclaimableVRAMBytes)
+{
+	TotalProjectBytes = InTotalProjectBytes;
+	TotalVRAMBytes = InTotalVRAMBytes;
+	ReclaimableBytes = InReclaimableBytes;
+	ReclaimableVRAMBytes = InReclaimableVRAMBytes;
+}
+
+bool FAtlasBinaryReportWriter::Save(const FString& FilePath) const
+{
+	using namespace AtlasBinaryReport;
+
+	FAtlasBinaryReportHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FileMagic;
+	Header.Version = FileVersion;
+	Header.NumStrings = StringOffsets.Num() - 1;
+	Header.NumArgs = Args.Num();
+	Header.NumIssues = Issues.Num();
+	Header.NumTextures = Textures.Num();
+	Header.NumMeshes = Meshes.Num();
+	Header.NumLevels = Levels.Num();
+	Header.NumShaders = Shaders.Num();
+	Header.TotalProjectBytes = TotalProjectBytes;
+	Header.TotalVRAMBytes = TotalVRAMBytes;
+	Header.ReclaimableBytes = ReclaimableBytes;
+	Header.ReclaimableVRAMBytes = ReclaimableVRAMBytes;
+
+	uint64 Offset = Align(sizeof(FAtlasBinaryReportHeader), SectionAlignment);
+	auto PlaceSection = [&Offset](uint64& OutSectionOffset, uint64 SectionSize)
+	{
+		OutSectionOffset = Offset;
+		Offset = Align(Offset + SectionSize, SectionAlignment);
+	};
+
+	PlaceSection(Header.StringOffsetsOffset, StringOffsets.Num() * sizeof(uint32));
+	PlaceSection(Header.StringDataOffset, StringData.Num());
+	PlaceSection(Header.ArgsOffset, Args.Num() * sizeof(uint32));
+	PlaceSection(Header.IssuesOffset, Issues.Num() * sizeof(FAtlasBinaryIssueRecord));
+	PlaceSection(Header.TexturesOffset, Textures.Num() * sizeof(FAtlasBinaryTextureRecord));
+	PlaceSection(Header.MeshesOffset, Meshes.Num() * sizeof(FAtlasBinaryMeshRecord));
+	PlaceSection(Header.LevelsOffset, Levels.Num() * sizeof(FAtlasBinaryLevelRecord));
+	PlaceSection(Header.ShadersOffset, Shaders.Num() * sizeof(FAtlasBinaryShaderRecord));
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Ar)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to create Atlas report %s"), *FilePath);
+		return false;
+	}
+
+	Ar->Serialize(&Header, sizeof(Header));
+	WriteSection(*Ar, StringOffsets);
+	WriteSection(*Ar, StringData);
+	WriteSection(*Ar, Args);
+	WriteSection(*Ar, Issues);
+	WriteSection(*Ar, Textures);
+	WriteSection(*Ar, Meshes);
+	WriteSection(*Ar, Levels);
+	WriteSection(*Ar, Shaders);
+
+	check(Ar->IsError() || static_cast<uint64>(Ar->Tell()) == Offset);
+
+	const bool bSuccess = Ar->Close();
+	if (!bSuccess)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas report %s"), *FilePath);
+	}
+	return bSuccess;
+}
+
+bool FAtlasBinaryReportWriter::WriteReport(const FAtlasReport& Report, const FString& FilePath)
+{
+	FAtlasBinaryReportWriter Writer;
+
+	for (const FAtlasIssue& Issue : Report.Issues)
+	{
+		Writer.WriteIssue(Issue);
+	}
+
+	for (const FAtlasTextureStat& Texture : Report.Textures)
+	{
+		Writer.WriteTexture(Texture);
+	}
+
+	for (const FAtlasMeshStat& Mesh : Report.Meshes)
+	{
+		Writer.WriteMesh(Mesh);
+	}
+
+	for (const FAtlasLevelStat& Level : Report.Levels)
+	{
+		Writer.WriteLevel(Level);
+	}
+
+	for (const FAtlasShaderStat& Shader : Report.Shaders)
+	{
+		Writer.WriteShader(Shader);
+	}
+
+	Writer.SetTotals(Report.TotalProjectBytes, Report.TotalVRAMBytes, Report.ReclaimableBytes, Report.ReclaimableVRAMBytes);
+	return Writer.Save(FilePath);
+}
+
+// FAtlasBinaryReportView
+
+FAtlasBinaryReportView::FAtlasBinaryReportView()
+{
+	Reset();
+}
+
+FAtlasBinaryReportView::~FAtlasBinaryReportView()
+{
+	// The region must be released before the handle that owns the mapping
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+void FAtlasBinaryReportView::Reset()
+{
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackData.Empty();
+
+	Data = nullptr;
+	DataSize = 0;
+	Header = nullptr;
+	StringOffsets = nullptr;
+	StringData = nullptr;
+	Args = nullptr;
+	Issues = nullptr;
+	Textures = nullptr;
+	Meshes = nullptr;
+	Levels = nullptr;
+	Shaders = nullptr;
+}
+
+bool FAtlasBinaryReportView::IsBinaryReport(const FString& FilePath)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Ar || Ar->TotalSize() < static_cast<int64>(sizeof(uint32)))
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	Ar->Serialize(&Magic, sizeof(Magic));
+	return Magic == AtlasBinaryReport::FileMagic;
+}
+
+bool FAtlasBinaryReportView::Open(const FString& FilePath)
+{
+	Reset();
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (MappedHandle && MappedHandle->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackData, *FilePath))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to open Atlas report %s"), *FilePath);
+			return false;
+		}
+
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+
+	if (!Initialize())
+	{
+		UE_LOG(LogAtlas, Error, TEXT("%s is not a valid Atlas binary report"), *FilePath);
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FAtlasBinaryReportView::Initialize()
+{
+	using namespace AtlasBinaryReport;
+
+	if (DataSize < static_cast<int64>(sizeof(FAtlasBinaryReportHeader)))
+	{
+		return false;
+	}
+
+	const FAtlasBinaryReportHeader* FileHeader = reinterpret_cast<const FAtlasBinaryReportHeader*>(Data);
+	if (FileHeader->Magic != FileMagic || FileHeader->Version != FileVersion)
+	{
+		return false;
+	}
+
+	const bool bInBounds =
+		IsSectionInBounds<uint32>(FileHeader->StringOffsetsOffset, static_cast<uint64>(FileHeader->NumStrings) + 1, DataSize) &&
+		IsSectionInBounds<uint32>(FileHeader->ArgsOffset, FileHeader->NumArgs, DataSize) &&
+		IsSectionInBounds<FAtlasBinaryIssueRecord>(FileHeader->IssuesOffset, FileHeader->NumIssues, DataSize) &&
+		IsSectionInBounds<FAtlasBinaryTextureRecord>(FileHeader->TexturesOffset, FileHeader->NumTextures, DataSize) &&
+		IsSectionInBounds<FAtlasBinaryMeshRecord>(FileHeader->MeshesOffset, FileHeader->NumMeshes, DataSize) &&
+		IsSectionInBounds<FAtlasBinaryLevelRecord>(FileHeader->LevelsOffset, FileHeader->NumLevels, DataSize) &&
+		IsSectionInBounds<FAtlasBinaryShaderRecord>(FileHeader->ShadersOffset, FileHeader->NumShaders, DataSize);
+	if (!bInBounds)
+	{
+		return false;
+	}
+
+	StringOffsets = reinterpret_cast<const uint32*>(Data + FileHeader->StringOffsetsOffset);
+
+	const uint64 StringDataSize = StringOffsets[FileHeader->NumStrings];
+	if (!IsSectionInBounds<uint8>(FileHeader->StringDataOffset, StringDataSize, DataSize))
+	{
+		return false;
+	}
+
+	Header = FileHeader;
+	StringData = Data + Header->StringDataOffset;
+	Args = reinterpret_cast<const uint32*>(Data + Header->ArgsOffset);
+	Issues = reinterpret_cast<const FAtlasBinaryIssueRecord*>(Data + Header->IssuesOffset);
+	Textures = reinterpret_cast<const FAtlasBinaryTextureRecord*>(Data + Header->TexturesOffset);
+	Meshes = reinterpret_cast<const FAtlasBinaryMeshRecord*>(Data + Header->MeshesOffset);
+	Levels = reinterpret_cast<const FAtlasBinaryLevelRecord*>(Data + Header->LevelsOffset);
+	Shaders = reinterpret_cast<const FAtlasBinaryShaderRecord*>(Data + Header->ShadersOffset);
+	return true;
+}
+
+FString FAtlasBinaryReportView::GetString(uint32 StringId) const
+{
+	if (!Header || StringId >= Header->NumStrings)
+	{
+		return FString();
+	}
+
+	const uint32 Start = StringOffsets[StringId];
+	const uint32 End = StringOffsets[StringId + 1];
+	if (End < Start || End > StringOffsets[Header->NumStrings])
+	{
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(StringData + Start), End - Start);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+FString FAtlasBinaryReportView::GetPath(uint32 PathDir, uint32 PathLeaf) const
+{
+	FString Dir = GetString(PathDir);
+	if (Dir.IsEmpty())
+	{
+		return GetString(PathLeaf);
+	}
+
+	Dir.AppendChar(TEXT('/'));
+	Dir.Append(GetString(PathLeaf));
+	return Dir;
+}
+
+FString FAtlasBinaryReportView::FormatMessage(const FAtlasBinaryIssueRecord& Record) const
+{
+	const FString Template = GetString(Record.MessageTemplate);
+	const bool bArgsInBounds = static_cast<uint64>(Record.FirstArg) + Record.NumArgs <= Header->NumArgs;
+
+	FString Message;
+	Message.Reserve(Template.Len());
+
+	int32 ArgIndex = 0;
+	for (const TCHAR Char : Template)
+	{
+		if (Char != FAtlasIssueStore::ArgMarker)
+		{
+			Message.AppendChar(Char);
+		}
+		else if (bArgsInBounds && ArgIndex < Record.NumArgs)
+		{
+			Message.Append(GetString(Args[Record.FirstArg + ArgIndex++]));
+		}
+	}
+
+	return Message;
+}
+
+FAtlasIssue FAtlasBinaryReportView::GetIssue(int32 Index) const
+{
+	const FAtlasBinaryIssueRecord& Record = Issues[Index];
+
+	return FAtlasIssue(
+		GetPath(Record.PathDir, Record.PathLeaf),
+		FName(*GetString(Record.RuleName)),
+		static_cast<EAtlasSeverity>(FMath::Min<uint8>(Record.Severity, static_cast<uint8>(EAtlasSeverity::Error))),
+		FormatMessage(Record),
+		Record.bCanFix != 0
+	);
+}
+
+FAtlasTextureStat FAtlasBinaryReportView::GetTexture(int32 Index) const
+{
+	const FAtlasBinaryTextureRecord& Record = Textures[Index];
+
+	FAtlasTextureStat Texture;
+	Texture.Path = GetPath(Record.PathDir, Record.PathLeaf);
+	Texture.PixelFormat = GetString(Record.PixelFormat);
+	Texture.MaxDimension = Record.MaxDimension;
+	Texture.VRAMBytes = Record.VRAMBytes;
+	return Texture;
+}
+
+FAtlasMeshStat FAtlasBinaryReportView::GetMesh(int32 Index) const
+{
+	const FAtlasBinaryMeshRecord& Record = Meshes[Index];
+
+	FAtlasMeshStat Mesh;
+	Mesh.Path = GetPath(Record.PathDir, Record.PathLeaf);
+	Mesh.NumLODs = Record.NumLODs;
+	Mesh.TriangleCount = Record.TriangleCount;
+	return Mesh;
+}
+
+FAtlasLevelStat FAtlasBinaryReportView::GetLevel(int32 Index) const
+{
+	const FAtlasBinaryLevelRecord& Record = Levels[Index];
+
+	FAtlasLevelStat Level;
+	Level.Path = GetPath(Record.PathDir, Record.PathLeaf);
+	Level.TotalBytes = Record.TotalBytes;
+	return Level;
+}
+
+FAtlasShaderStat FAtlasBinaryReportView::GetShader(int32 Index) const
+{
+	const FAtlasBinaryShaderRecord& Record = Shaders[Index];
+
+	FAtlasShaderStat Shader;
+	Shader.Path = GetPath(Record.PathDir, Record.PathLeaf);
+	Shader.NumInstances = Record.NumInstances;
+	Shader.NumStaticCombinations = Record.NumStaticCombinations;
+	Shader.NumVertexFactories = Record.NumVertexFactories;
+	Shader.EstimatedPermutations = Record.EstimatedPermutations;
+	Shader.EstimatedBytes = Record.EstimatedBytes;
+	return Shader;
+}
+
+void FAtlasBinaryReportView::ToReport(FAtlasReport& OutReport) const
+{
+	OutReport.Issues.Reserve(OutReport.Issues.Num() + NumIssues());
+	for (int32 Index = 0; Index < NumIssues(); ++Index)
+	{
+		OutReport.Issues.Add(GetIssue(Index));
+	}
+
+	for (int32 Index = 0; Index < NumTextures(); ++Index)
+	{
+		OutReport.Textures.Add(GetTexture(Index));
+	}
+
+	for (int32 Index = 0; Index < NumMeshes(); ++Index)
+	{
+		OutReport.Meshes.Add(GetMesh(Index));
+	}
+
+	for (int32 Index = 0; Index < NumLevels(); ++Index)
+	{
+		OutReport.Levels.Add(GetLevel(Index));
+	}
+
+	for (int32 Index = 0; Index < NumShaders(); ++Index)
+	{
+		OutReport.Shaders.Add(GetShader(Index));
+	}
+
+	OutReport.TotalProjectBytes += GetTotalProjectBytes();
+	OutReport.TotalVRAMBytes += GetTotalVRAMBytes();
+	OutReport.ReclaimableBytes += GetReclaimableBytes();
+	OutReport.ReclaimableVRAMBytes += GetReclaimableVRAMBytes();
+}
+
+bool FAtlasBinaryReportView::ToJson(const FString& FilePath, bool bCompress) const
+{
+	FAtlasReportWriter Writer;
+	if (!Writer.Open(FilePath, bCompress))
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < NumIssues(); ++Index)
+	{
+		Writer.WriteIssue(GetIssue(Index));
+	}
+
+	for (int32 Index = 0; Index < NumTextures(); ++Index)
+	{
+		Writer.WriteTexture(GetTexture(Index));
+	}
+
+	for (int32 Index = 0; Index < NumMeshes(); ++Index)
+	{
+		Writer.WriteMesh(GetMesh(Index));
+	}
+
+	for (int32 Index = 0; Index < NumLevels(); ++Index)
+	{
+		Writer.WriteLevel(GetLevel(Index));
+	}
+
+	for (int32 Index = 0; Index < NumShaders(); ++Index)
+	{
+		Writer.WriteShader(GetShader(Index));
+	}
+
+	Writer.SetTotals(GetTotalProjectBytes(), GetTotalVRAMBytes(), GetReclaimableBytes(), GetReclaimableVRAMBytes());
+	return Writer.Close();
+}
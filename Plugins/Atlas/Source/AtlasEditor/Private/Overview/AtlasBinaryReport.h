@@ -0,0 +1,249 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "AtlasIssueStore.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Compact binary report format (.atlasreport)
+ *
+ * Layout: header, string table (offsets + UTF-8 data), message argument ids, then one array of
+ * fixed-size records per section. Sections are 8-byte aligned and stored little-endian.
+ * Asset paths are interned as directory + leaf and messages as a template plus argument strings
+ * (see FAtlasIssueStore::SplitMessage), so repeated paths, rule names and message shapes are stored once.
+ */
+struct FAtlasBinaryReportHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 NumStrings;
+	uint32 NumArgs;
+	uint32 NumIssues;
+	uint32 NumTextures;
+	uint32 NumMeshes;
+	uint32 NumLevels;
+	uint32 NumShaders;
+	uint32 Padding;
+	int64 TotalProjectBytes;
+	int64 TotalVRAMBytes;
+	int64 ReclaimableBytes;
+	int64 ReclaimableVRAMBytes;
+
+	/** NumStrings + 1 uint32 offsets into the string data; string I spans [Offsets[I], Offsets[I + 1]) */
+	uint64 StringOffsetsOffset;
+	uint64 StringDataOffset;
+	uint64 ArgsOffset;
+	uint64 IssuesOffset;
+	uint64 TexturesOffset;
+	uint64 MeshesOffset;
+	uint64 LevelsOffset;
+	uint64 ShadersOffset;
+};
+
+struct FAtlasBinaryIssueRecord
+{
+	uint32 PathDir;
+	uint32 PathLeaf;
+	uint32 RuleName;
+	uint32 MessageTemplate;
+	uint32 FirstArg;
+	uint16 NumArgs;
+	uint8 Severity;
+	uint8 bCanFix;
+};
+
+struct FAtlasBinaryTextureRecord
+{
+	uint32 PathDir;
+	uint32 PathLeaf;
+	uint32 PixelFormat;
+	int32 MaxDimension;
+	int64 VRAMBytes;
+};
+
+struct FAtlasBinaryMeshRecord
+{
+	uint32 PathDir;
+	uint32 PathLeaf;
+	int32 NumLODs;
+	uint32 Padding;
+	int64 TriangleCount;
+};
+
+struct FAtlasBinaryLevelRecord
+{
+	uint32 PathDir;
+	uint32 PathLeaf;
+	int64 TotalBytes;
+};
+
+struct FAtlasBinaryShaderRecord
+{
+	uint32 PathDir;
+	uint32 PathLeaf;
+	int32 NumInstances;
+	int32 NumStaticCombinations;
+	int32 NumVertexFactories;
+	uint32 Padding;
+	int64 EstimatedPermutations;
+	int64 EstimatedBytes;
+};
+
+/**
+ * Builds a binary report in memory and saves it in one write
+ * Only interned strings and fixed-size records are kept, so this stays small even for large reports.
+ */
+class ATLASEDITOR_API FAtlasBinaryReportWriter
+{
+public:
+	FAtlasBinaryReportWriter();
+
+	/** Append one record */
+	void WriteIssue(const FAtlasIssue& Issue);
+	void WriteTexture(const FAtlasTextureStat& Texture);
+	void WriteMesh(const FAtlasMeshStat& Mesh);
+	void WriteLevel(const FAtlasLevelStat& Level);
+	void WriteShader(const FAtlasShaderStat& Shader);
+
+	/**
+	 * Set the report totals
+	 */
+	void SetTotals(int64 TotalProjectBytes, int64 TotalVRAMBytes, int64 ReclaimableBytes, int64 ReclaimableVRAMBytes);
+
+	/**
+	 * Write the report to disk, creating the directory if needed
+	 * @param FilePath Destination file
+	 * @return True if the file was written
+	 */
+	bool Save(const FString& FilePath) const;
+
+	/**
+	 * Write a complete in-memory report
+	 * @param Report The report to write
+	 * @param FilePath Destination file
+	 * @return True if the file was written
+	 */
+	static bool WriteReport(const FAtlasReport& Report, const FString& FilePath);
+
+private:
+	/** Get the id of a string, adding it to the table if new */
+	uint32 Intern(const FString& String);
+
+	/** Intern an asset path as directory + leaf */
+	void InternPath(const FString& Path, uint32& OutDir, uint32& OutLeaf);
+
+	/** Case-sensitive: asset names that differ only in case are distinct */
+	TMap<FString, uint32, FDefaultSetAllocator, TAtlasCaseSensitiveKeyFuncs<uint32>> StringIds;
+	TArray<uint32> StringOffsets;
+	TArray<uint8> StringData;
+	TArray<uint32> Args;
+	TArray<FAtlasBinaryIssueRecord> Issues;
+	TArray<FAtlasBinaryTextureRecord> Textures;
+	TArray<FAtlasBinaryMeshRecord> Meshes;
+	TArray<FAtlasBinaryLevelRecord> Levels;
+	TArray<FAtlasBinaryShaderRecord> Shaders;
+	int64 TotalProjectBytes;
+	int64 TotalVRAMBytes;
+	int64 ReclaimableBytes;
+	int64 ReclaimableVRAMBytes;
+};
+
+/**
+ * Read-only view of a binary report file
+ * The file is memory-mapped where the platform supports it; records are read in place and
+ * strings are only decoded when requested.
+ */
+class FAtlasBinaryReportView
+{
+public:
+	FAtlasBinaryReportView();
+	~FAtlasBinaryReportView();
+
+	/**
+	 * Map a report file and validate its header
+	 * @param FilePath The report to open
+	 * @return True if the file is a valid binary report
+	 */
+	bool Open(const FString& FilePath);
+
+	/**
+	 * Check whether a file starts with the binary report magic
+	 */
+	static bool IsBinaryReport(const FString& FilePath);
+
+	int32 NumIssues() const { return Header ? Header->NumIssues : 0; }
+	int32 NumTextures() const { return Header ? Header->NumTextures : 0; }
+	int32 NumMeshes() const { return Header ? Header->NumMeshes : 0; }
+	int32 NumLevels() const { return Header ? Header->NumLevels : 0; }
+	int32 NumShaders() const { return Header ? Header->NumShaders : 0; }
+	int64 GetTotalProjectBytes() const { return Header ? Header->TotalProjectBytes : 0; }
+	int64 GetTotalVRAMBytes() const { return Header ? Header->TotalVRAMBytes : 0; }
+	int64 GetReclaimableBytes() const { return Header ? Header->ReclaimableBytes : 0; }
+	int64 GetReclaimableVRAMBytes() const { return Header ? Header->ReclaimableVRAMBytes : 0; }
+
+	/** Raw record access, no string decoding */
+	const FAtlasBinaryIssueRecord& GetIssueRecord(int32 Index) const { return Issues[Index]; }
+
+	/** Decode one string from the table, empty if the id is out of range */
+	FString GetString(uint32 StringId) const;
+
+	/** Rebuild a full asset path */
+	FString GetPath(uint32 PathDir, uint32 PathLeaf) const;
+
+	/** Rebuild the message of an issue from its template and arguments */
+	FString FormatMessage(const FAtlasBinaryIssueRecord& Record) const;
+
+	/** Materialize records */
+	FAtlasIssue GetIssue(int32 Index) const;
+	FAtlasTextureStat GetTexture(int32 Index) const;
+	FAtlasMeshStat GetMesh(int32 Index) const;
+	FAtlasLevelStat GetLevel(int32 Index) const;
+	FAtlasShaderStat GetShader(int32 Index) const;
+
+	/**
+	 * Append every record to an in-memory report
+	 */
+	void ToReport(FAtlasReport& OutReport) const;
+
+	/**
+	 * Convert to the JSON format, streaming one record at a time
+	 * @param FilePath Destination file
+	 * @param bCompress Gzip the output
+	 * @return True if the file was written
+	 */
+	bool ToJson(const FString& FilePath, bool bCompress) const;
+
+private:
+	/** Resolve section pointers and check they lie inside the file */
+	bool Initialize();
+
+	void Reset();
+
+	// Non-copyable
+	FAtlasBinaryReportView(const FAtlasBinaryReportView&) = delete;
+	FAtlasBinaryReportView& operator=(const FAtlasBinaryReportView&) = delete;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** File contents when memory mapping is not available */
+	TArray<uint8> FallbackData;
+
+	const uint8* Data;
+	int64 DataSize;
+
+	const FAtlasBinaryReportHeader* Header;
+	const uint32* StringOffsets;
+	const uint8* StringData;
+	const uint32* Args;
+	const FAtlasBinaryIssueRecord* Issues;
+	const FAtlasBinaryTextureRecord* Textures;
+	const FAtlasBinaryMeshRecord* Meshes;
+	const FAtlasBinaryLevelRecord* Levels;
+	const FAtlasBinaryShaderRecord* Shaders;
+};
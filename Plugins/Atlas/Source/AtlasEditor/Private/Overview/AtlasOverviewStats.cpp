@@ -0,0 +1,309 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasOverviewStats.h"
+#include "Core/AtlasTextureUtils.h"
+#include "Core/AtlasMeshUtils.h"
+#include "AtlasRuntime.h"
+#include "AtlasSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+namespace AtlasOverviewStats
+{
+	/** Items per ParallelFor task; tag parsing is cheap, so tasks must be coarse */
+	static constexpr int32 ParallelChunkSize = 256;
+
+	/** Suffix of the package holding a level's baked lighting and other built data */
+	static const TCHAR* BuiltDataSuffix = TEXT("_BuiltData");
+
+	/** Run Body for every index in [0, Num) on worker threads, in chunks */
+	static void ParallelForChunked(int32 Num, TFunctionRef<void(int32)> Body)
+	{
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelChunkSize);
+		ParallelFor(NumChunks, [Num, &Body](int32 ChunkIndex)
+		{
+			const int32 End = FMath::Min((ChunkIndex + 1) * ParallelChunkSize, Num);
+			for (int32 Index = ChunkIndex * ParallelChunkSize; Index < End; ++Index)
+			{
+				Body(Index);
+			}
+		});
+	}
+}
+
+void FAtlasOverviewStats::CollectAll(FAtlasReport& OutReport, FAtlasOverviewCollectStats* OutStats)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// On-disk data only: registry tags are what the stats are computed from, and it avoids enumerating loaded objects
+	FARFilter Filter;
+	Filter.PackagePaths.Add("/Game");
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	Collect(Assets, OutReport, OutStats);
+}
+
+void FAtlasOverviewStats::Collect(const TArray<FAssetData>& Assets, FAtlasReport& OutReport, FAtlasOverviewCollectStats* OutStats)
+{
+	using namespace AtlasOverviewStats;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FAtlasOverviewCollectStats Stats;
+	Stats.NumAssets = Assets.Num();
+
+	const FName TextureClassName = UTexture2D::StaticClass()->GetFName();
+	const FName MeshClassName = UStaticMesh::StaticClass()->GetFName();
+	const FName WorldClassName = UWorld::StaticClass()->GetFName();
+
+	// Split assets by class and assign every asset the index of its distinct package
+	TMap<FName, int32> PackageIndices;
+	PackageIndices.Reserve(Assets.Num());
+	TArray<FName> Packages;
+	TArray<int32> AssetPackages;
+	AssetPackages.SetNumUninitialized(Assets.Num());
+	TArray<int32> TextureAssets;
+	TArray<int32> MeshAssets;
+	TArray<int32> LevelAssets;
+
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
+	{
+		const FAssetData& AssetData = Assets[AssetIndex];
+
+		if (const int32* ExistingIndex = PackageIndices.Find(AssetData.PackageName))
+		{
+			AssetPackages[AssetIndex] = *ExistingIndex;
+		}
+		else
+		{
+			AssetPackages[AssetIndex] = PackageIndices.Add(AssetData.PackageName, Packages.Add(AssetData.PackageName));
+		}
+
+		if (AssetData.AssetClass == TextureClassName)
+		{
+			TextureAssets.Add(AssetIndex);
+		}
+		else if (AssetData.AssetClass == MeshClassName)
+		{
+			MeshAssets.Add(AssetIndex);
+		}
+		else if (AssetData.AssetClass == WorldClassName)
+		{
+			LevelAssets.Add(AssetIndex);
+		}
+	}
+
+	Stats.NumPackages = Packages.Num();
+
+	TArray<int64> PackageSizes;
+	PackageSizes.SetNumZeroed(Packages.Num());
+	ParallelForChunked(Packages.Num(), [&Packages, &PackageSizes](int32 PackageIndex)
+	{
+		PackageSizes[PackageIndex] = GetPackageDiskSize(Packages[PackageIndex]);
+	});
+
+	OutReport.Textures.Reset();
+	OutReport.Textures.SetNum(TextureAssets.Num());
+	OutReport.Meshes.Reset();
+	OutReport.Meshes.SetNum(MeshAssets.Num());
+	OutReport.Levels.Reset();
+	OutReport.Levels.SetNum(LevelAssets.Num());
+
+	// One flag per entry; written by exactly one worker each
+	TArray<bool> TextureNeedsLoad;
+	TextureNeedsLoad.SetNumZeroed(TextureAssets.Num());
+	TArray<bool> MeshNeedsLoad;
+	MeshNeedsLoad.SetNumZeroed(MeshAssets.Num());
+
+	// Resolved on the game thread; the cost model itself only reads them
+	const EAtlasCostPlatform Platform = UAtlasSettings::Get()->CostModelPlatform;
+	const UTextureLODSettings* LODSettings = FAtlasTextureUtils::GetLODSettings(Platform);
+
+	const auto SetTextureCost = [Platform, LODSettings](FAtlasTextureStat& Stat, const FAtlasTextureCostParams& Params)
+	{
+		const FAtlasTextureCost Cost = FAtlasTextureUtils::EstimateCost(Params, Platform, LODSettings);
+		Stat.MaxDimension = FMath::Max(Cost.SizeX, Cost.SizeY);
+		Stat.VRAMBytes = Cost.TotalBytes;
+		Stat.PixelFormat = GetPixelFormatString(Cost.PixelFormat);
+	};
+
+	ParallelForChunked(TextureAssets.Num(), [&](int32 Index)
+	{
+		const FAssetData& AssetData = Assets[TextureAssets[Index]];
+		FAtlasTextureStat& Stat = OutReport.Textures[Index];
+		Stat.Path = AssetData.ObjectPath.ToString();
+
+		FAtlasTextureCostParams Params;
+		if (FAtlasTextureUtils::GetCostParamsFromTags(AssetData, Params))
+		{
+			SetTextureCost(Stat, Params);
+		}
+		else
+		{
+			TextureNeedsLoad[Index] = true;
+		}
+	});
+
+	ParallelForChunked(MeshAssets.Num(), [&](int32 Index)
+	{
+		const FAssetData& AssetData = Assets[MeshAssets[Index]];
+		FAtlasMeshStat& Stat = OutReport.Meshes[Index];
+		Stat.Path = AssetData.ObjectPath.ToString();
+
+		if (!FAtlasMeshUtils::GetTriangleCountFromTags(AssetData, Stat.TriangleCount) ||
+			!FAtlasMeshUtils::GetLODCountFromTags(AssetData, Stat.NumLODs))
+		{
+			MeshNeedsLoad[Index] = true;
+		}
+	});
+
+	ParallelForChunked(LevelAssets.Num(), [&](int32 Index)
+	{
+		const FAssetData& AssetData = Assets[LevelAssets[Index]];
+		FAtlasLevelStat& Stat = OutReport.Levels[Index];
+		Stat.Path = AssetData.ObjectPath.ToString();
+
+		// Built data lives in a sibling package that is usually larger than the map itself
+		const FName BuiltDataName(*(AssetData.PackageName.ToString() + BuiltDataSuffix));
+		const int32* BuiltDataIndex = PackageIndices.Find(BuiltDataName);
+		Stat.TotalBytes = PackageSizes[AssetPackages[LevelAssets[Index]]] + (BuiltDataIndex ? PackageSizes[*BuiltDataIndex] : GetPackageDiskSize(BuiltDataName));
+	});
+
+	// Assets saved before their class registered a tag need loading, which must happen on the game thread
+	for (int32 Index = 0; Index < TextureAssets.Num(); ++Index)
+	{
+		if (TextureNeedsLoad[Index])
+		{
+			if (const UTexture2D* Texture = Cast<UTexture2D>(Assets[TextureAssets[Index]].GetAsset()))
+			{
+				FAtlasTextureCostParams Params;
+				FAtlasTextureUtils::GetCostParams(Texture, Params);
+				SetTextureCost(OutReport.Textures[Index], Params);
+				++Stats.NumLoaded;
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < MeshAssets.Num(); ++Index)
+	{
+		if (MeshNeedsLoad[Index])
+		{
+			if (const UStaticMesh* Mesh = Cast<UStaticMesh>(Assets[MeshAssets[Index]].GetAsset()))
+			{
+				FAtlasMeshStat& Stat = OutReport.Meshes[Index];
+				Stat.TriangleCount = FAtlasMeshUtils::GetTriangleCount(Mesh);
+				Stat.NumLODs = FAtlasMeshUtils::GetLODCount(Mesh);
+				++Stats.NumLoaded;
+			}
+		}
+	}
+
+	OutReport.TotalProjectBytes = 0;
+	for (const int64 PackageSize : PackageSizes)
+	{
+		OutReport.TotalProjectBytes += PackageSize;
+	}
+
+	OutReport.TotalVRAMBytes = 0;
+	for (const FAtlasTextureStat& Texture : OutReport.Textures)
+	{
+		OutReport.TotalVRAMBytes += Texture.VRAMBytes;
+	}
+
+	Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogAtlas, Log, TEXT("Overview collected %d textures, %d meshes, %d levels from %d assets in %d packages (%d loaded) in %.2fs"),
+		OutReport.Textures.Num(), OutReport.Meshes.Num(), OutReport.Levels.Num(), Stats.NumAssets, Stats.NumPackages, Stats.NumLoaded, Stats.Seconds);
+
+	if (OutStats)
+	{
+		*OutStats = Stats;
+	}
+}
+
+void FAtlasOverviewStats::ComputeRankings(const FAtlasReport& Report, int32 TopN, FAtlasOverviewRankings& OutRankings)
+{
+	SelectTopN(Report.Textures.Num(), TopN, [&Report](int32 Index) { return Report.Textures[Index].VRAMBytes; }, OutRankings.TexturesByVRAM);
+	SelectTopN(Report.Meshes.Num(), TopN, [&Report](int32 Index) { return Report.Meshes[Index].TriangleCount; }, OutRankings.MeshesByTriangles);
+	SelectTopN(Report.Levels.Num(), TopN, [&Report](int32 Index) { return Report.Levels[Index].TotalBytes; }, OutRankings.LevelsBySize);
+	SelectTopN(Report.Shaders.Num(), TopN, [&Report](int32 Index) { return Report.Shaders[Index].EstimatedPermutations; }, OutRankings.ShadersByPermutations);
+}
+
+void FAtlasOverviewStats::SelectTopN(int32 Num, int32 TopN, TFunctionRef<int64(int32)> GetKey, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+
+	if (TopN <= 0)
+	{
+		return;
+	}
+
+	struct FCandidate
+	{
+		int64 Key;
+		int32 Index;
+	};
+
+	// Orders the weakest candidate first, so the heap top is the one to evict
+	const auto IsWeaker = [](const FCandidate& A, const FCandidate& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Index > B.Index;
+	};
+
+	TArray<FCandidate> Heap;
+	Heap.Reserve(FMath::Min(Num, TopN));
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FCandidate Candidate = { GetKey(Index), Index };
+		if (Heap.Num() < TopN)
+		{
+			Heap.HeapPush(Candidate, IsWeaker);
+		}
+		else if (IsWeaker(Heap.HeapTop(), Candidate))
+		{
+			Heap.HeapPopDiscard(IsWeaker, false);
+			Heap.HeapPush(Candidate, IsWeaker);
+		}
+	}
+
+	Heap.Sort([&IsWeaker](const FCandidate& A, const FCandidate& B)
+	{
+		return IsWeaker(B, A);
+	});
+
+	OutIndices.Reserve(Heap.Num());
+	for (const FCandidate& Candidate : Heap)
+	{
+		OutIndices.Add(Candidate.Index);
+	}
+}
+
+int64 FAtlasOverviewStats::GetPackageDiskSize(FName PackageName)
+{
+	// The module manager is game-thread only, the registry singleton is not
+	const IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	if (PackageData.IsSet() && PackageData->DiskSize >= 0)
+	{
+		return PackageData->DiskSize;
+	}
+
+	FString Filename;
+	if (!FPackageName::DoesPackageExist(PackageName.ToString(), &Filename))
+	{
+		return 0;
+	}
+
+	return FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+}
@@ -0,0 +1,104 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+struct FAssetData;
+
+/**
+ * Counters collected while building the Overview
+ */
+struct FAtlasOverviewCollectStats
+{
+	/** Number of asset registry entries visited */
+	int32 NumAssets;
+
+	/** Number of distinct packages whose size was measured */
+	int32 NumPackages;
+
+	/** Number of assets that had to be loaded because a registry tag was missing */
+	int32 NumLoaded;
+
+	/** Wall time of the collection */
+	double Seconds;
+
+	FAtlasOverviewCollectStats()
+		: NumAssets(0)
+		, NumPackages(0)
+		, NumLoaded(0)
+		, Seconds(0.0)
+	{
+	}
+};
+
+/**
+ * Indices into the stat arrays of an FAtlasReport, largest first
+ */
+struct FAtlasOverviewRankings
+{
+	/** Textures by VRAMBytes */
+	TArray<int32> TexturesByVRAM;
+
+	/** Meshes by TriangleCount */
+	TArray<int32> MeshesByTriangles;
+
+	/** Levels by TotalBytes */
+	TArray<int32> LevelsBySize;
+
+	/** Master materials by EstimatedPermutations */
+	TArray<int32> ShadersByPermutations;
+};
+
+/**
+ * Collects the texture, mesh and level statistics shown by the Overview dashboard
+ * Values come from asset registry tags and package file sizes, evaluated on worker threads.
+ * Texture VRAM uses the platform cost model of FAtlasTextureUtils::EstimateCost.
+ * Assets are only loaded (on the game thread) when a tag they need is missing.
+ */
+class FAtlasOverviewStats
+{
+public:
+	/**
+	 * Collect statistics for all game content
+	 * @param OutReport Report whose Textures, Meshes, Levels and totals are replaced
+	 * @param OutStats Optional collection counters
+	 */
+	static void CollectAll(FAtlasReport& OutReport, FAtlasOverviewCollectStats* OutStats = nullptr);
+
+	/**
+	 * Collect statistics for a set of assets
+	 * TotalProjectBytes covers the distinct packages of the given assets.
+	 * @param Assets Assets to measure; classes other than textures, meshes and levels only count towards package size
+	 * @param OutReport Report whose Textures, Meshes, Levels and totals are replaced
+	 * @param OutStats Optional collection counters
+	 */
+	static void Collect(const TArray<FAssetData>& Assets, FAtlasReport& OutReport, FAtlasOverviewCollectStats* OutStats = nullptr);
+
+	/**
+	 * Rank the largest entries of a report without sorting every entry
+	 * @param Report Report filled by Collect
+	 * @param TopN Maximum number of entries per ranking
+	 * @param OutRankings Rankings to fill
+	 */
+	static void ComputeRankings(const FAtlasReport& Report, int32 TopN, FAtlasOverviewRankings& OutRankings);
+
+	/**
+	 * Select the indices of the N largest keys, largest first; ties keep the lower index first
+	 * Runs in O(Num log N) using a bounded heap.
+	 * @param Num Number of candidates
+	 * @param TopN Maximum number of indices to select
+	 * @param GetKey Returns the ranking key of a candidate index
+	 * @param OutIndices Array to fill with selected indices
+	 */
+	static void SelectTopN(int32 Num, int32 TopN, TFunctionRef<int64(int32)> GetKey, TArray<int32>& OutIndices);
+
+	/**
+	 * Get the on-disk size of a package
+	 * Uses asset registry package data when available, the file size otherwise. Safe to call from worker threads.
+	 * @param PackageName Long package name
+	 * @return Size in bytes, or 0 if the package has no file
+	 */
+	static int64 GetPackageDiskSize(FName PackageName);
+};
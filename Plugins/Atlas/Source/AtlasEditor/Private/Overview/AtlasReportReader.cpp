@@ -0,0 +1,456 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasReportReader.h"
+#include "AtlasReportStream.h"
+#include "AtlasRuntime.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Serialization/JsonReader.h"
+
+namespace AtlasReportReader
+{
+	typedef TJsonReader<TCHAR> FJsonReader;
+
+	/** Skip the rest of a value whose first token was just read */
+	static bool SkipValue(FJsonReader& Reader, EJsonNotation Notation)
+	{
+		int32 Depth = (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart) ? 1 : 0;
+		while (Depth > 0)
+		{
+			if (!Reader.ReadNext(Notation) || Notation == EJsonNotation::Error)
+			{
+				return false;
+			}
+
+			if (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)
+			{
+				++Depth;
+			}
+			else if (Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd)
+			{
+				--Depth;
+			}
+		}
+		return true;
+	}
+
+	static int64 GetInt64(const FJsonReader& Reader, EJsonNotation Notation)
+	{
+		return Notation == EJsonNotation::Number ? FCString::Atoi64(*Reader.GetValueAsNumberString()) : 0;
+	}
+
+	static FString GetString(const FJsonReader& Reader, EJsonNotation Notation)
+	{
+		return Notation == EJsonNotation::String ? Reader.GetValueAsString() : FString();
+	}
+
+	/**
+	 * Read the fields of a flat object whose ObjectStart was just read
+	 * Nested values are skipped; OnField receives (Identifier, Notation) with the reader positioned on the value
+	 */
+	template <typename FieldFuncType>
+	static bool ReadRecord(FJsonReader& Reader, FieldFuncType&& OnField)
+	{
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			switch (Notation)
+			{
+			case EJsonNotation::ObjectEnd:
+				return true;
+			case EJsonNotation::Error:
+				return false;
+			case EJsonNotation::ObjectStart:
+			case EJsonNotation::ArrayStart:
+				if (!SkipValue(Reader, Notation))
+				{
+					return false;
+				}
+				break;
+			default:
+				OnField(Reader.GetIdentifier(), Notation);
+				break;
+			}
+		}
+		return false;
+	}
+
+	static bool ReadIssue(FJsonReader& Reader, IAtlasReportVisitor& Visitor)
+	{
+		FAtlasIssue Issue;
+		const bool bRead = ReadRecord(Reader, [&Reader, &Issue](const FString& Identifier, EJsonNotation Notation)
+		{
+			if (Identifier == TEXT("assetPath"))
+			{
+				Issue.AssetPath = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("ruleName"))
+			{
+				Issue.RuleName = FName(*GetString(Reader, Notation));
+			}
+			else if (Identifier == TEXT("severity"))
+			{
+				const int64 Value = StaticEnum<EAtlasSeverity>()->GetValueByNameString(GetString(Reader, Notation));
+				Issue.Severity = Value != INDEX_NONE ? static_cast<EAtlasSeverity>(Value) : EAtlasSeverity::Info;
+			}
+			else if (Identifier == TEXT("message"))
+			{
+				Issue.Message = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("bCanFix"))
+			{
+				Issue.bCanFix = Notation == EJsonNotation::Boolean && Reader.GetValueAsBoolean();
+			}
+		});
+
+		if (bRead)
+		{
+			Visitor.VisitIssue(Issue);
+		}
+		return bRead;
+	}
+
+	static bool ReadTexture(FJsonReader& Reader, IAtlasReportVisitor& Visitor)
+	{
+		FAtlasTextureStat Texture;
+		const bool bRead = ReadRecord(Reader, [&Reader, &Texture](const FString& Identifier, EJsonNotation Notation)
+		{
+			if (Identifier == TEXT("path"))
+			{
+				Texture.Path = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("vRAMBytes"))
+			{
+				Texture.VRAMBytes = GetInt64(Reader, Notation);
+			}
+			else if (Identifier == TEXT("maxDimension"))
+			{
+				Texture.MaxDimension = static_cast<int32>(GetInt64(Reader, Notation));
+			}
+			else if (Identifier == TEXT("pixelFormat"))
+			{
+				Texture.PixelFormat = GetString(Reader, Notation);
+			}
+		});
+
+		if (bRead)
+		{
+			Visitor.VisitTexture(Texture);
+		}
+		return bRead;
+	}
+
+	static bool ReadMesh(FJsonReader& Reader, IAtlasReportVisitor& Visitor)
+	{
+		FAtlasMeshStat Mesh;
+		const bool bRead = ReadRecord(Reader, [&Reader, &Mesh](const FString& Identifier, EJsonNotation Notation)
+		{
+			if (Identifier == TEXT("path"))
+			{
+				Mesh.Path = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("triangleCount"))
+			{
+				Mesh.TriangleCount = GetInt64(Reader, Notation);
+			}
+			else if (Identifier == TEXT("numLODs"))
+			{
+				Mesh.NumLODs = static_cast<int32>(GetInt64(Reader, Notation));
+			}
+		});
+
+		if (bRead)
+		{
+			Visitor.VisitMesh(Mesh);
+		}
+		return bRead;
+	}
+
+	static bool ReadLevel(FJsonReader& Reader, IAtlasReportVisitor& Visitor)
+	{
+		FAtlasLevelStat Level;
+		const bool bRead = ReadRecord(Reader, [&Reader, &Level](const FString& Identifier, EJsonNotation Notation)
+		{
+			if (Identifier == TEXT("path"))
+			{
+				Level.Path = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("totalBytes"))
+			{
+				Level.TotalBytes = GetInt64(Reader, Notation);
+			}
+		});
+
+		if (bRead)
+		{
+			Visitor.VisitLevel(Level);
+		}
+		return bRead;
+	}
+
+	static bool ReadShader(FJsonReader& Reader, IAtlasReportVisitor& Visitor)
+	{
+		FAtlasShaderStat Shader;
+		const bool bRead = ReadRecord(Reader, [&Reader, &Shader](const FString& Identifier, EJsonNotation Notation)
+		{
+			if (Identifier == TEXT("path"))
+			{
+				Shader.Path = GetString(Reader, Notation);
+			}
+			else if (Identifier == TEXT("numInstances"))
+			{
+				Shader.NumInstances = static_cast<int32>(GetInt64(Reader, Notation));
+			}
+			else if (Identifier == TEXT("numStaticCombinations"))
+			{
+				Shader.NumStaticCombinations = static_cast<int32>(GetInt64(Reader, Notation));
+			}
+			else if (Identifier == TEXT("numVertexFactories"))
+			{
+				Shader.NumVertexFactories = static_cast<int32>(GetInt64(Reader, Notation));
+			}
+			else if (Identifier == TEXT("estimatedPermutations"))
+			{
+				Shader.EstimatedPermutations = GetInt64(Reader, Notation);
+			}
+			else if (Identifier == TEXT("estimatedBytes"))
+			{
+				Shader.EstimatedBytes = GetInt64(Reader, Notation);
+			}
+		});
+
+		if (bRead)
+		{
+			Visitor.VisitShader(Shader);
+		}
+		return bRead;
+	}
+
+	/** Collects every record into an in-memory report */
+	class FReportCollector : public IAtlasReportVisitor
+	{
+	public:
+		explicit FReportCollector(FAtlasReport& InReport)
+			: Report(InReport)
+		{
+		}
+
+		virtual void VisitIssue(FAtlasIssue& Issue) override { Report.Issues.Add(MoveTemp(Issue)); }
+		virtual void VisitTexture(FAtlasTextureStat& Texture) override { Report.Textures.Add(MoveTemp(Texture)); }
+		virtual void VisitMesh(FAtlasMeshStat& Mesh) override { Report.Meshes.Add(MoveTemp(Mesh)); }
+		virtual void VisitLevel(FAtlasLevelStat& Level) override { Report.Levels.Add(MoveTemp(Level)); }
+		virtual void VisitShader(FAtlasShaderStat& Shader) override { Report.Shaders.Add(MoveTemp(Shader)); }
+
+		virtual void VisitTotals(int64 TotalProjectBytes, int64 TotalVRAMBytes, int64 ReclaimableBytes, int64 ReclaimableVRAMBytes) override
+		{
+			Report.TotalProjectBytes += TotalProjectBytes;
+			Report.TotalVRAMBytes += TotalVRAMBytes;
+			Report.ReclaimableBytes += ReclaimableBytes;
+			Report.ReclaimableVRAMBytes += ReclaimableVRAMBytes;
+		}
+
+	private:
+		FAtlasReport& Report;
+	};
+
+	/** Forwards issues to a callback */
+	class FIssueVisitor : public IAtlasReportVisitor
+	{
+	public:
+		explicit FIssueVisitor(TFunctionRef<void(FAtlasIssue&)> InOnIssue)
+			: OnIssue(InOnIssue)
+		{
+		}
+
+		virtual void VisitIssue(FAtlasIssue& Issue) override { OnIssue(Issue); }
+
+	private:
+		TFunctionRef<void(FAtlasIssue&)> OnIssue;
+	};
+}
+
+bool FAtlasReportReader::Read(const FString& FilePath, IAtlasReportVisitor& Visitor)
+{
+	using namespace AtlasReportReader;
+
+	TUniquePtr<FArchive> FileArchive(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!FileArchive)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to open Atlas report %s"), *FilePath);
+		return false;
+	}
+
+	FArchive* Source = FileArchive.Get();
+	TUniquePtr<FAtlasGzipReaderArchive> GzipArchive;
+	if (FAtlasGzipReaderArchive::IsGzip(*Source))
+	{
+		GzipArchive = MakeUnique<FAtlasGzipReaderArchive>(*Source);
+		Source = GzipArchive.Get();
+	}
+
+	FAtlasUtf8ReaderArchive Utf8Archive(*Source);
+	TSharedRef<FJsonReader> Reader = TJsonReaderFactory<TCHAR>::Create(&Utf8Archive);
+
+	int64 TotalProjectBytes = 0;
+	int64 TotalVRAMBytes = 0;
+	int64 ReclaimableBytes = 0;
+	int64 ReclaimableVRAMBytes = 0;
+
+	EJsonNotation Notation;
+	bool bSuccess = Reader->ReadNext(Notation) && Notation == EJsonNotation::ObjectStart;
+	while (bSuccess)
+	{
+		if (!Reader->ReadNext(Notation) || Notation == EJsonNotation::Error)
+		{
+			bSuccess = false;
+			break;
+		}
+
+		if (Notation == EJsonNotation::ObjectEnd)
+		{
+			break;
+		}
+
+		const FString Identifier = Reader->GetIdentifier();
+
+		if (Notation == EJsonNotation::ArrayStart)
+		{
+			bool (*ReadElement)(FJsonReader&, IAtlasReportVisitor&) = nullptr;
+			if (Identifier == TEXT("issues"))
+			{
+				ReadElement = &ReadIssue;
+			}
+			else if (Identifier == TEXT("textures"))
+			{
+				ReadElement = &ReadTexture;
+			}
+			else if (Identifier == TEXT("meshes"))
+			{
+				ReadElement = &ReadMesh;
+			}
+			else if (Identifier == TEXT("levels"))
+			{
+				ReadElement = &ReadLevel;
+			}
+			else if (Identifier == TEXT("shaders"))
+			{
+				ReadElement = &ReadShader;
+			}
+
+			if (!ReadElement)
+			{
+				bSuccess = SkipValue(*Reader, Notation);
+				continue;
+			}
+
+			while (bSuccess && Reader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd)
+			{
+				if (Notation == EJsonNotation::ObjectStart)
+				{
+					bSuccess = ReadElement(*Reader, Visitor);
+				}
+				else if (Notation == EJsonNotation::ArrayStart || Notation == EJsonNotation::Error)
+				{
+					bSuccess = SkipValue(*Reader, Notation) && Notation != EJsonNotation::Error;
+				}
+			}
+
+			bSuccess &= Notation == EJsonNotation::ArrayEnd;
+		}
+		else if (Notation == EJsonNotation::ObjectStart)
+		{
+			bSuccess = SkipValue(*Reader, Notation);
+		}
+		else if (Identifier == TEXT("totalProjectBytes"))
+		{
+			TotalProjectBytes = GetInt64(*Reader, Notation);
+		}
+		else if (Identifier == TEXT("totalVRAMBytes"))
+		{
+			TotalVRAMBytes = GetInt64(*Reader, Notation);
+		}
+		else if (Identifier == TEXT("reclaimableBytes"))
+		{
+			ReclaimableBytes = GetInt64(*Reader, Notation);
+		}
+		else if (Identifier == TEXT("reclaimableVRAMBytes"))
+		{
+			ReclaimableVRAMBytes = GetInt64(*Reader, Notation);
+		}
+	}
+
+	bSuccess &= !Utf8Archive.IsError() && !Source->IsError();
+	if (!bSuccess)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to parse Atlas report %s: %s"), *FilePath, *Reader->GetErrorMessage());
+		return false;
+	}
+
+	Visitor.VisitTotals(TotalProjectBytes, TotalVRAMBytes, ReclaimableBytes, ReclaimableVRAMBytes);
+	return true;
+}
+
+bool FAtlasReportReader::ReadReport(const FString& FilePath, FAtlasReport& OutReport)
+{
+	AtlasReportReader::FReportCollector Collector(OutReport);
+	return Read(FilePath, Collector);
+}
+
+bool FAtlasReportReader::Diff(const FString& BasePath, const FString& NewPath, TFunctionRef<void(const FAtlasIssue&)> OnAdded, TFunctionRef<void(const FAtlasIssue&)> OnRemoved)
+{
+	using namespace AtlasReportReader;
+
+	// Pass 1: count the issues of the base report
+	TMap<uint64, int32> Unmatched;
+	FIssueVisitor CountBase([&Unmatched](FAtlasIssue& Issue)
+	{
+		++Unmatched.FindOrAdd(GetIssueHash(Issue));
+	});
+
+	if (!Read(BasePath, CountBase))
+	{
+		return false;
+	}
+
+	// Pass 2: anything in the new report without a base counterpart was added
+	FIssueVisitor MatchNew([&Unmatched, &OnAdded](FAtlasIssue& Issue)
+	{
+		int32* Count = Unmatched.Find(GetIssueHash(Issue));
+		if (Count && *Count > 0)
+		{
+			--*Count;
+		}
+		else
+		{
+			OnAdded(Issue);
+		}
+	});
+
+	if (!Read(NewPath, MatchNew))
+	{
+		return false;
+	}
+
+	// Pass 3: base issues left unmatched were removed
+	FIssueVisitor ReportRemoved([&Unmatched, &OnRemoved](FAtlasIssue& Issue)
+	{
+		int32* Count = Unmatched.Find(GetIssueHash(Issue));
+		if (Count && *Count > 0)
+		{
+			--*Count;
+			OnRemoved(Issue);
+		}
+	});
+
+	return Read(BasePath, ReportRemoved);
+}
+
+uint64 FAtlasReportReader::GetIssueHash(const FAtlasIssue& Issue)
+{
+	const FString RuleName = Issue.RuleName.ToString();
+
+	uint64 Hash = CityHash64(reinterpret_cast<const char*>(*Issue.AssetPath), Issue.AssetPath.Len() * sizeof(TCHAR));
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*RuleName), RuleName.Len() * sizeof(TCHAR), Hash);
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Issue.Message), Issue.Message.Len() * sizeof(TCHAR), Hash);
+	return Hash ^ static_cast<uint64>(Issue.Severity);
+}
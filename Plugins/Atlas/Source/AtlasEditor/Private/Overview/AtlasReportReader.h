@@ -0,0 +1,66 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+/**
+ * Receives records from FAtlasReportReader as they are parsed
+ * Records are handed over mutable so visitors can move strings out of them.
+ */
+class IAtlasReportVisitor
+{
+public:
+	virtual ~IAtlasReportVisitor() = default;
+
+	virtual void VisitIssue(FAtlasIssue& Issue) {}
+	virtual void VisitTexture(FAtlasTextureStat& Texture) {}
+	virtual void VisitMesh(FAtlasMeshStat& Mesh) {}
+	virtual void VisitLevel(FAtlasLevelStat& Level) {}
+	virtual void VisitShader(FAtlasShaderStat& Shader) {}
+
+	/** Called once after the last record */
+	virtual void VisitTotals(int64 TotalProjectBytes, int64 TotalVRAMBytes, int64 ReclaimableBytes, int64 ReclaimableVRAMBytes) {}
+};
+
+/**
+ * Streams JSON reports written by FAtlasReportWriter (or FJsonObjectConverter) without building a DOM
+ * Gzip-compressed files are detected automatically.
+ */
+class FAtlasReportReader
+{
+public:
+	/**
+	 * Parse a report file, passing each record to the visitor
+	 * @param FilePath The report to read
+	 * @param Visitor Receives the records
+	 * @return True if the whole file was parsed
+	 */
+	static bool Read(const FString& FilePath, IAtlasReportVisitor& Visitor);
+
+	/**
+	 * Load a complete report into memory
+	 * @param FilePath The report to read
+	 * @param OutReport Report to append to
+	 * @return True if the whole file was parsed
+	 */
+	static bool ReadReport(const FString& FilePath, FAtlasReport& OutReport);
+
+	/**
+	 * Compare the issues of two reports
+	 * Only a 64-bit hash per issue is kept in memory; each report is streamed from disk.
+	 * Duplicate issues are matched one to one.
+	 * @param BasePath The older report
+	 * @param NewPath The newer report
+	 * @param OnAdded Called for issues only present in the newer report
+	 * @param OnRemoved Called for issues only present in the older report
+	 * @return True if both reports were parsed
+	 */
+	static bool Diff(const FString& BasePath, const FString& NewPath, TFunctionRef<void(const FAtlasIssue&)> OnAdded, TFunctionRef<void(const FAtlasIssue&)> OnRemoved);
+
+	/**
+	 * Identity of an issue for diffing: asset, rule, severity and message
+	 */
+	static uint64 GetIssueHash(const FAtlasIssue& Issue);
+};
@@ -0,0 +1,55 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasReportSerializer.h"
+#include "AtlasReportWriter.h"
+#include "AtlasReportReader.h"
+#include "AtlasBinaryReport.h"
+
+const TCHAR* FAtlasReportSerializer::BinaryExtension = TEXT(".atlasreport");
+
+bool FAtlasReportSerializer::SaveToFile(const FAtlasReport& Report, const FString& FilePath, bool bCompress)
+{
+	if (IsBinaryPath(FilePath))
+	{
+		return FAtlasBinaryReportWriter::WriteReport(Report, FilePath);
+	}
+
+	return FAtlasReportWriter::WriteReport(Report, FilePath, bCompress);
+}
+
+bool FAtlasReportSerializer::LoadFromFile(const FString& FilePath, FAtlasReport& OutReport)
+{
+	if (FAtlasBinaryReportView::IsBinaryReport(FilePath))
+	{
+		FAtlasBinaryReportView View;
+		if (!View.Open(FilePath))
+		{
+			return false;
+		}
+
+		View.ToReport(OutReport);
+		return true;
+	}
+
+	return FAtlasReportReader::ReadReport(FilePath, OutReport);
+}
+
+bool FAtlasReportSerializer::IsBinaryPath(const FString& FilePath)
+{
+	return FilePath.EndsWith(BinaryExtension);
+}
+
+bool FAtlasReportSerializer::IsIssueLess(const FAtlasIssue& A, const FAtlasIssue& B)
+{
+	const int32 PathCompare = A.AssetPath.Compare(B.AssetPath);
+	if (PathCompare != 0)
+	{
+		return PathCompare < 0;
+	}
+	return A.RuleName.LexicalLess(B.RuleName);
+}
+
+void FAtlasReportSerializer::SortIssues(FAtlasReport& Report)
+{
+	Report.Issues.StableSort(&FAtlasReportSerializer::IsIssueLess);
+}
@@ -0,0 +1,52 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+/**
+ * Reads and writes complete FAtlasReport objects
+ * The format follows the file extension: ".atlasreport" is the compact binary format, anything else is JSON.
+ * Used by the validate commandlet for CI output and for merging sharded runs.
+ * Producers that generate records incrementally should use FAtlasReportWriter or FAtlasBinaryReportWriter directly.
+ */
+class FAtlasReportSerializer
+{
+public:
+	/** Extension of the binary report format */
+	static const TCHAR* BinaryExtension;
+
+	/**
+	 * Write a report, creating the directory if needed
+	 * @param Report The report to write
+	 * @param FilePath Destination file
+	 * @param bCompress Gzip the output (JSON only)
+	 * @return True if the file was written
+	 */
+	static bool SaveToFile(const FAtlasReport& Report, const FString& FilePath, bool bCompress = false);
+
+	/**
+	 * Read a report previously written by SaveToFile; the format is detected from the file contents
+	 * @param FilePath Source file
+	 * @param OutReport Report to append to; reading several files into one report merges them
+	 * @return True if the file was read and parsed
+	 */
+	static bool LoadFromFile(const FString& FilePath, FAtlasReport& OutReport);
+
+	/**
+	 * Whether a path names a binary report
+	 */
+	static bool IsBinaryPath(const FString& FilePath);
+
+	/**
+	 * Ordering used for report output: asset path, then rule name
+	 */
+	static bool IsIssueLess(const FAtlasIssue& A, const FAtlasIssue& B);
+
+	/**
+	 * Sort a report's issues with IsIssueLess, so output does not depend on scan or merge order
+	 * @param Report Report to sort
+	 */
+	static void SortIssues(FAtlasReport& Report);
+};
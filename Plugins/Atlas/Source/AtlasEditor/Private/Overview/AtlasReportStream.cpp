@@ -0,0 +1,376 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasReportStream.h"
+#include "Containers/StringConv.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace AtlasReportStream
+{
+	/** Size of the compressed and uncompressed staging buffers */
+	static constexpr int32 BufferSize = 64 * 1024;
+
+	/** zlib window bits: 15 bit window, +16 selects gzip framing, +32 auto-detects gzip or zlib when inflating */
+	static constexpr int32 GzipWriteWindowBits = 15 + 16;
+	static constexpr int32 GzipReadWindowBits = 15 + 32;
+
+	/** Characters buffered before converting to UTF-8 */
+	static constexpr int32 PendingChars = 16 * 1024;
+
+	/** Largest block handed to zlib at once (avail_in is 32 bit) */
+	static constexpr int64 MaxDeflateInput = 1 << 30;
+}
+
+// FAtlasGzipWriterArchive
+
+FAtlasGzipWriterArchive::FAtlasGzipWriterArchive(FArchive& InInner)
+	: Inner(InInner)
+	, Stream(new z_stream_s())
+	, UncompressedBytes(0)
+	, bFinished(false)
+{
+	using namespace AtlasReportStream;
+
+	SetIsSaving(true);
+	OutBuffer.SetNumUninitialized(BufferSize);
+
+	if (deflateInit2(Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipWriteWindowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		SetError();
+		bFinished = true;
+	}
+}
+
+FAtlasGzipWriterArchive::~FAtlasGzipWriterArchive()
+{
+	Finish();
+	deflateEnd(Stream);
+	delete Stream;
+}
+
+bool FAtlasGzipWriterArchive::Finish()
+{
+	if (!bFinished)
+	{
+		Stream->next_in = nullptr;
+		Stream->avail_in = 0;
+		Deflate(Z_FINISH);
+		bFinished = true;
+	}
+
+	return !IsError() && !Inner.IsError();
+}
+
+void FAtlasGzipWriterArchive::Serialize(void* Data, int64 Num)
+{
+	using namespace AtlasReportStream;
+
+	if (bFinished)
+	{
+		SetError();
+		return;
+	}
+
+	uint8* Bytes = static_cast<uint8*>(Data);
+	while (Num > 0 && !IsError())
+	{
+		const int64 BlockSize = FMath::Min(Num, MaxDeflateInput);
+		Stream->next_in = Bytes;
+		Stream->avail_in = static_cast<uInt>(BlockSize);
+		Deflate(Z_NO_FLUSH);
+
+		Bytes += BlockSize;
+		Num -= BlockSize;
+		UncompressedBytes += BlockSize;
+	}
+}
+
+void FAtlasGzipWriterArchive::Deflate(int32 FlushMode)
+{
+	for (;;)
+	{
+		Stream->next_out = OutBuffer.GetData();
+		Stream->avail_out = static_cast<uInt>(OutBuffer.Num());
+
+		const int32 Result = deflate(Stream, FlushMode);
+		if (Result == Z_STREAM_ERROR)
+		{
+			SetError();
+			return;
+		}
+
+		const int32 Produced = OutBuffer.Num() - static_cast<int32>(Stream->avail_out);
+		if (Produced > 0)
+		{
+			Inner.Serialize(OutBuffer.GetData(), Produced);
+		}
+
+		// Without Z_FINISH, a partially filled output buffer means all input was consumed
+		if (Result == Z_STREAM_END || (FlushMode != Z_FINISH && Stream->avail_out != 0))
+		{
+			return;
+		}
+	}
+}
+
+// FAtlasGzipReaderArchive
+
+FAtlasGzipReaderArchive::FAtlasGzipReaderArchive(FArchive& InInner)
+	: Inner(InInner)
+	, Stream(new z_stream_s())
+	, OutPos(0)
+	, UncompressedBytes(0)
+	, bStreamEnd(false)
+{
+	using namespace AtlasReportStream;
+
+	SetIsLoading(true);
+	InBuffer.SetNumUninitialized(BufferSize);
+
+	if (inflateInit2(Stream, GzipReadWindowBits) != Z_OK)
+	{
+		SetError();
+		bStreamEnd = true;
+	}
+}
+
+FAtlasGzipReaderArchive::~FAtlasGzipReaderArchive()
+{
+	inflateEnd(Stream);
+	delete Stream;
+}
+
+bool FAtlasGzipReaderArchive::IsGzip(FArchive& Ar)
+{
+	const int64 Start = Ar.Tell();
+	if (Ar.TotalSize() - Start < 2)
+	{
+		return false;
+	}
+
+	uint8 Magic[2];
+	Ar.Serialize(Magic, sizeof(Magic));
+	Ar.Seek(Start);
+
+	return Magic[0] == 0x1f && Magic[1] == 0x8b;
+}
+
+void FAtlasGzipReaderArchive::Serialize(void* Data, int64 Num)
+{
+	uint8* Dest = static_cast<uint8*>(Data);
+	while (Num > 0)
+	{
+		if (OutPos >= OutBuffer.Num() && !Refill())
+		{
+			FMemory::Memzero(Dest, Num);
+			SetError();
+			return;
+		}
+
+		const int32 Count = static_cast<int32>(FMath::Min<int64>(Num, OutBuffer.Num() - OutPos));
+		FMemory::Memcpy(Dest, OutBuffer.GetData() + OutPos, Count);
+
+		OutPos += Count;
+		Dest += Count;
+		Num -= Count;
+		UncompressedBytes += Count;
+	}
+}
+
+bool FAtlasGzipReaderArchive::AtEnd()
+{
+	return OutPos >= OutBuffer.Num() && !Refill();
+}
+
+bool FAtlasGzipReaderArchive::Refill()
+{
+	using namespace AtlasReportStream;
+
+	OutBuffer.SetNumUninitialized(BufferSize, false);
+	OutPos = 0;
+
+	Stream->next_out = OutBuffer.GetData();
+	Stream->avail_out = BufferSize;
+
+	while (!bStreamEnd && Stream->avail_out == BufferSize)
+	{
+		if (Stream->avail_in == 0)
+		{
+			const int64 Remaining = Inner.TotalSize() - Inner.Tell();
+			if (Remaining <= 0)
+			{
+				// Input ran out before the end of the gzip stream
+				SetError();
+				bStreamEnd = true;
+				break;
+			}
+
+			const int32 ReadSize = static_cast<int32>(FMath::Min<int64>(Remaining, InBuffer.Num()));
+			Inner.Serialize(InBuffer.GetData(), ReadSize);
+			Stream->next_in = InBuffer.GetData();
+			Stream->avail_in = ReadSize;
+		}
+
+		const int32 Result = inflate(Stream, Z_NO_FLUSH);
+		if (Result == Z_STREAM_END)
+		{
+			// gzip allows several members back to back; continue with the next one if there is more input
+			if (Stream->avail_in == 0 && Inner.Tell() >= Inner.TotalSize())
+			{
+				bStreamEnd = true;
+			}
+			else
+			{
+				inflateReset(Stream);
+			}
+		}
+		else if (Result != Z_OK && Result != Z_BUF_ERROR)
+		{
+			SetError();
+			bStreamEnd = true;
+		}
+	}
+
+	OutBuffer.SetNum(BufferSize - static_cast<int32>(Stream->avail_out), false);
+	return OutBuffer.Num() > 0;
+}
+
+// FAtlasUtf8WriterArchive
+
+FAtlasUtf8WriterArchive::FAtlasUtf8WriterArchive(FArchive& InInner)
+	: Inner(InInner)
+{
+	SetIsSaving(true);
+	Pending.Reserve(AtlasReportStream::PendingChars);
+}
+
+FAtlasUtf8WriterArchive::~FAtlasUtf8WriterArchive()
+{
+	Convert(true);
+}
+
+void FAtlasUtf8WriterArchive::Serialize(void* Data, int64 Num)
+{
+	check(Num % sizeof(TCHAR) == 0);
+
+	Pending.Append(static_cast<const TCHAR*>(Data), static_cast<int32>(Num / sizeof(TCHAR)));
+	if (Pending.Num() >= AtlasReportStream::PendingChars)
+	{
+		Convert(false);
+	}
+}
+
+void FAtlasUtf8WriterArchive::Flush()
+{
+	Convert(true);
+	Inner.Flush();
+}
+
+void FAtlasUtf8WriterArchive::Convert(bool bFinal)
+{
+	int32 Count = Pending.Num();
+	if (!bFinal && Count > 0 && StringConv::IsHighSurrogate(static_cast<uint32>(Pending[Count - 1])))
+	{
+		--Count;
+	}
+
+	if (Count == 0)
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8(Pending.GetData(), Count);
+	Inner.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+
+	Pending.RemoveAt(0, Count, false);
+}
+
+// FAtlasUtf8ReaderArchive
+
+FAtlasUtf8ReaderArchive::FAtlasUtf8ReaderArchive(FArchive& InInner)
+	: Inner(InInner)
+	, PendingChar(0)
+	, bHasPendingChar(false)
+{
+	SetIsLoading(true);
+}
+
+void FAtlasUtf8ReaderArchive::Serialize(void* Data, int64 Num)
+{
+	check(Num % sizeof(TCHAR) == 0);
+
+	TCHAR* Dest = static_cast<TCHAR*>(Data);
+	for (int64 Index = 0; Index < Num / static_cast<int64>(sizeof(TCHAR)); ++Index)
+	{
+		if (!bHasPendingChar && Inner.AtEnd())
+		{
+			FMemory::Memzero(Dest + Index, Num - Index * sizeof(TCHAR));
+			SetError();
+			return;
+		}
+
+		Dest[Index] = DecodeChar();
+	}
+}
+
+bool FAtlasUtf8ReaderArchive::AtEnd()
+{
+	return !bHasPendingChar && Inner.AtEnd();
+}
+
+TCHAR FAtlasUtf8ReaderArchive::DecodeChar()
+{
+	if (bHasPendingChar)
+	{
+		bHasPendingChar = false;
+		return PendingChar;
+	}
+
+	uint8 Lead = 0;
+	Inner << Lead;
+
+	uint32 CodePoint = Lead;
+	int32 NumContinuation = 0;
+	if ((Lead & 0xE0) == 0xC0)
+	{
+		CodePoint = Lead & 0x1F;
+		NumContinuation = 1;
+	}
+	else if ((Lead & 0xF0) == 0xE0)
+	{
+		CodePoint = Lead & 0x0F;
+		NumContinuation = 2;
+	}
+	else if ((Lead & 0xF8) == 0xF0)
+	{
+		CodePoint = Lead & 0x07;
+		NumContinuation = 3;
+	}
+	else if (Lead >= 0x80)
+	{
+		return UNICODE_BOGUS_CHAR_CODEPOINT;
+	}
+
+	for (int32 Index = 0; Index < NumContinuation; ++Index)
+	{
+		uint8 Continuation = 0;
+		Inner << Continuation;
+		if ((Continuation & 0xC0) != 0x80)
+		{
+			return UNICODE_BOGUS_CHAR_CODEPOINT;
+		}
+		CodePoint = (CodePoint << 6) | (Continuation & 0x3F);
+	}
+
+	if (sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+	{
+		CodePoint -= 0x10000;
+		PendingChar = static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF));
+		bHasPendingChar = true;
+		return static_cast<TCHAR>(0xD800 + (CodePoint >> 10));
+	}
+
+	return static_cast<TCHAR>(CodePoint);
+}
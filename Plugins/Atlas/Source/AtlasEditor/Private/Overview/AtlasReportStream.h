@@ -0,0 +1,129 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+struct z_stream_s;
+
+/**
+ * Archive adapters used to stream reports without holding them in memory
+ * Each adapter forwards to an inner archive it does not own, and buffers a bounded amount of data.
+ */
+
+/**
+ * Gzip-compresses everything serialized into it
+ */
+class FAtlasGzipWriterArchive : public FArchive
+{
+public:
+	explicit FAtlasGzipWriterArchive(FArchive& InInner);
+	virtual ~FAtlasGzipWriterArchive();
+
+	/**
+	 * Write the gzip trailer; no further data may be serialized
+	 * @return True if the stream was completed without errors
+	 */
+	bool Finish();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual int64 Tell() override { return UncompressedBytes; }
+	virtual FString GetArchiveName() const override { return TEXT("FAtlasGzipWriterArchive"); }
+	//~ End FArchive Interface
+
+private:
+	/** Run deflate until the input is consumed (or the stream is finished for Z_FINISH) */
+	void Deflate(int32 FlushMode);
+
+	FArchive& Inner;
+	z_stream_s* Stream;
+	TArray<uint8> OutBuffer;
+	int64 UncompressedBytes;
+	bool bFinished;
+};
+
+/**
+ * Decompresses a gzip stream (including concatenated members) from its inner archive
+ */
+class FAtlasGzipReaderArchive : public FArchive
+{
+public:
+	explicit FAtlasGzipReaderArchive(FArchive& InInner);
+	virtual ~FAtlasGzipReaderArchive();
+
+	/**
+	 * Check whether data starts with the gzip magic bytes
+	 * @param Ar Archive positioned at the start of the data; the position is restored
+	 */
+	static bool IsGzip(FArchive& Ar);
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual bool AtEnd() override;
+	virtual int64 Tell() override { return UncompressedBytes; }
+	virtual FString GetArchiveName() const override { return TEXT("FAtlasGzipReaderArchive"); }
+	//~ End FArchive Interface
+
+private:
+	/** Inflate more data into OutBuffer, returns false at end of stream */
+	bool Refill();
+
+	FArchive& Inner;
+	z_stream_s* Stream;
+	TArray<uint8> InBuffer;
+	TArray<uint8> OutBuffer;
+	int32 OutPos;
+	int64 UncompressedBytes;
+	bool bStreamEnd;
+};
+
+/**
+ * Accepts TCHAR text (as written by TJsonWriter<TCHAR>) and writes it to the inner archive as UTF-8
+ */
+class FAtlasUtf8WriterArchive : public FArchive
+{
+public:
+	explicit FAtlasUtf8WriterArchive(FArchive& InInner);
+	virtual ~FAtlasUtf8WriterArchive();
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual void Flush() override;
+	virtual FString GetArchiveName() const override { return TEXT("FAtlasUtf8WriterArchive"); }
+	//~ End FArchive Interface
+
+private:
+	/** Convert pending characters; a trailing high surrogate is kept until its pair arrives unless bFinal */
+	void Convert(bool bFinal);
+
+	FArchive& Inner;
+	TArray<TCHAR> Pending;
+};
+
+/**
+ * Reads UTF-8 text from the inner archive and serves it as TCHARs (for TJsonReader<TCHAR>)
+ * Decodes one character at a time, so the inner archive never has to report its size.
+ */
+class FAtlasUtf8ReaderArchive : public FArchive
+{
+public:
+	explicit FAtlasUtf8ReaderArchive(FArchive& InInner);
+
+	//~ Begin FArchive Interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual bool AtEnd() override;
+	virtual FString GetArchiveName() const override { return TEXT("FAtlasUtf8ReaderArchive"); }
+	//~ End FArchive Interface
+
+private:
+	/** Decode the next character, splitting code points outside the BMP into surrogate pairs where TCHAR is 16 bits */
+	TCHAR DecodeChar();
+
+	FArchive& Inner;
+
+	/** Low surrogate waiting to be returned after its high surrogate */
+	TCHAR PendingChar;
+	bool bHasPendingChar;
+};
@@ -0,0 +1,287 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasReportWriter.h"
+#include "AtlasReportStream.h"
+#include "AtlasRuntime.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+FAtlasReportWriter::FAtlasReportWriter()
+	: CurrentSection(ESection::None)
+	, TotalProjectBytes(0)
+	, TotalVRAMBytes(0)
+	, ReclaimableBytes(0)
+	, ReclaimableVRAMBytes(0)
+{
+}
+
+FAtlasReportWriter::~FAtlasReportWriter()
+{
+	if (JsonWriter.IsValid())
+	{
+		Close();
+	}
+}
+
+bool FAtlasReportWriter::Open(const FString& InFilePath, bool bCompress)
+{
+	check(!JsonWriter.IsValid());
+
+	FilePath = InFilePath;
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+	FileArchive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileArchive)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to create Atlas report %s"), *FilePath);
+		return false;
+	}
+
+	FArchive* Target = FileArchive.Get();
+	if (bCompress)
+	{
+		GzipArchive = MakeUnique<FAtlasGzipWriterArchive>(*Target);
+		Target = GzipArchive.Get();
+	}
+
+	Utf8Archive = MakeUnique<FAtlasUtf8WriterArchive>(*Target);
+	JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(Utf8Archive.Get());
+	JsonWriter->WriteObjectStart();
+
+	CurrentSection = ESection::None;
+	TotalProjectBytes = 0;
+	TotalVRAMBytes = 0;
+	ReclaimableBytes = 0;
+	ReclaimableVRAMBytes = 0;
+	Profile = FAtlasScanProfile();
+	return true;
+}
+
+void FAtlasReportWriter::EnterSection(ESection Section)
+{
+	check(JsonWriter.IsValid());
+
+	if (Section == CurrentSection)
+	{
+		return;
+	}
+
+	if (CurrentSection != ESection::None)
+	{
+		JsonWriter->WriteArrayEnd();
+	}
+
+	switch (Section)
+	{
+	case ESection::Issues:
+		JsonWriter->WriteArrayStart(TEXT("issues"));
+		break;
+	case ESection::Textures:
+		JsonWriter->WriteArrayStart(TEXT("textures"));
+		break;
+	case ESection::Meshes:
+		JsonWriter->WriteArrayStart(TEXT("meshes"));
+		break;
+	case ESection::Levels:
+		JsonWriter->WriteArrayStart(TEXT("levels"));
+		break;
+	case ESection::Shaders:
+		JsonWriter->WriteArrayStart(TEXT("shaders"));
+		break;
+	default:
+		break;
+	}
+
+	CurrentSection = Section;
+}
+
+void FAtlasReportWriter::WriteIssue(const FAtlasIssue& Issue)
+{
+	EnterSection(ESection::Issues);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("assetPath"), Issue.AssetPath);
+	JsonWriter->WriteValue(TEXT("ruleName"), Issue.RuleName.ToString());
+	JsonWriter->WriteValue(TEXT("severity"), StaticEnum<EAtlasSeverity>()->GetNameStringByValue(static_cast<int64>(Issue.Severity)));
+	JsonWriter->WriteValue(TEXT("message"), Issue.Message);
+	JsonWriter->WriteValue(TEXT("bCanFix"), Issue.bCanFix);
+	JsonWriter->WriteObjectEnd();
+}
+
+void FAtlasReportWriter::WriteTexture(const FAtlasTextureStat& Texture)
+{
+	EnterSection(ESection::Textures);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("path"), Texture.Path);
+	JsonWriter->WriteValue(TEXT("vRAMBytes"), Texture.VRAMBytes);
+	JsonWriter->WriteValue(TEXT("maxDimension"), Texture.MaxDimension);
+	JsonWriter->WriteValue(TEXT("pixelFormat"), Texture.PixelFormat);
+	JsonWriter->WriteObjectEnd();
+}
+
+void FAtlasReportWriter::WriteMesh(const FAtlasMeshStat& Mesh)
+{
+	EnterSection(ESection::Meshes);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("path"), Mesh.Path);
+	JsonWriter->WriteValue(TEXT("triangleCount"), Mesh.TriangleCount);
+	JsonWriter->WriteValue(TEXT("numLODs"), Mesh.NumLODs);
+	JsonWriter->WriteObjectEnd();
+}
+
+void FAtlasReportWriter::WriteLevel(const FAtlasLevelStat& Level)
+{
+	EnterSection(ESection::Levels);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("path"), Level.Path);
+	JsonWriter->WriteValue(TEXT("totalBytes"), Level.TotalBytes);
+	JsonWriter->WriteObjectEnd();
+}
+
+void FAtlasReportWriter::WriteShader(const FAtlasShaderStat& Shader)
+{
+	EnterSection(ESection::Shaders);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("path"), Shader.Path);
+	JsonWriter->WriteValue(TEXT("numInstances"), Shader.NumInstances);
+	JsonWriter->WriteValue(TEXT("numStaticCombinations"), Shader.NumStaticCombinations);
+	JsonWriter->WriteValue(TEXT("numVertexFactories"), Shader.NumVertexFactories);
+	JsonWriter->WriteValue(TEXT("estimatedPermutations"), Shader.EstimatedPermutations);
+	JsonWriter->WriteValue(TEXT("estimatedBytes"), Shader.EstimatedBytes);
+	JsonWriter->WriteObjectEnd();
+}
+
+void FAtlasReportWriter::SetTotals(int64 InTotalProjectBytes, int64 InTotalVRAMBytes, int64 InReclaimableBytes, int64 InReclaimableVRAMBytes)
+{
+	TotalProjectBytes = InTotalProjectBytes;
+	TotalVRAMBytes = InTotalVRAMBytes;
+	ReclaimableBytes = InReclaimableBytes;
+	ReclaimableVRAMBytes = InReclaimableVRAMBytes;
+}
+
+void FAtlasReportWriter::SetProfile(const FAtlasScanProfile& InProfile)
+{
+	Profile = InProfile;
+}
+
+bool FAtlasReportWriter::Close()
+{
+	if (!JsonWriter.IsValid())
+	{
+		return false;
+	}
+
+	if (CurrentSection != ESection::None)
+	{
+		JsonWriter->WriteArrayEnd();
+	}
+
+	JsonWriter->WriteValue(TEXT("totalProjectBytes"), TotalProjectBytes);
+	JsonWriter->WriteValue(TEXT("totalVRAMBytes"), TotalVRAMBytes);
+	JsonWriter->WriteValue(TEXT("reclaimableBytes"), ReclaimableBytes);
+	JsonWriter->WriteValue(TEXT("reclaimableVRAMBytes"), ReclaimableVRAMBytes);
+
+	if (Profile.Rules.Num() > 0 || Profile.SlowestAssets.Num() > 0)
+	{
+		JsonWriter->WriteObjectStart(TEXT("profile"));
+		JsonWriter->WriteValue(TEXT("scanSeconds"), Profile.ScanSeconds);
+		JsonWriter->WriteValue(TEXT("loadSeconds"), Profile.LoadSeconds);
+
+		JsonWriter->WriteArrayStart(TEXT("rules"));
+		for (const FAtlasRuleProfile& Rule : Profile.Rules)
+		{
+			JsonWriter->WriteObjectStart();
+			JsonWriter->WriteValue(TEXT("ruleName"), Rule.RuleName.ToString());
+			JsonWriter->WriteValue(TEXT("numCalls"), Rule.NumCalls);
+			JsonWriter->WriteValue(TEXT("totalSeconds"), Rule.TotalSeconds);
+			JsonWriter->WriteValue(TEXT("p50Seconds"), Rule.P50Seconds);
+			JsonWriter->WriteValue(TEXT("p95Seconds"), Rule.P95Seconds);
+			JsonWriter->WriteValue(TEXT("p99Seconds"), Rule.P99Seconds);
+			JsonWriter->WriteValue(TEXT("maxSeconds"), Rule.MaxSeconds);
+			JsonWriter->WriteObjectEnd();
+		}
+		JsonWriter->WriteArrayEnd();
+
+		JsonWriter->WriteArrayStart(TEXT("slowestAssets"));
+		for (const FAtlasAssetProfile& Asset : Profile.SlowestAssets)
+		{
+			JsonWriter->WriteObjectStart();
+			JsonWriter->WriteValue(TEXT("path"), Asset.Path);
+			JsonWriter->WriteValue(TEXT("seconds"), Asset.Seconds);
+			JsonWriter->WriteValue(TEXT("loadSeconds"), Asset.LoadSeconds);
+			JsonWriter->WriteObjectEnd();
+		}
+		JsonWriter->WriteArrayEnd();
+
+		JsonWriter->WriteObjectEnd();
+	}
+
+	JsonWriter->WriteObjectEnd();
+	const bool bJsonClosed = JsonWriter->Close();
+	JsonWriter.Reset();
+
+	// Tear down the chain from the outside in so every layer flushes into the next
+	Utf8Archive->Flush();
+	Utf8Archive.Reset();
+
+	bool bSuccess = bJsonClosed;
+	if (GzipArchive)
+	{
+		bSuccess &= GzipArchive->Finish();
+		GzipArchive.Reset();
+	}
+
+	bSuccess &= FileArchive->Close();
+	FileArchive.Reset();
+
+	CurrentSection = ESection::None;
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas report %s"), *FilePath);
+	}
+
+	return bSuccess;
+}
+
+bool FAtlasReportWriter::WriteReport(const FAtlasReport& Report, const FString& FilePath, bool bCompress)
+{
+	FAtlasReportWriter Writer;
+	if (!Writer.Open(FilePath, bCompress))
+	{
+		return false;
+	}
+
+	for (const FAtlasIssue& Issue : Report.Issues)
+	{
+		Writer.WriteIssue(Issue);
+	}
+
+	for (const FAtlasTextureStat& Texture : Report.Textures)
+	{
+		Writer.WriteTexture(Texture);
+	}
+
+	for (const FAtlasMeshStat& Mesh : Report.Meshes)
+	{
+		Writer.WriteMesh(Mesh);
+	}
+
+	for (const FAtlasLevelStat& Level : Report.Levels)
+	{
+		Writer.WriteLevel(Level);
+	}
+
+	for (const FAtlasShaderStat& Shader : Report.Shaders)
+	{
+		Writer.WriteShader(Shader);
+	}
+
+	Writer.SetTotals(Report.TotalProjectBytes, Report.TotalVRAMBytes, Report.ReclaimableBytes, Report.ReclaimableVRAMBytes);
+	Writer.SetProfile(Report.Profile);
+	return Writer.Close();
+}
@@ -0,0 +1,94 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+class FAtlasUtf8WriterArchive;
+class FAtlasGzipWriterArchive;
+
+/**
+ * Streams an FAtlasReport to a JSON file as it is produced
+ * Records are written straight to disk, so memory use does not grow with the number of issues.
+ * The layout matches FJsonObjectConverter output for FAtlasReport. Switching back to a section
+ * that was already closed starts a repeated key of the same name, which FAtlasReportReader merges.
+ */
+class ATLASEDITOR_API FAtlasReportWriter
+{
+public:
+	FAtlasReportWriter();
+	~FAtlasReportWriter();
+
+	/**
+	 * Open the output file, creating the directory if needed
+	 * @param FilePath Destination file
+	 * @param bCompress Gzip the output
+	 * @return True if the file could be created
+	 */
+	bool Open(const FString& FilePath, bool bCompress);
+
+	/** Append one record to the matching section */
+	void WriteIssue(const FAtlasIssue& Issue);
+	void WriteTexture(const FAtlasTextureStat& Texture);
+	void WriteMesh(const FAtlasMeshStat& Mesh);
+	void WriteLevel(const FAtlasLevelStat& Level);
+	void WriteShader(const FAtlasShaderStat& Shader);
+
+	/**
+	 * Set the report totals, written when the report is closed
+	 */
+	void SetTotals(int64 TotalProjectBytes, int64 TotalVRAMBytes, int64 ReclaimableBytes, int64 ReclaimableVRAMBytes);
+
+	/**
+	 * Set the scan profile, written as the "profile" object when the report is closed
+	 * The profile describes the run that wrote the report; FAtlasReportReader skips it.
+	 */
+	void SetProfile(const FAtlasScanProfile& InProfile);
+
+	/**
+	 * Finish the document and close the file
+	 * @return True if everything was written successfully
+	 */
+	bool Close();
+
+	/**
+	 * Write a complete in-memory report
+	 * @param Report The report to write
+	 * @param FilePath Destination file
+	 * @param bCompress Gzip the output
+	 * @return True if the file was written
+	 */
+	static bool WriteReport(const FAtlasReport& Report, const FString& FilePath, bool bCompress);
+
+private:
+	enum class ESection : uint8
+	{
+		None,
+		Issues,
+		Textures,
+		Meshes,
+		Levels,
+		Shaders
+	};
+
+	/** Close the current array if needed and open the one for Section */
+	void EnterSection(ESection Section);
+
+	typedef TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> FJsonWriter;
+
+	TUniquePtr<FArchive> FileArchive;
+	TUniquePtr<FAtlasGzipWriterArchive> GzipArchive;
+	TUniquePtr<FAtlasUtf8WriterArchive> Utf8Archive;
+	TSharedPtr<FJsonWriter> JsonWriter;
+
+	FString FilePath;
+	ESection CurrentSection;
+	int64 TotalProjectBytes;
+	int64 TotalVRAMBytes;
+	int64 ReclaimableBytes;
+	int64 ReclaimableVRAMBytes;
+	FAtlasScanProfile Profile;
+};
@@ -0,0 +1,303 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasShaderAnalyzer.h"
+#include "Core/AtlasAssetUtils.h"
+#include "AtlasRuntime.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+
+namespace AtlasShaderAnalyzer
+{
+	/** Rough average size of one compiled shader; only the order of magnitude matters */
+	static constexpr int64 EstimatedBytesPerShader = 12 * 1024;
+
+	/** One vertex and one pixel shader per mesh pass */
+	static constexpr int32 ShadersPerPass = 2;
+
+	/** Masters analyzed between garbage collections; each one loads all of its instances */
+	static constexpr int32 GarbageCollectInterval = 128;
+
+	/** Stats by master path while a BeginCache bracket is open */
+	static TMap<FName, FAtlasShaderStat> CachedStats;
+	static int32 CacheDepth = 0;
+
+	/** The static state one shader map is compiled for */
+	struct FCombination
+	{
+		EBlendMode BlendMode;
+		bool bLit;
+
+		FCombination(EBlendMode InBlendMode, bool bInLit)
+			: BlendMode(InBlendMode)
+			, bLit(bInLit)
+		{
+		}
+	};
+
+	/** Identity of an instance's static permutation: overridden static switches and base properties */
+	static FString GetStaticKey(const UMaterialInstance* Instance)
+	{
+		TArray<FString> Parts;
+
+		for (const FStaticSwitchParameter& Parameter : Instance->GetStaticParameters().StaticSwitchParameters)
+		{
+			if (Parameter.bOverride)
+			{
+				Parts.Add(FString::Printf(TEXT("%s=%d"), *Parameter.ParameterInfo.Name.ToString(), Parameter.Value ? 1 : 0));
+			}
+		}
+
+		const FMaterialInstanceBasePropertyOverrides& Overrides = Instance->BasePropertyOverrides;
+		if (Overrides.bOverride_BlendMode)
+		{
+			Parts.Add(FString::Printf(TEXT("BlendMode=%d"), static_cast<int32>(Overrides.BlendMode)));
+		}
+		if (Overrides.bOverride_ShadingModel)
+		{
+			Parts.Add(FString::Printf(TEXT("ShadingModel=%d"), static_cast<int32>(Overrides.ShadingModel)));
+		}
+		if (Overrides.bOverride_TwoSided)
+		{
+			Parts.Add(FString::Printf(TEXT("TwoSided=%d"), Overrides.TwoSided ? 1 : 0));
+		}
+		if (Overrides.bOverride_DitheredLODTransition)
+		{
+			Parts.Add(FString::Printf(TEXT("DitheredLODTransition=%d"), Overrides.DitheredLODTransition ? 1 : 0));
+		}
+		if (Overrides.bOverride_OpacityMaskClipValue)
+		{
+			Parts.Add(FString::Printf(TEXT("OpacityMaskClipValue=%g"), Overrides.OpacityMaskClipValue));
+		}
+
+		Parts.Sort();
+		return FString::Join(Parts, TEXT(";"));
+	}
+}
+
+void FAtlasShaderAnalyzer::Analyze(const TArray<FAssetData>& Assets, TArray<FAtlasShaderStat>& OutStats)
+{
+	using namespace AtlasShaderAnalyzer;
+
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+	OutStats.Reset();
+
+	int64 TotalPermutations = 0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UMaterial::StaticClass()))
+		{
+			continue;
+		}
+
+		// Analyzed earlier in the bracket, e.g. by the permutation rule during the scan
+		if (const FAtlasShaderStat* Cached = CachedStats.Find(AssetData.ObjectPath))
+		{
+			TotalPermutations += OutStats.Add_GetRef(*Cached).EstimatedPermutations;
+			continue;
+		}
+
+		const UMaterial* Material = Cast<UMaterial>(AssetData.GetAsset());
+		if (!Material)
+		{
+			continue;
+		}
+
+		const FAtlasShaderStat& Stat = OutStats.Add_GetRef(AnalyzeMaterial(Material));
+		TotalPermutations += Stat.EstimatedPermutations;
+
+		if (OutStats.Num() % GarbageCollectInterval == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	UE_LOG(LogAtlas, Log, TEXT("Analyzed %d master materials: an estimated %lld shaders in %.2fs"),
+		OutStats.Num(), TotalPermutations, FPlatformTime::Seconds() - StartTime);
+}
+
+FAtlasShaderStat FAtlasShaderAnalyzer::AnalyzeMaterial(const UMaterial* Material)
+{
+	using namespace AtlasShaderAnalyzer;
+
+	FAtlasShaderStat Stat;
+	if (!Material)
+	{
+		return Stat;
+	}
+
+	Stat.Path = Material->GetPathName();
+
+	const FName MaterialPath(*Stat.Path);
+	if (CacheDepth > 0)
+	{
+		if (const FAtlasShaderStat* Cached = CachedStats.Find(MaterialPath))
+		{
+			return *Cached;
+		}
+	}
+
+	TArray<const UMaterialInstance*> Instances;
+	GatherInstances(Material, Instances);
+	Stat.NumInstances = Instances.Num();
+
+	// The master's own shader map; instances without a static permutation render with it
+	TMap<FString, FCombination> Combinations;
+	Combinations.Add(FString(), FCombination(Material->GetBlendMode(), Material->GetShadingModels().IsLit()));
+
+	// Instances with the same static state get the same shader map id, so they are compiled once
+	for (const UMaterialInstance* Instance : Instances)
+	{
+		if (!Instance->bHasStaticPermutationResource)
+		{
+			continue;
+		}
+
+		const FString Key = GetStaticKey(Instance);
+		if (!Combinations.Contains(Key))
+		{
+			Combinations.Add(Key, FCombination(Instance->GetBlendMode(), Instance->GetShadingModels().IsLit()));
+		}
+	}
+
+	Stat.NumStaticCombinations = Combinations.Num();
+	Stat.NumVertexFactories = GetNumVertexFactories(Material);
+
+	for (const TPair<FString, FCombination>& Combination : Combinations)
+	{
+		Stat.EstimatedPermutations += static_cast<int64>(Stat.NumVertexFactories) * GetShadersPerVertexFactory(Material, Combination.Value.BlendMode, Combination.Value.bLit);
+	}
+
+	Stat.EstimatedBytes = Stat.EstimatedPermutations * EstimatedBytesPerShader;
+
+	if (CacheDepth > 0)
+	{
+		CachedStats.Add(MaterialPath, Stat);
+	}
+	return Stat;
+}
+
+void FAtlasShaderAnalyzer::BeginCache()
+{
+	check(IsInGameThread());
+	++AtlasShaderAnalyzer::CacheDepth;
+}
+
+void FAtlasShaderAnalyzer::EndCache()
+{
+	using namespace AtlasShaderAnalyzer;
+
+	check(IsInGameThread() && CacheDepth > 0);
+	if (--CacheDepth == 0)
+	{
+		CachedStats.Empty();
+	}
+}
+
+void FAtlasShaderAnalyzer::GatherInstances(const UMaterial* Material, TArray<const UMaterialInstance*>& OutInstances)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	const FName RootPackage = Material->GetOutermost()->GetFName();
+
+	TSet<FName> Visited;
+	TArray<FName> Pending;
+	Visited.Add(RootPackage);
+	Pending.Add(RootPackage);
+
+	TArray<FName> Referencers;
+	TArray<FAssetData> PackageAssets;
+	while (Pending.Num() > 0)
+	{
+		const FName Current = Pending.Pop(false);
+
+		// Every instance hard-references its parent's package
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(Current, Referencers, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName Referencer : Referencers)
+		{
+			bool bAlreadyVisited = false;
+			Visited.Add(Referencer, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				continue;
+			}
+
+			PackageAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(Referencer, PackageAssets, true);
+
+			bool bHasInstance = false;
+			for (const FAssetData& AssetData : PackageAssets)
+			{
+				if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UMaterialInstance::StaticClass()))
+				{
+					continue;
+				}
+
+				const UMaterialInstance* Instance = Cast<UMaterialInstance>(AssetData.GetAsset());
+				if (Instance && Instance->GetMaterial() == Material)
+				{
+					OutInstances.Add(Instance);
+					bHasInstance = true;
+				}
+			}
+
+			// Instances of this instance reference its package, not the master's
+			if (bHasInstance)
+			{
+				Pending.Add(Referencer);
+			}
+		}
+	}
+}
+
+int32 FAtlasShaderAnalyzer::GetNumVertexFactories(const UMaterial* Material)
+{
+	// Post process, UI, decals, light functions and volumes are not drawn through mesh vertex factories
+	if (Material->MaterialDomain != MD_Surface)
+	{
+		return 1;
+	}
+
+	// The local vertex factory is always compiled
+	int32 NumVertexFactories = 1;
+	for (int32 Usage = 0; Usage < MATUSAGE_MAX; ++Usage)
+	{
+		// Static lighting adds lightmap variants instead, editor compositing never ships
+		if (Usage == MATUSAGE_StaticLighting || Usage == MATUSAGE_EditorCompositing)
+		{
+			continue;
+		}
+
+		if (Material->GetUsageByFlag(static_cast<EMaterialUsage>(Usage)))
+		{
+			++NumVertexFactories;
+		}
+	}
+
+	return NumVertexFactories;
+}
+
+int32 FAtlasShaderAnalyzer::GetShadersPerVertexFactory(const UMaterial* Material, EBlendMode BlendMode, bool bLit)
+{
+	using namespace AtlasShaderAnalyzer;
+
+	if (Material->MaterialDomain != MD_Surface)
+	{
+		return ShadersPerPass;
+	}
+
+	// Lit base passes compile per lightmap policy; without static lighting only the dynamic and volumetric ones
+	const int32 NumBasePasses = !bLit ? 1 : (Material->GetUsageByFlag(MATUSAGE_StaticLighting) ? 4 : 2);
+
+	if (BlendMode != BLEND_Opaque && BlendMode != BLEND_Masked)
+	{
+		return NumBasePasses * ShadersPerPass;
+	}
+
+	// Opaque and masked also draw depth, two shadow depth variants and velocity
+	return (NumBasePasses + 4) * ShadersPerPass;
+}
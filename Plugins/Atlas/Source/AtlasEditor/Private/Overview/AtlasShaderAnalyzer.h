@@ -0,0 +1,72 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "Engine/EngineTypes.h"
+
+struct FAssetData;
+class UMaterial;
+class UMaterialInstance;
+
+/**
+ * Estimates how many shaders each master material compiles
+ *
+ * A master compiles one shader map per distinct static combination: its own, plus one for every
+ * instance with a static permutation (overridden static switches or base properties). Each shader
+ * map holds the mesh passes of the material's blend mode and lighting for every vertex factory its
+ * usage flags enable. The per-pass counts follow the deferred renderer only roughly, so the numbers
+ * are for comparing masters against each other and against a budget, not for predicting DDC size.
+ */
+class FAtlasShaderAnalyzer
+{
+public:
+	/**
+	 * Analyze every master material in a set of assets
+	 * Loads the masters and their instances on the game thread.
+	 * @param Assets Assets to analyze; assets other than materials are ignored
+	 * @param OutStats One entry per master material, in asset order
+	 */
+	static void Analyze(const TArray<FAssetData>& Assets, TArray<FAtlasShaderStat>& OutStats);
+
+	/**
+	 * Analyze one master material and every instance derived from it, directly or through other instances
+	 * @param Material The master material
+	 * @return The estimated shader cost
+	 */
+	static FAtlasShaderStat AnalyzeMaterial(const UMaterial* Material);
+
+	/**
+	 * Keep the stats of analyzed masters until the matching EndCache, so each master loads its instances once
+	 * Calls nest: a scan running the permutation rule and a report pass in one bracket share the results.
+	 * Game thread only.
+	 */
+	static void BeginCache();
+
+	/** Release the stats kept since the outermost BeginCache */
+	static void EndCache();
+
+	/**
+	 * Find the instances whose base material is Material by following package referencers
+	 * @param Material The master material
+	 * @param OutInstances Array to fill with loaded instances
+	 */
+	static void GatherInstances(const UMaterial* Material, TArray<const UMaterialInstance*>& OutInstances);
+
+	/**
+	 * Count the vertex factories a material compiles for: the local one plus one per usage flag
+	 * @param Material The master material
+	 * @return Number of vertex factories
+	 */
+	static int32 GetNumVertexFactories(const UMaterial* Material);
+
+	/**
+	 * Estimate the shaders one vertex factory needs in one static combination
+	 * @param Material The master material, for its domain and static lighting usage
+	 * @param BlendMode Effective blend mode of the combination
+	 * @param bLit Whether the combination's shading model is lit
+	 * @return Vertex and pixel shaders across the mesh passes
+	 */
+	static int32 GetShadersPerVertexFactory(const UMaterial* Material, EBlendMode BlendMode, bool bLit);
+};
@@ -0,0 +1,141 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasStreamingSimulator.h"
+#include "AtlasOverviewStats.h"
+#include "AtlasSettings.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+
+FAtlasStreamingSimulator::FAtlasStreamingSimulator()
+	: Platform(UAtlasSettings::Get()->CostModelPlatform)
+	, LODSettings(FAtlasTextureUtils::GetLODSettings(Platform))
+	, PeakMipSize(0)
+	, SteadyStateMipSize(0)
+{
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+
+	// Mips come in powers of two, so a texture covering N pixels needs the mip of the next power of two
+	PeakMipSize = static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(Settings->StreamingScreenSize, 1)));
+	SteadyStateMipSize = static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(FMath::CeilToInt(Settings->StreamingScreenSize * Settings->StreamingSteadyScreenFraction), 1)));
+}
+
+void FAtlasStreamingSimulator::SimulateLevel(FName LevelPackage, FAtlasStreamingResult& OutResult, int32 TopN) const
+{
+	TArray<FAssetData> Textures;
+	GatherReferencedTextures(LevelPackage, Textures);
+	SimulateTextures(Textures, OutResult, TopN);
+}
+
+void FAtlasStreamingSimulator::SimulateTextures(TConstArrayView<FAssetData> Textures, FAtlasStreamingResult& OutResult, int32 TopN) const
+{
+	OutResult = FAtlasStreamingResult();
+	OutResult.NumTextures = Textures.Num();
+
+	TArray<FAtlasStreamingContributor> Contributors;
+	Contributors.Reserve(Textures.Num());
+
+	for (const FAssetData& AssetData : Textures)
+	{
+		FAtlasTextureCostParams Params;
+		if (!FAtlasTextureUtils::GetCostParamsFromTags(AssetData, Params))
+		{
+			++OutResult.NumUnknown;
+			continue;
+		}
+
+		const FAtlasTextureCost Cost = FAtlasTextureUtils::EstimateCost(Params, Platform, LODSettings);
+
+		FAtlasStreamingContributor& Contributor = Contributors.AddDefaulted_GetRef();
+		Contributor.TexturePath = AssetData.ObjectPath;
+		if (Cost.StreamedBytes > 0)
+		{
+			Contributor.PeakBytes = GetCappedBytes(Params, Cost, PeakMipSize);
+			Contributor.SteadyStateBytes = GetCappedBytes(Params, Cost, SteadyStateMipSize);
+		}
+		else
+		{
+			Contributor.PeakBytes = Cost.TotalBytes;
+			Contributor.SteadyStateBytes = Cost.TotalBytes;
+		}
+
+		OutResult.ResidentBytes += Cost.ResidentBytes;
+		OutResult.SteadyStateBytes += Contributor.SteadyStateBytes;
+		OutResult.PeakBytes += Contributor.PeakBytes;
+	}
+
+	TArray<int32> TopIndices;
+	FAtlasOverviewStats::SelectTopN(Contributors.Num(), TopN, [&Contributors](int32 Index) { return Contributors[Index].SteadyStateBytes; }, TopIndices);
+
+	OutResult.TopContributors.Reserve(TopIndices.Num());
+	for (const int32 Index : TopIndices)
+	{
+		OutResult.TopContributors.Add(Contributors[Index]);
+	}
+}
+
+void FAtlasStreamingSimulator::GatherReferencedTextures(FName PackageName, TArray<FAssetData>& OutTextures)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const FName TextureClassName = UTexture2D::StaticClass()->GetFName();
+
+	TSet<FName> Visited;
+	TArray<FName> Pending;
+	Visited.Add(PackageName);
+	Pending.Add(PackageName);
+
+	TArray<FName> Dependencies;
+	TArray<FAssetData> PackageAssets;
+	while (Pending.Num() > 0)
+	{
+		const FName Current = Pending.Pop(false);
+
+		// Hard references only: those are loaded with the level, soft ones stream on their own terms
+		Dependencies.Reset();
+		AssetRegistry.GetDependencies(Current, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName Dependency : Dependencies)
+		{
+			// Native class packages hold no textures
+			if (Dependency.ToString().StartsWith(TEXT("/Script/")))
+			{
+				continue;
+			}
+
+			bool bAlreadyVisited = false;
+			Visited.Add(Dependency, &bAlreadyVisited);
+			if (bAlreadyVisited)
+			{
+				continue;
+			}
+
+			PackageAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(Dependency, PackageAssets, true);
+
+			for (FAssetData& AssetData : PackageAssets)
+			{
+				if (AssetData.AssetClass == TextureClassName)
+				{
+					OutTextures.Add(MoveTemp(AssetData));
+				}
+			}
+
+			Pending.Add(Dependency);
+		}
+	}
+}
+
+int64 FAtlasStreamingSimulator::GetCappedBytes(const FAtlasTextureCostParams& Params, const FAtlasTextureCost& Cost, int32 MaxSize) const
+{
+	const int32 TopSize = FMath::Max(Cost.SizeX, Cost.SizeY);
+	if (TopSize <= MaxSize)
+	{
+		return Cost.TotalBytes;
+	}
+
+	// Drop mips until the top one fits; the extra bias goes through EstimateCost so group limits still apply
+	FAtlasTextureCostParams CappedParams = Params;
+	CappedParams.LODBias += static_cast<int32>(FMath::CeilLogTwo(TopSize)) - static_cast<int32>(FMath::CeilLogTwo(MaxSize));
+
+	const FAtlasTextureCost CappedCost = FAtlasTextureUtils::EstimateCost(CappedParams, Platform, LODSettings);
+	return FMath::Max(CappedCost.TotalBytes, Cost.ResidentBytes);
+}
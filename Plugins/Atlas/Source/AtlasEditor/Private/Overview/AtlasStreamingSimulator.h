@@ -0,0 +1,111 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+#include "Core/AtlasTextureUtils.h"
+
+struct FAssetData;
+
+/**
+ * One texture's share of a level's texture memory
+ */
+struct FAtlasStreamingContributor
+{
+	/** Object path of the texture */
+	FName TexturePath;
+
+	/** Bytes in memory in steady state */
+	int64 SteadyStateBytes;
+
+	/** Bytes in memory at peak */
+	int64 PeakBytes;
+
+	FAtlasStreamingContributor()
+		: SteadyStateBytes(0)
+		, PeakBytes(0)
+	{
+	}
+};
+
+/**
+ * Expected texture memory of a level or streaming cell
+ */
+struct FAtlasStreamingResult
+{
+	/** Number of textures referenced */
+	int32 NumTextures;
+
+	/** Number of textures skipped because their registry tags are missing */
+	int32 NumUnknown;
+
+	/** Bytes that never leave memory: non-streaming textures and the mip tails of streaming ones */
+	int64 ResidentBytes;
+
+	/** Bytes with streaming textures at the resolution they typically cover on screen */
+	int64 SteadyStateBytes;
+
+	/** Bytes with every streaming texture at the resolution of a full screen */
+	int64 PeakBytes;
+
+	/** Largest textures by steady-state bytes */
+	TArray<FAtlasStreamingContributor> TopContributors;
+
+	FAtlasStreamingResult()
+		: NumTextures(0)
+		, NumUnknown(0)
+		, ResidentBytes(0)
+		, SteadyStateBytes(0)
+		, PeakBytes(0)
+	{
+	}
+};
+
+/**
+ * Estimates streaming-pool residency of the textures a level references
+ *
+ * Textures are costed with FAtlasTextureUtils::EstimateCost. A streaming texture never needs mips
+ * larger than the screen, so its top mip is capped at the screen size for the peak and at the
+ * typical on-screen fraction of it for the steady state. Works from asset registry data only.
+ */
+class FAtlasStreamingSimulator
+{
+public:
+	/** Uses the platform and streaming settings from UAtlasSettings; construct on the game thread */
+	FAtlasStreamingSimulator();
+
+	/**
+	 * Simulate the textures a level references through hard package dependencies
+	 * @param LevelPackage Package name of the level
+	 * @param OutResult Result to fill
+	 * @param TopN Number of top contributors to keep
+	 */
+	void SimulateLevel(FName LevelPackage, FAtlasStreamingResult& OutResult, int32 TopN = 5) const;
+
+	/**
+	 * Simulate an explicit set of textures, e.g. the content of one streaming cell
+	 * @param Textures Texture registry entries
+	 * @param OutResult Result to fill
+	 * @param TopN Number of top contributors to keep
+	 */
+	void SimulateTextures(TConstArrayView<FAssetData> Textures, FAtlasStreamingResult& OutResult, int32 TopN = 5) const;
+
+	/**
+	 * Collect every 2D texture a package references, directly or through other packages
+	 * @param PackageName Package to start from
+	 * @param OutTextures Array to fill with texture registry entries
+	 */
+	static void GatherReferencedTextures(FName PackageName, TArray<FAssetData>& OutTextures);
+
+private:
+	/** Bytes of a streaming texture whose top mip is capped at MaxSize, never less than its resident mip tail */
+	int64 GetCappedBytes(const FAtlasTextureCostParams& Params, const FAtlasTextureCost& Cost, int32 MaxSize) const;
+
+	EAtlasCostPlatform Platform;
+	const UTextureLODSettings* LODSettings;
+
+	/** Largest mip a streaming texture needs at peak and in steady state */
+	int32 PeakMipSize;
+	int32 SteadyStateMipSize;
+};
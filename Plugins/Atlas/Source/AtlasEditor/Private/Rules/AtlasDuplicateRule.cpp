@@ -0,0 +1,68 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasDuplicateRule.h"
+#include "Dedup/AtlasDedupEngine.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+
+FName FAtlasDuplicateRule::GetRuleName() const
+{
+	return TEXT("Duplicate");
+}
+
+FString FAtlasDuplicateRule::GetDescription() const
+{
+	return TEXT("Reports textures and meshes identical to another asset, fixable by consolidating them");
+}
+
+bool FAtlasDuplicateRule::IsEnabled() const
+{
+	// Found by FAtlasDedupEngine across all assets at once, never one asset at a time
+	return false;
+}
+
+bool FAtlasDuplicateRule::SupportsCaching() const
+{
+	return false;
+}
+
+bool FAtlasDuplicateRule::SupportsLiveValidation() const
+{
+	return false;
+}
+
+void FAtlasDuplicateRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UTexture2D::StaticClass());
+	OutClasses.Add(UStaticMesh::StaticClass());
+}
+
+void FAtlasDuplicateRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
+{
+	if (!Asset)
+	{
+		return;
+	}
+
+	const FAssetData AssetData(Asset);
+
+	FAtlasDuplicateGroup Group;
+	if (!FAtlasDedupEngine::FindDuplicatesOf(AssetData, Group))
+	{
+		return;
+	}
+
+	// The group yields one issue per copy; only this asset's belongs to it
+	TArray<FAtlasIssue> GroupIssues;
+	FAtlasDedupEngine::MakeIssues({ Group }, GroupIssues);
+
+	const FString AssetPath = AssetData.ObjectPath.ToString();
+	for (FAtlasIssue& Issue : GroupIssues)
+	{
+		if (Issue.AssetPath == AssetPath)
+		{
+			OutIssues.Add(MoveTemp(Issue));
+		}
+	}
+}
@@ -0,0 +1,28 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IAtlasRule.h"
+
+/**
+ * Owns the Duplicate issues FAtlasDedupEngine reports for identical textures and meshes
+ *
+ * Duplicates are found across the whole project in one pass (AtlasValidate -Dedup), so the rule is
+ * disabled for scans. It is registered so issues restored from a report or the issue store can have
+ * their consolidate fix rebuilt: Validate looks up the asset's group again and reports the same issue.
+ * NearDuplicate issues have no fix, so nothing needs to rebuild them.
+ */
+class FAtlasDuplicateRule : public IAtlasRule
+{
+public:
+	virtual ~FAtlasDuplicateRule() = default;
+
+	virtual FName GetRuleName() const override;
+	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
+	virtual FString GetDescription() const override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsCaching() const override;
+	virtual bool SupportsLiveValidation() const override;
+};
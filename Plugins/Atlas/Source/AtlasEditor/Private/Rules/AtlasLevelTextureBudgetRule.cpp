@@ -0,0 +1,93 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasLevelTextureBudgetRule.h"
+#include "AtlasSettings.h"
+#include "Overview/AtlasStreamingSimulator.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+
+FName FAtlasLevelTextureBudgetRule::GetRuleName() const
+{
+	return TEXT("LevelTextureBudget");
+}
+
+FString FAtlasLevelTextureBudgetRule::GetDescription() const
+{
+	return TEXT("Ensures the textures a level references fit the texture streaming budget");
+}
+
+bool FAtlasLevelTextureBudgetRule::IsEnabled() const
+{
+	return true;
+}
+
+bool FAtlasLevelTextureBudgetRule::SupportsCaching() const
+{
+	// The result changes when any referenced texture changes, not only the level package
+	return false;
+}
+
+void FAtlasLevelTextureBudgetRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UWorld::StaticClass());
+}
+
+void FAtlasLevelTextureBudgetRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
+{
+	const UWorld* World = Cast<UWorld>(Asset);
+	if (!World)
+	{
+		return;
+	}
+
+	ValidateLevel(World->GetPathName(), World->GetName(), World->GetOutermost()->GetFName(), OutIssues);
+}
+
+bool FAtlasLevelTextureBudgetRule::CanValidateAssetData(const FAssetData& AssetData) const
+{
+	// Dependencies and texture tags all come from the asset registry
+	return true;
+}
+
+void FAtlasLevelTextureBudgetRule::ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues)
+{
+	ValidateLevel(AssetData.ObjectPath.ToString(), AssetData.AssetName.ToString(), AssetData.PackageName, OutIssues);
+}
+
+void FAtlasLevelTextureBudgetRule::ValidateLevel(const FString& AssetPath, const FString& AssetName, FName PackageName, TArray<FAtlasIssue>& OutIssues)
+{
+	const int64 BudgetMB = UAtlasSettings::Get()->TargetVRAMMB;
+	const int64 BudgetBytes = BudgetMB * 1024 * 1024;
+
+	FAtlasStreamingResult Result;
+	FAtlasStreamingSimulator().SimulateLevel(PackageName, Result);
+
+	if (Result.SteadyStateBytes > BudgetBytes)
+	{
+		FString Message = FString::Printf(
+			TEXT("Level '%s' needs %lld MB of texture memory in steady state, over the %lld MB budget. Largest: %s"),
+			*AssetName, Result.SteadyStateBytes / (1024 * 1024), BudgetMB, *DescribeTopContributors(Result));
+
+		OutIssues.Add(FAtlasIssue(AssetPath, GetRuleName(), EAtlasSeverity::Error, Message, false));
+	}
+	else if (Result.PeakBytes > BudgetBytes)
+	{
+		FString Message = FString::Printf(
+			TEXT("Level '%s' peaks at %lld MB of texture memory with textures at full screen resolution, over the %lld MB budget. Largest: %s"),
+			*AssetName, Result.PeakBytes / (1024 * 1024), BudgetMB, *DescribeTopContributors(Result));
+
+		OutIssues.Add(FAtlasIssue(AssetPath, GetRuleName(), EAtlasSeverity::Warning, Message, false));
+	}
+}
+
+FString FAtlasLevelTextureBudgetRule::DescribeTopContributors(const FAtlasStreamingResult& Result)
+{
+	TArray<FString> Parts;
+	for (const FAtlasStreamingContributor& Contributor : Result.TopContributors)
+	{
+		Parts.Add(FString::Printf(TEXT("'%s' (%lld MB)"), *FPackageName::ObjectPathToObjectName(Contributor.TexturePath.ToString()), Contributor.SteadyStateBytes / (1024 * 1024)));
+	}
+
+	return FString::Join(Parts, TEXT(", "));
+}
@@ -0,0 +1,31 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IAtlasRule.h"
+
+struct FAtlasStreamingResult;
+
+/**
+ * Validates that the textures a level references fit the texture memory budget (TargetVRAMMB).
+ * Steady-state overruns are errors, peak-only overruns are warnings.
+ */
+class FAtlasLevelTextureBudgetRule : public IAtlasRule
+{
+public:
+	virtual ~FAtlasLevelTextureBudgetRule() = default;
+
+	virtual FName GetRuleName() const override;
+	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const override;
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
+	virtual FString GetDescription() const override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsCaching() const override;
+
+private:
+	void ValidateLevel(const FString& AssetPath, const FString& AssetName, FName PackageName, TArray<FAtlasIssue>& OutIssues);
+	static FString DescribeTopContributors(const FAtlasStreamingResult& Result);
+};
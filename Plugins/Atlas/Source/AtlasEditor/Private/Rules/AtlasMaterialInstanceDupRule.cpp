@@ -0,0 +1,393 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasMaterialInstanceDupRule.h"
+#include "AtlasSettings.h"
+#include "Core/AtlasAssetUtils.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Font.h"
+#include "Engine/Texture.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+#include "VT/RuntimeVirtualTexture.h"
+
+namespace AtlasMaterialInstanceDupRule
+{
+	static int64 Quantize(float Value, float Tolerance)
+	{
+		return static_cast<int64>(FMath::RoundToDouble(static_cast<double>(Value) / Tolerance));
+	}
+
+	static FString QuantizeColor(const FLinearColor& Color, float Tolerance)
+	{
+		return FString::Printf(TEXT("%lld,%lld,%lld,%lld"),
+			Quantize(Color.R, Tolerance), Quantize(Color.G, Tolerance), Quantize(Color.B, Tolerance), Quantize(Color.A, Tolerance));
+	}
+
+	static FString GetParameterKey(const FMaterialParameterInfo& Info)
+	{
+		return FString::Printf(TEXT("%s/%d/%d"), *Info.Name.ToString(), static_cast<int32>(Info.Association), Info.Index);
+	}
+
+	static FString GetObjectKey(const UObject* Object)
+	{
+		return Object ? Object->GetPathName() : FString(TEXT("None"));
+	}
+
+	/** Object path of an instance's parent from its registry tags, or NAME_None */
+	static FName GetParentPath(const FAssetData& AssetData)
+	{
+		const FString ParentTag = AssetData.GetTagValueRef<FString>(GET_MEMBER_NAME_CHECKED(UMaterialInstance, Parent));
+		if (ParentTag.IsEmpty() || ParentTag == TEXT("None"))
+		{
+			return NAME_None;
+		}
+		return FName(*FPackageName::ExportTextPathToObjectPath(ParentTag));
+	}
+}
+
+FAtlasMaterialInstanceDupRule::FAtlasMaterialInstanceDupRule()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAtlasMaterialInstanceDupRule::OnAssetChanged);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAtlasMaterialInstanceDupRule::OnAssetChanged);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAtlasMaterialInstanceDupRule::OnAssetRenamed);
+	AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddRaw(this, &FAtlasMaterialInstanceDupRule::OnAssetChanged);
+
+	// Unsaved edits change hashes without a registry event
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FAtlasMaterialInstanceDupRule::OnObjectPropertyChanged);
+}
+
+FAtlasMaterialInstanceDupRule::~FAtlasMaterialInstanceDupRule()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+	}
+
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+}
+
+FName FAtlasMaterialInstanceDupRule::GetRuleName() const
+{
+	return TEXT("MaterialInstanceDup");
+}
+
+FString FAtlasMaterialInstanceDupRule::GetDescription() const
+{
+	return TEXT("Finds material instances with the same parent and the same effective overrides");
+}
+
+bool FAtlasMaterialInstanceDupRule::IsEnabled() const
+{
+	return true;
+}
+
+bool FAtlasMaterialInstanceDupRule::SupportsCaching() const
+{
+	// The result changes when a sibling instance changes, not only this package
+	return false;
+}
+
+bool FAtlasMaterialInstanceDupRule::SupportsLiveValidation() const
+{
+	// The first check of an instance loads its whole family
+	return false;
+}
+
+void FAtlasMaterialInstanceDupRule::BeginScan()
+{
+	// Start a scan from scratch in case an edit slipped past the invalidation events
+	GroupsByParent.Reset();
+}
+
+void FAtlasMaterialInstanceDupRule::OnAssetChanged(const FAssetData& AssetData)
+{
+	using namespace AtlasMaterialInstanceDupRule;
+
+	if (GroupsByParent.Num() == 0 || !FAtlasAssetUtils::IsAssetOfClass(AssetData, UMaterialInterface::StaticClass()))
+	{
+		return;
+	}
+
+	// The asset may itself be a parent
+	GroupsByParent.Remove(AssetData.ObjectPath);
+
+	if (FAtlasAssetUtils::IsAssetOfClass(AssetData, UMaterialInstanceConstant::StaticClass()))
+	{
+		const FName ParentPath = GetParentPath(AssetData);
+		if (ParentPath.IsNone())
+		{
+			GroupsByParent.Reset();
+		}
+		else
+		{
+			GroupsByParent.Remove(ParentPath);
+		}
+	}
+}
+
+void FAtlasMaterialInstanceDupRule::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	GroupsByParent.Remove(FName(*OldObjectPath));
+	OnAssetChanged(AssetData);
+}
+
+void FAtlasMaterialInstanceDupRule::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (GroupsByParent.Num() == 0 || !Object || !Object->IsA<UMaterialInterface>())
+	{
+		return;
+	}
+
+	GroupsByParent.Remove(FName(*Object->GetPathName()));
+
+	if (const UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(Object))
+	{
+		// The previous parent is unknown after a reparent, so every family is dropped
+		if (Event.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UMaterialInstance, Parent) || !Instance->Parent)
+		{
+			GroupsByParent.Reset();
+		}
+		else
+		{
+			GroupsByParent.Remove(FName(*Instance->Parent->GetPathName()));
+		}
+	}
+}
+
+void FAtlasMaterialInstanceDupRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UMaterialInstanceConstant::StaticClass());
+}
+
+void FAtlasMaterialInstanceDupRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
+{
+	const UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(Asset);
+	if (!Instance || !Instance->Parent)
+	{
+		return;
+	}
+
+	// Every sibling of a family shares one grouping, built on the first check of any of them
+	const FName ParentPath(*Instance->Parent->GetPathName());
+	const FSiblingGroups* Groups = GroupsByParent.Find(ParentPath);
+	if (!Groups)
+	{
+		FSiblingGroups& NewGroups = GroupsByParent.Add(ParentPath);
+		BuildSiblingGroups(Instance->Parent, NewGroups);
+		Groups = &NewGroups;
+	}
+
+	const FName InstancePath(*Instance->GetPathName());
+	const FBlake3Hash* Hash = Groups->Hashes.Find(InstancePath);
+	if (!Hash)
+	{
+		return;
+	}
+
+	const FName KeepPath = Groups->KeepPaths.FindRef(*Hash);
+	if (KeepPath.IsNone() || KeepPath == InstancePath)
+	{
+		return;
+	}
+
+	const FString DuplicatePath = InstancePath.ToString();
+	const FString KeepPathString = KeepPath.ToString();
+
+	FString Message = FString::Printf(
+		TEXT("Material instance '%s' duplicates '%s' (%d equivalent instances of '%s')"),
+		*Instance->GetName(),
+		*FPackageName::ObjectPathToObjectName(KeepPathString),
+		Groups->Counts.FindRef(*Hash),
+		*Instance->Parent->GetName()
+	);
+
+	FAtlasIssue Issue(DuplicatePath, GetRuleName(), EAtlasSeverity::Warning, Message, true);
+
+	// Each issue consolidates only its own instance, so fixing a subset of a group works
+	Issue.FixFunction = [KeepPathString, DuplicatePath]() -> bool
+	{
+		UObject* AssetToKeep = FAtlasAssetUtils::LoadAsset(KeepPathString);
+		UObject* Duplicate = FAtlasAssetUtils::LoadAsset(DuplicatePath);
+		if (!AssetToKeep || !Duplicate)
+		{
+			return false;
+		}
+
+		return FAtlasAssetUtils::ConsolidateAssets(AssetToKeep, { Duplicate });
+	};
+
+	OutIssues.Add(Issue);
+}
+
+FBlake3Hash FAtlasMaterialInstanceDupRule::ComputeCanonicalHash(const UMaterialInstanceConstant* Instance, float Tolerance)
+{
+	using namespace AtlasMaterialInstanceDupRule;
+
+	Tolerance = FMath::Max(Tolerance, SMALL_NUMBER);
+	const UMaterialInterface* Parent = Instance->Parent;
+
+	// One line per effective override, sorted so the order parameters were added in does not matter
+	TArray<FString> Lines;
+
+	for (const FScalarParameterValue& Parameter : Instance->ScalarParameterValues)
+	{
+		const int64 Value = Quantize(Parameter.ParameterValue, Tolerance);
+
+		float Inherited = 0.0f;
+		if (Parent && Parent->GetScalarParameterValue(Parameter.ParameterInfo, Inherited) && Quantize(Inherited, Tolerance) == Value)
+		{
+			continue;
+		}
+
+		Lines.Add(FString::Printf(TEXT("S %s=%lld"), *GetParameterKey(Parameter.ParameterInfo), Value));
+	}
+
+	for (const FVectorParameterValue& Parameter : Instance->VectorParameterValues)
+	{
+		const FString Value = QuantizeColor(Parameter.ParameterValue, Tolerance);
+
+		FLinearColor Inherited;
+		if (Parent && Parent->GetVectorParameterValue(Parameter.ParameterInfo, Inherited) && QuantizeColor(Inherited, Tolerance) == Value)
+		{
+			continue;
+		}
+
+		Lines.Add(FString::Printf(TEXT("V %s=%s"), *GetParameterKey(Parameter.ParameterInfo), *Value));
+	}
+
+	for (const FTextureParameterValue& Parameter : Instance->TextureParameterValues)
+	{
+		UTexture* Inherited = nullptr;
+		if (Parent && Parent->GetTextureParameterValue(Parameter.ParameterInfo, Inherited) && Inherited == Parameter.ParameterValue)
+		{
+			continue;
+		}
+
+		Lines.Add(FString::Printf(TEXT("T %s=%s"), *GetParameterKey(Parameter.ParameterInfo), *GetObjectKey(Parameter.ParameterValue)));
+	}
+
+	for (const FRuntimeVirtualTextureParameterValue& Parameter : Instance->RuntimeVirtualTextureParameterValues)
+	{
+		Lines.Add(FString::Printf(TEXT("R %s=%s"), *GetParameterKey(Parameter.ParameterInfo), *GetObjectKey(Parameter.ParameterValue)));
+	}
+
+	for (const FFontParameterValue& Parameter : Instance->FontParameterValues)
+	{
+		Lines.Add(FString::Printf(TEXT("F %s=%s:%d"), *GetParameterKey(Parameter.ParameterInfo), *GetObjectKey(Parameter.FontValue), Parameter.FontPage));
+	}
+
+	// Static switches select shader permutations, so they count even when they match the parent
+	for (const FStaticSwitchParameter& Parameter : Instance->GetStaticParameters().StaticSwitchParameters)
+	{
+		if (Parameter.bOverride)
+		{
+			Lines.Add(FString::Printf(TEXT("W %s=%d"), *GetParameterKey(Parameter.ParameterInfo), Parameter.Value ? 1 : 0));
+		}
+	}
+
+	const FMaterialInstanceBasePropertyOverrides& Overrides = Instance->BasePropertyOverrides;
+	if (Overrides.bOverride_BlendMode)
+	{
+		Lines.Add(FString::Printf(TEXT("P BlendMode=%d"), static_cast<int32>(Overrides.BlendMode)));
+	}
+	if (Overrides.bOverride_ShadingModel)
+	{
+		Lines.Add(FString::Printf(TEXT("P ShadingModel=%d"), static_cast<int32>(Overrides.ShadingModel)));
+	}
+	if (Overrides.bOverride_TwoSided)
+	{
+		Lines.Add(FString::Printf(TEXT("P TwoSided=%d"), Overrides.TwoSided ? 1 : 0));
+	}
+	if (Overrides.bOverride_DitheredLODTransition)
+	{
+		Lines.Add(FString::Printf(TEXT("P DitheredLODTransition=%d"), Overrides.DitheredLODTransition ? 1 : 0));
+	}
+	if (Overrides.bOverride_OpacityMaskClipValue)
+	{
+		Lines.Add(FString::Printf(TEXT("P OpacityMaskClipValue=%lld"), Quantize(Overrides.OpacityMaskClipValue, Tolerance)));
+	}
+
+	Lines.Sort();
+
+	// The parent determines the rest of the chain, so its path stands for all of it
+	FString Canonical = GetObjectKey(Parent);
+	for (const FString& Line : Lines)
+	{
+		Canonical += TEXT('\n');
+		Canonical += Line;
+	}
+
+	const FTCHARToUTF8 Utf8(*Canonical);
+	return FBlake3::HashBuffer(Utf8.Get(), Utf8.Length());
+}
+
+void FAtlasMaterialInstanceDupRule::BuildSiblingGroups(const UMaterialInterface* Parent, FSiblingGroups& OutGroups)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const float Tolerance = UAtlasSettings::Get()->MaterialInstanceParameterTolerance;
+
+	// Every instance hard-references its parent's package
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(Parent->GetOutermost()->GetFName(), Referencers, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+	Referencers.Sort(FNameLexicalLess());
+
+	// Single pass: hash each sibling once and bucket it by hash
+	TMap<FBlake3Hash, TArray<FName>> Members;
+	TArray<FAssetData> PackageAssets;
+	for (const FName Referencer : Referencers)
+	{
+		PackageAssets.Reset();
+		AssetRegistry.GetAssetsByPackageName(Referencer, PackageAssets, true);
+
+		for (const FAssetData& AssetData : PackageAssets)
+		{
+			if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UMaterialInstanceConstant::StaticClass()))
+			{
+				continue;
+			}
+
+			const UMaterialInstanceConstant* Sibling = Cast<UMaterialInstanceConstant>(AssetData.GetAsset());
+			if (!Sibling || Sibling->Parent != Parent)
+			{
+				continue;
+			}
+
+			const FBlake3Hash Hash = ComputeCanonicalHash(Sibling, Tolerance);
+			OutGroups.Hashes.Add(AssetData.ObjectPath, Hash);
+			Members.FindOrAdd(Hash).Add(AssetData.ObjectPath);
+		}
+	}
+
+	// Keep the most referenced instance so consolidation leaves the fewest references to fix up
+	TArray<FName> InstanceReferencers;
+	for (TPair<FBlake3Hash, TArray<FName>>& Group : Members)
+	{
+		OutGroups.Counts.Add(Group.Key, Group.Value.Num());
+
+		FName KeepPath = Group.Value[0];
+		if (Group.Value.Num() > 1)
+		{
+			int32 KeepReferencers = -1;
+			for (const FName Path : Group.Value)
+			{
+				InstanceReferencers.Reset();
+				AssetRegistry.GetReferencers(FName(*FPackageName::ObjectPathToPackageName(Path.ToString())), InstanceReferencers);
+
+				// Members are in path order, so ties keep the first path
+				if (InstanceReferencers.Num() > KeepReferencers)
+				{
+					KeepPath = Path;
+					KeepReferencers = InstanceReferencers.Num();
+				}
+			}
+		}
+
+		OutGroups.KeepPaths.Add(Group.Key, KeepPath);
+	}
+}
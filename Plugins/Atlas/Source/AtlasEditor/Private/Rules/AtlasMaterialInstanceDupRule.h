@@ -0,0 +1,79 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IAtlasRule.h"
+#include "Hash/Blake3.h"
+
+struct FAssetData;
+struct FPropertyChangedEvent;
+class UMaterialInterface;
+class UMaterialInstanceConstant;
+
+/**
+ * Finds material instances that duplicate a sibling: same parent, same property and static switch
+ * overrides, and parameter overrides equal within MaterialInstanceParameterTolerance.
+ * Each duplicate is fixable by consolidating it into the most referenced instance of its group.
+ *
+ * Grouping a parent's instances loads all of them, so groups are cached per parent until an instance
+ * or parent of the family changes (asset registry events or property edits). Full scans start from an
+ * empty cache; single-asset checks such as fix resolution reuse it. The rule does not run in live
+ * validation, where the first check of a large family would still stall the editor.
+ */
+class FAtlasMaterialInstanceDupRule : public IAtlasRule
+{
+public:
+	FAtlasMaterialInstanceDupRule();
+	virtual ~FAtlasMaterialInstanceDupRule();
+
+	virtual FName GetRuleName() const override;
+	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
+	virtual FString GetDescription() const override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsCaching() const override;
+	virtual bool SupportsLiveValidation() const override;
+	virtual void BeginScan() override;
+
+	/**
+	 * Hash everything that makes an instance render differently from its siblings
+	 * Overrides equal to the inherited value are left out, and values are bucketed by Tolerance,
+	 * so the hash does not depend on which redundant overrides happen to be set.
+	 * @param Instance The instance to hash
+	 * @param Tolerance Bucket size for scalar and vector parameter values
+	 * @return The canonical hash
+	 */
+	static FBlake3Hash ComputeCanonicalHash(const UMaterialInstanceConstant* Instance, float Tolerance);
+
+private:
+	/** Instances sharing one parent, grouped by canonical hash */
+	struct FSiblingGroups
+	{
+		/** Canonical hash of each instance */
+		TMap<FName, FBlake3Hash> Hashes;
+
+		/** Instance every other instance with the same hash should be consolidated into */
+		TMap<FBlake3Hash, FName> KeepPaths;
+
+		/** Number of instances with each hash */
+		TMap<FBlake3Hash, int32> Counts;
+	};
+
+	/** Load and hash every instance whose parent is Parent, in one pass */
+	static void BuildSiblingGroups(const UMaterialInterface* Parent, FSiblingGroups& OutGroups);
+
+	/** Drop the cached groups of a material's family, or everything if its parent is unknown */
+	void OnAssetChanged(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+
+	/** Sibling groups by parent path */
+	TMap<FName, FSiblingGroups> GroupsByParent;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle AssetUpdatedHandle;
+	FDelegateHandle PropertyChangedHandle;
+};
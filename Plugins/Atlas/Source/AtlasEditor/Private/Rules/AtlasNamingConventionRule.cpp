@@ -3,7 +3,9 @@
 #include "AtlasNamingConventionRule.h"
 #include "AtlasSettings.h"
 #include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasFixExecutor.h"
 #include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
 #include "Materials/Material.h"
@@ -24,6 +26,11 @@ bool FAtlasNamingConventionRule::IsEnabled() const
 	return true;
 }
 
+bool FAtlasNamingConventionRule::IsThreadSafe() const
+{
+	return true;
+}
+
 void FAtlasNamingConventionRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
 {
 	if (!Asset)
@@ -31,15 +38,30 @@ void FAtlasNamingConventionRule::Validate(const UObject* Asset, TArray<FAtlasIss
 		return;
 	}
 
+	ValidateNaming(Asset->GetPathName(), Asset->GetName(), Asset->GetClass()->GetFName(), Asset->GetClass(), OutIssues);
+}
+
+bool FAtlasNamingConventionRule::CanValidateAssetData(const FAssetData& AssetData) const
+{
+	// Name, class and path are always part of the registry entry
+	return true;
+}
+
+void FAtlasNamingConventionRule::ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues)
+{
+	ValidateNaming(AssetData.ObjectPath.ToString(), AssetData.AssetName.ToString(), AssetData.AssetClass, AssetData.GetClass(), OutIssues);
+}
+
+void FAtlasNamingConventionRule::ValidateNaming(const FString& AssetPath, const FString& AssetName, FName ClassName, const UClass* Class, TArray<FAtlasIssue>& OutIssues)
+{
 	// Check prefix
 	FString ExpectedPrefix;
-	if (!HasCorrectPrefix(Asset, ExpectedPrefix))
+	if (!HasCorrectPrefix(AssetName, ClassName, ExpectedPrefix))
 	{
-		FString AssetName = Asset->GetName();
 		FString Message = FString::Printf(TEXT("Asset '%s' should start with prefix '%s'"), *AssetName, *ExpectedPrefix);
 
 		FAtlasIssue Issue(
-			Asset->GetPathName(),
+			AssetPath,
 			GetRuleName(),
 			EAtlasSeverity::Warning,
 			Message,
@@ -48,20 +70,19 @@ void FAtlasNamingConventionRule::Validate(const UObject* Asset, TArray<FAtlasIss
 
 		// Create fix function
 		FString ExpectedName = ExpectedPrefix + AssetName;
-		CreateFixFunction(Issue, Asset, ExpectedName);
+		CreateFixFunction(Issue, AssetPath, ExpectedName);
 
 		OutIssues.Add(Issue);
 	}
 
 	// Check path
 	FString ExpectedPath;
-	if (!HasCorrectPath(Asset, ExpectedPath))
+	if (!HasCorrectPath(AssetPath, Class, ExpectedPath))
 	{
-		FString CurrentPath = Asset->GetPathName();
 		FString Message = FString::Printf(TEXT("Asset should be in '%s' folder"), *ExpectedPath);
 
 		FAtlasIssue Issue(
-			CurrentPath,
+			AssetPath,
 			GetRuleName(),
 			EAtlasSeverity::Warning,
 			Message,
@@ -72,14 +93,8 @@ void FAtlasNamingConventionRule::Validate(const UObject* Asset, TArray<FAtlasIss
 	}
 }
 
-bool FAtlasNamingConventionRule::HasCorrectPrefix(const UObject* Asset, FString& OutExpectedPrefix) const
+bool FAtlasNamingConventionRule::HasCorrectPrefix(const FString& AssetName, FName ClassName, FString& OutExpectedPrefix) const
 {
-	if (!Asset)
-	{
-		return true;
-	}
-
-	FName ClassName = Asset->GetClass()->GetFName();
 	OutExpectedPrefix = FAtlasAssetUtils::GetPrefixForAssetType(ClassName);
 
 	if (OutExpectedPrefix.IsEmpty())
@@ -87,13 +102,12 @@ bool FAtlasNamingConventionRule::HasCorrectPrefix(const UObject* Asset, FString&
 		return true; // No prefix requirement
 	}
 
-	FString AssetName = Asset->GetName();
 	return AssetName.StartsWith(OutExpectedPrefix);
 }
 
-bool FAtlasNamingConventionRule::HasCorrectPath(const UObject* Asset, FString& OutExpectedPath) const
+bool FAtlasNamingConventionRule::HasCorrectPath(const FString& AssetPath, const UClass* Class, FString& OutExpectedPath) const
 {
-	if (!Asset)
+	if (!Class)
 	{
 		return true;
 	}
@@ -104,18 +118,16 @@ bool FAtlasNamingConventionRule::HasCorrectPath(const UObject* Asset, FString& O
 		return true;
 	}
 
-	FString CurrentPath = Asset->GetPathName();
-
 	// Determine expected path based on asset type
-	if (Asset->IsA<UStaticMesh>())
+	if (Class->IsChildOf<UStaticMesh>())
 	{
 		OutExpectedPath = Settings->MeshRoot.Path;
 	}
-	else if (Asset->IsA<UTexture2D>())
+	else if (Class->IsChildOf<UTexture2D>())
 	{
 		OutExpectedPath = Settings->TextureRoot.Path;
 	}
-	else if (Asset->IsA<UMaterial>() || Asset->IsA<UMaterialInstance>())
+	else if (Class->IsChildOf<UMaterial>() || Class->IsChildOf<UMaterialInstance>())
 	{
 		OutExpectedPath = Settings->MaterialRoot.Path;
 	}
@@ -124,24 +136,18 @@ bool FAtlasNamingConventionRule::HasCorrectPath(const UObject* Asset, FString& O
 		return true; // No path requirement for this type
 	}
 
-	return CurrentPath.StartsWith(OutExpectedPath);
+	return AssetPath.StartsWith(OutExpectedPath);
 }
 
-void FAtlasNamingConventionRule::CreateFixFunction(FAtlasIssue& Issue, const UObject* Asset, const FString& ExpectedName)
+void FAtlasNamingConventionRule::CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, const FString& ExpectedName)
 {
-	Issue.FixFunction = [Asset, ExpectedName]() -> bool
+	Issue.FixFunction = [AssetPath, ExpectedName]() -> bool
 	{
-		if (!Asset)
-		{
-			return false;
-		}
-
-		FName AssetPath = FName(*Asset->GetPathName());
-		bool bSuccess = FAtlasAssetUtils::RenameAsset(AssetPath, ExpectedName);
+		bool bSuccess = FAtlasFixExecutor::RenameAsset(AssetPath, ExpectedName);
 
 		if (bSuccess)
 		{
-			UE_LOG(LogAtlas, Log, TEXT("Fixed naming: %s -> %s"), *Asset->GetName(), *ExpectedName);
+			UE_LOG(LogAtlas, Log, TEXT("Fixed naming: %s -> %s"), *AssetPath, *ExpectedName);
 		}
 
 		return bSuccess;
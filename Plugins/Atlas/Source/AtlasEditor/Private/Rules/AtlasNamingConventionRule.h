@@ -15,11 +15,15 @@ public:
 
 	virtual FName GetRuleName() const override;
 	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const override;
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) override;
 	virtual FString GetDescription() const override;
 	virtual bool IsEnabled() const override;
+	virtual bool IsThreadSafe() const override;
 
 private:
-	bool HasCorrectPrefix(const UObject* Asset, FString& OutExpectedPrefix) const;
-	bool HasCorrectPath(const UObject* Asset, FString& OutExpectedPath) const;
-	void CreateFixFunction(FAtlasIssue& Issue, const UObject* Asset, const FString& ExpectedName);
+	void ValidateNaming(const FString& AssetPath, const FString& AssetName, FName ClassName, const UClass* Class, TArray<FAtlasIssue>& OutIssues);
+	bool HasCorrectPrefix(const FString& AssetName, FName ClassName, FString& OutExpectedPrefix) const;
+	bool HasCorrectPath(const FString& AssetPath, const UClass* Class, FString& OutExpectedPath) const;
+	void CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, const FString& ExpectedName);
 };
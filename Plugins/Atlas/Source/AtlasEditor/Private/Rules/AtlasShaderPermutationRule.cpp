@@ -0,0 +1,77 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasShaderPermutationRule.h"
+#include "AtlasSettings.h"
+#include "Overview/AtlasShaderAnalyzer.h"
+#include "Materials/Material.h"
+
+FName FAtlasShaderPermutationRule::GetRuleName() const
+{
+	return TEXT("ShaderPermutationBudget");
+}
+
+FString FAtlasShaderPermutationRule::GetDescription() const
+{
+	return TEXT("Ensures master materials and their instances stay within the shader permutation budget");
+}
+
+bool FAtlasShaderPermutationRule::IsEnabled() const
+{
+	return true;
+}
+
+bool FAtlasShaderPermutationRule::SupportsCaching() const
+{
+	// The estimate changes when any instance of the master changes, not only the master's package
+	return false;
+}
+
+bool FAtlasShaderPermutationRule::SupportsLiveValidation() const
+{
+	// Saving a master would load all of its instances
+	return false;
+}
+
+void FAtlasShaderPermutationRule::BeginScan()
+{
+	FAtlasShaderAnalyzer::BeginCache();
+}
+
+void FAtlasShaderPermutationRule::EndScan()
+{
+	FAtlasShaderAnalyzer::EndCache();
+}
+
+void FAtlasShaderPermutationRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UMaterial::StaticClass());
+}
+
+void FAtlasShaderPermutationRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
+{
+	const UMaterial* Material = Cast<UMaterial>(Asset);
+	if (!Material)
+	{
+		return;
+	}
+
+	const int32 MaxPermutations = UAtlasSettings::Get()->MaxShaderPermutations;
+	const FAtlasShaderStat Stat = FAtlasShaderAnalyzer::AnalyzeMaterial(Material);
+	if (Stat.EstimatedPermutations <= MaxPermutations)
+	{
+		return;
+	}
+
+	FString Message = FString::Printf(
+		TEXT("Material '%s' compiles an estimated %lld shaders (%.1f MB), budget %d: %d static combinations across %d instances, %d vertex factories"),
+		*Material->GetName(),
+		Stat.EstimatedPermutations,
+		Stat.EstimatedBytes / (1024.0 * 1024.0),
+		MaxPermutations,
+		Stat.NumStaticCombinations,
+		Stat.NumInstances,
+		Stat.NumVertexFactories
+	);
+
+	OutIssues.Add(FAtlasIssue(Material->GetPathName(), GetRuleName(), EAtlasSeverity::Warning, Message, false));
+}
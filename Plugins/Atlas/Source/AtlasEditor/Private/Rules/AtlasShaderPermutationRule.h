@@ -0,0 +1,28 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IAtlasRule.h"
+
+/**
+ * Validates that a master material and its instances stay within the shader permutation budget
+ * (MaxShaderPermutations), using the estimate of FAtlasShaderAnalyzer.
+ * The estimate loads every instance of the master, so it is cached for the whole scan and never runs
+ * in live validation.
+ */
+class FAtlasShaderPermutationRule : public IAtlasRule
+{
+public:
+	virtual ~FAtlasShaderPermutationRule() = default;
+
+	virtual FName GetRuleName() const override;
+	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
+	virtual FString GetDescription() const override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsCaching() const override;
+	virtual bool SupportsLiveValidation() const override;
+	virtual void BeginScan() override;
+	virtual void EndScan() override;
+};
@@ -2,7 +2,9 @@
 
 #include "AtlasStaticMeshCollisionRule.h"
 #include "Core/AtlasMeshUtils.h"
+#include "Core/AtlasAssetUtils.h"
 #include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
 #include "Engine/StaticMesh.h"
 
 FName FAtlasStaticMeshCollisionRule::GetRuleName() const
@@ -20,6 +22,16 @@ bool FAtlasStaticMeshCollisionRule::IsEnabled() const
 	return true;
 }
 
+bool FAtlasStaticMeshCollisionRule::IsThreadSafe() const
+{
+	return true;
+}
+
+void FAtlasStaticMeshCollisionRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UStaticMesh::StaticClass());
+}
+
 void FAtlasStaticMeshCollisionRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
 {
 	const UStaticMesh* Mesh = Cast<UStaticMesh>(Asset);
@@ -28,16 +40,48 @@ void FAtlasStaticMeshCollisionRule::Validate(const UObject* Asset, TArray<FAtlas
 		return;
 	}
 
+	ValidateCollision(Mesh->GetPathName(), Mesh->GetName(), FAtlasMeshUtils::HasCollision(Mesh), OutIssues);
+}
+
+bool FAtlasStaticMeshCollisionRule::CanValidateAssetData(const FAssetData& AssetData) const
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UStaticMesh::StaticClass()))
+	{
+		return true; // Nothing to check for other asset types
+	}
+
+	int32 CollisionPrims = 0;
+	return FAtlasMeshUtils::GetCollisionPrimCountFromTags(AssetData, CollisionPrims);
+}
+
+void FAtlasStaticMeshCollisionRule::ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues)
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UStaticMesh::StaticClass()))
+	{
+		return;
+	}
+
+	int32 CollisionPrims = 0;
+	if (!FAtlasMeshUtils::GetCollisionPrimCountFromTags(AssetData, CollisionPrims))
+	{
+		return;
+	}
+
+	ValidateCollision(AssetData.ObjectPath.ToString(), AssetData.AssetName.ToString(), CollisionPrims > 0, OutIssues);
+}
+
+void FAtlasStaticMeshCollisionRule::ValidateCollision(const FString& AssetPath, const FString& AssetName, bool bHasCollision, TArray<FAtlasIssue>& OutIssues)
+{
 	// Check if mesh has collision
-	if (!FAtlasMeshUtils::HasCollision(Mesh))
+	if (!bHasCollision)
 	{
 		FString Message = FString::Printf(
 			TEXT("Static mesh '%s' has no collision geometry"),
-			*Mesh->GetName()
+			*AssetName
 		);
 
 		FAtlasIssue Issue(
-			Mesh->GetPathName(),
+			AssetPath,
 			GetRuleName(),
 			EAtlasSeverity::Error,
 			Message,
@@ -45,16 +89,18 @@ void FAtlasStaticMeshCollisionRule::Validate(const UObject* Asset, TArray<FAtlas
 		);
 
 		// Create fix function
-		CreateFixFunction(Issue, const_cast<UStaticMesh*>(Mesh));
+		CreateFixFunction(Issue, AssetPath);
 
 		OutIssues.Add(Issue);
 	}
 }
 
-void FAtlasStaticMeshCollisionRule::CreateFixFunction(FAtlasIssue& Issue, UStaticMesh* Mesh)
+void FAtlasStaticMeshCollisionRule::CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath)
 {
-	Issue.FixFunction = [Mesh]() -> bool
+	// The mesh is resolved when the fix runs, so metadata-only scans never load it
+	Issue.FixFunction = [AssetPath]() -> bool
 	{
+		UStaticMesh* Mesh = Cast<UStaticMesh>(FAtlasAssetUtils::LoadAsset(AssetPath));
 		if (!Mesh)
 		{
 			return false;
@@ -15,9 +15,14 @@ public:
 
 	virtual FName GetRuleName() const override;
 	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const override;
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
 	virtual FString GetDescription() const override;
 	virtual bool IsEnabled() const override;
+	virtual bool IsThreadSafe() const override;
 
 private:
-	void CreateFixFunction(FAtlasIssue& Issue, class UStaticMesh* Mesh);
+	void ValidateCollision(const FString& AssetPath, const FString& AssetName, bool bHasCollision, TArray<FAtlasIssue>& OutIssues);
+	void CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath);
 };
@@ -0,0 +1,185 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasStaticMeshLODRule.h"
+#include "AtlasSettings.h"
+#include "Core/AtlasMeshUtils.h"
+#include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasFixExecutor.h"
+#include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/StaticMesh.h"
+
+FName FAtlasStaticMeshLODRule::GetRuleName() const
+{
+	return TEXT("StaticMeshLOD");
+}
+
+FString FAtlasStaticMeshLODRule::GetDescription() const
+{
+	return TEXT("Ensures static mesh LODs reduce enough for the screen size they are shown at");
+}
+
+bool FAtlasStaticMeshLODRule::IsEnabled() const
+{
+	return true;
+}
+
+bool FAtlasStaticMeshLODRule::SupportsCaching() const
+{
+	// The Nanite check reads the blend modes of materials, which live in other packages
+	return false;
+}
+
+void FAtlasStaticMeshLODRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UStaticMesh::StaticClass());
+}
+
+void FAtlasStaticMeshLODRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
+{
+	const UStaticMesh* Mesh = Cast<UStaticMesh>(Asset);
+	if (!Mesh)
+	{
+		return;
+	}
+
+	TArray<int64> LODTriangles;
+	TArray<float> LODScreenSizes;
+	FAtlasMeshUtils::GetLODTriangleCounts(Mesh, LODTriangles);
+	FAtlasMeshUtils::GetLODScreenSizes(Mesh, LODScreenSizes);
+
+	ValidateLODs(Mesh->GetPathName(), Mesh->GetName(), LODTriangles, LODScreenSizes, Mesh->NaniteSettings.bEnabled, FAtlasMeshUtils::IsNaniteCompatible(Mesh), OutIssues);
+}
+
+bool FAtlasStaticMeshLODRule::CanValidateAssetData(const FAssetData& AssetData) const
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UStaticMesh::StaticClass()))
+	{
+		return true; // Nothing to check for other asset types
+	}
+
+	// Screen sizes, Nanite and materials are not in the registry, so only a single LOD under every
+	// triangle threshold can be decided from tags
+	int64 Triangles = 0;
+	int32 LODCount = 0;
+	if (!FAtlasMeshUtils::GetTriangleCountFromTags(AssetData, Triangles) || !FAtlasMeshUtils::GetLODCountFromTags(AssetData, LODCount))
+	{
+		return false;
+	}
+
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+	return LODCount == 1 && Triangles <= Settings->MaxTriCount && Triangles < Settings->NaniteMinTriangles;
+}
+
+void FAtlasStaticMeshLODRule::ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues)
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UStaticMesh::StaticClass()))
+	{
+		return;
+	}
+
+	int64 Triangles = 0;
+	if (!FAtlasMeshUtils::GetTriangleCountFromTags(AssetData, Triangles))
+	{
+		return;
+	}
+
+	// A single LOD has no density or reduction to check
+	const TArray<int64> LODTriangles = { Triangles };
+	const TArray<float> LODScreenSizes = { 1.0f };
+	ValidateLODs(AssetData.ObjectPath.ToString(), AssetData.AssetName.ToString(), LODTriangles, LODScreenSizes, false, false, OutIssues);
+}
+
+void FAtlasStaticMeshLODRule::ValidateLODs(const FString& AssetPath, const FString& AssetName, const TArray<int64>& LODTriangles, const TArray<float>& LODScreenSizes, bool bNaniteEnabled, bool bNaniteCompatible, TArray<FAtlasIssue>& OutIssues)
+{
+	// Nanite meshes do not use the LOD chain, LOD 0 is only their fallback
+	if (bNaniteEnabled || LODTriangles.Num() == 0)
+	{
+		return;
+	}
+
+	const UAtlasSettings* Settings = UAtlasSettings::Get();
+	const int64 SourceTriangles = LODTriangles[0];
+
+	// Dense opaque meshes are cheaper as Nanite than with any LOD chain
+	if (bNaniteCompatible && SourceTriangles >= Settings->NaniteMinTriangles)
+	{
+		FString Message = FString::Printf(
+			TEXT("Static mesh '%s' has %lld triangles and only opaque materials; enable Nanite instead of relying on LODs"),
+			*AssetName, SourceTriangles);
+
+		OutIssues.Add(FAtlasIssue(AssetPath, GetRuleName(), EAtlasSeverity::Warning, Message, false));
+		return;
+	}
+
+	// Check if mesh needs more LODs
+	if (SourceTriangles > Settings->MaxTriCount && LODTriangles.Num() < Settings->MinMeshLODs)
+	{
+		FString Message = FString::Printf(
+			TEXT("Static mesh '%s' has %lld triangles and %d LOD(s); meshes over %d triangles need %d LODs"),
+			*AssetName, SourceTriangles, LODTriangles.Num(), Settings->MaxTriCount, Settings->MinMeshLODs);
+
+		FAtlasIssue Issue(AssetPath, GetRuleName(), EAtlasSeverity::Warning, Message, true);
+		CreateFixFunction(Issue, AssetPath, Settings->MinMeshLODs, Settings->MaxTriCount);
+		OutIssues.Add(Issue);
+	}
+
+	const float ScreenHeight = static_cast<float>(Settings->StreamingScreenSize);
+	for (int32 LODIndex = 0; LODIndex < LODTriangles.Num(); ++LODIndex)
+	{
+		if (LODIndex > 0 && LODTriangles[LODIndex - 1] > 0)
+		{
+			const float Ratio = static_cast<float>(LODTriangles[LODIndex]) / static_cast<float>(LODTriangles[LODIndex - 1]);
+			if (Ratio > Settings->MaxLODReductionRatio)
+			{
+				FString Message = FString::Printf(
+					TEXT("LOD %d of static mesh '%s' keeps %.0f%% of LOD %d's triangles (max %.0f%%)"),
+					LODIndex, *AssetName, Ratio * 100.0f, LODIndex - 1, Settings->MaxLODReductionRatio * 100.0f);
+
+				OutIssues.Add(FAtlasIssue(AssetPath, GetRuleName(), EAtlasSeverity::Warning, Message, false));
+			}
+		}
+
+		// A LOD is densest right before the next one takes over; the last LOD has no such bound
+		if (LODIndex + 1 >= LODTriangles.Num() || LODIndex + 1 >= LODScreenSizes.Num())
+		{
+			continue;
+		}
+
+		// Screen size is the bounding sphere's diameter relative to the screen height
+		const float Diameter = LODScreenSizes[LODIndex + 1] * ScreenHeight;
+		const float CoveredPixels = FMath::Max(PI * 0.25f * Diameter * Diameter, 1.0f);
+		const float Density = static_cast<float>(LODTriangles[LODIndex]) / CoveredPixels;
+
+		if (Density > Settings->MaxLODTriangleDensity)
+		{
+			FString Message = FString::Printf(
+				TEXT("LOD %d of static mesh '%s' has %.2f triangles per pixel at screen size %.3f (max %.2f)"),
+				LODIndex, *AssetName, Density, LODScreenSizes[LODIndex + 1], Settings->MaxLODTriangleDensity);
+
+			OutIssues.Add(FAtlasIssue(AssetPath, GetRuleName(), EAtlasSeverity::Warning, Message, false));
+		}
+	}
+}
+
+void FAtlasStaticMeshLODRule::CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, int32 TargetLODs, int32 MaxTris)
+{
+	// The mesh is resolved when the fix runs, so metadata-only scans never load it
+	Issue.FixFunction = [AssetPath, TargetLODs, MaxTris]() -> bool
+	{
+		UStaticMesh* Mesh = Cast<UStaticMesh>(FAtlasAssetUtils::LoadAsset(AssetPath));
+		if (!Mesh)
+		{
+			return false;
+		}
+
+		bool bSuccess = FAtlasFixExecutor::GenerateLODs(Mesh, TargetLODs, MaxTris);
+
+		if (!bSuccess)
+		{
+			UE_LOG(LogAtlas, Warning, TEXT("Failed to generate LODs for mesh: %s"), *Mesh->GetName());
+		}
+
+		return bSuccess;
+	};
+}
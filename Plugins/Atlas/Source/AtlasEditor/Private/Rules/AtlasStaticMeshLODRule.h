@@ -0,0 +1,30 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IAtlasRule.h"
+
+/**
+ * Validates static mesh LOD chains: LOD count, triangle density per LOD against its screen size,
+ * per-LOD reduction, and Nanite on dense opaque meshes
+ * Nanite compatibility depends on the mesh's materials, so results are not cached per package.
+ */
+class FAtlasStaticMeshLODRule : public IAtlasRule
+{
+public:
+	virtual ~FAtlasStaticMeshLODRule() = default;
+
+	virtual FName GetRuleName() const override;
+	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const override;
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
+	virtual FString GetDescription() const override;
+	virtual bool IsEnabled() const override;
+	virtual bool SupportsCaching() const override;
+
+private:
+	void ValidateLODs(const FString& AssetPath, const FString& AssetName, const TArray<int64>& LODTriangles, const TArray<float>& LODScreenSizes, bool bNaniteEnabled, bool bNaniteCompatible, TArray<FAtlasIssue>& OutIssues);
+	void CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, int32 TargetLODs, int32 MaxTris);
+};
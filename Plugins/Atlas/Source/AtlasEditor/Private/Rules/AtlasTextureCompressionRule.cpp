@@ -2,7 +2,10 @@
 
 #include "AtlasTextureCompressionRule.h"
 #include "Core/AtlasTextureUtils.h"
+#include "Core/AtlasAssetUtils.h"
+#include "Core/AtlasFixExecutor.h"
 #include "AtlasRuntime.h"
+#include "AssetRegistry/AssetData.h"
 #include "Engine/Texture2D.h"
 
 FName FAtlasTextureCompressionRule::GetRuleName() const
@@ -20,6 +23,23 @@ bool FAtlasTextureCompressionRule::IsEnabled() const
 	return true;
 }
 
+bool FAtlasTextureCompressionRule::IsThreadSafe() const
+{
+	return true;
+}
+
+int32 FAtlasTextureCompressionRule::GetRuleVersion() const
+{
+	// 2: map types come from the tokenized suffix classifier
+	// 3: only the trailing suffix is classified
+	return 3;
+}
+
+void FAtlasTextureCompressionRule::GetSupportedClasses(TArray<const UClass*>& OutClasses) const
+{
+	OutClasses.Add(UTexture2D::StaticClass());
+}
+
 void FAtlasTextureCompressionRule::Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues)
 {
 	const UTexture2D* Texture = Cast<UTexture2D>(Asset);
@@ -28,12 +48,47 @@ void FAtlasTextureCompressionRule::Validate(const UObject* Asset, TArray<FAtlasI
 		return;
 	}
 
+	ValidateSettings(Texture->GetPathName(), Texture->GetName(), static_cast<uint8>(Texture->CompressionSettings.GetValue()), Texture->SRGB, OutIssues);
+}
+
+bool FAtlasTextureCompressionRule::CanValidateAssetData(const FAssetData& AssetData) const
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UTexture2D::StaticClass()))
+	{
+		return true; // Nothing to check for other asset types
+	}
+
+	// Packages saved before the tags were searchable need the loaded texture
+	uint8 Compression = 0;
+	bool bSRGB = false;
+	return FAtlasTextureUtils::GetCompressionFromTags(AssetData, Compression) && FAtlasTextureUtils::GetSRGBFromTags(AssetData, bSRGB);
+}
+
+void FAtlasTextureCompressionRule::ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues)
+{
+	if (!FAtlasAssetUtils::IsAssetOfClass(AssetData, UTexture2D::StaticClass()))
+	{
+		return;
+	}
+
+	uint8 Compression = 0;
+	bool bSRGB = false;
+	if (!FAtlasTextureUtils::GetCompressionFromTags(AssetData, Compression) || !FAtlasTextureUtils::GetSRGBFromTags(AssetData, bSRGB))
+	{
+		return;
+	}
+
+	ValidateSettings(AssetData.ObjectPath.ToString(), AssetData.AssetName.ToString(), Compression, bSRGB, OutIssues);
+}
+
+void FAtlasTextureCompressionRule::ValidateSettings(const FString& AssetPath, const FString& AssetName, uint8 Compression, bool bSRGB, TArray<FAtlasIssue>& OutIssues)
+{
 	// Detect texture type
-	EAtlasMapType MapType = FAtlasTextureUtils::DetectMapTypeByName(Texture->GetName());
+	EAtlasMapType MapType = FAtlasTextureUtils::DetectMapTypeByName(AssetName);
 	if (MapType == EAtlasMapType::Unknown)
 	{
 		// Try to detect if it's a normal map
-		if (FAtlasTextureUtils::IsLikelyNormal(Texture))
+		if (FAtlasTextureUtils::IsLikelyNormal(Compression, bSRGB, AssetName))
 		{
 			MapType = EAtlasMapType::Normal;
 		}
@@ -44,7 +99,7 @@ void FAtlasTextureCompressionRule::Validate(const UObject* Asset, TArray<FAtlasI
 	}
 
 	// Check if compression is correct
-	if (!FAtlasTextureUtils::HasCorrectCompression(Texture, MapType))
+	if (!FAtlasTextureUtils::HasCorrectCompression(Compression, MapType))
 	{
 		uint8 RecommendedCompression = FAtlasTextureUtils::GetRecommendedCompression(MapType);
 
@@ -61,12 +116,12 @@ void FAtlasTextureCompressionRule::Validate(const UObject* Asset, TArray<FAtlasI
 
 		FString Message = FString::Printf(
 			TEXT("Texture '%s' (type: %s) has incorrect compression settings"),
-			*Texture->GetName(),
+			*AssetName,
 			*MapTypeName
 		);
 
 		FAtlasIssue Issue(
-			Texture->GetPathName(),
+			AssetPath,
 			GetRuleName(),
 			EAtlasSeverity::Warning,
 			Message,
@@ -74,61 +129,68 @@ void FAtlasTextureCompressionRule::Validate(const UObject* Asset, TArray<FAtlasI
 		);
 
 		// Create fix function
-		CreateFixFunction(Issue, const_cast<UTexture2D*>(Texture), RecommendedCompression);
+		CreateFixFunction(Issue, AssetPath, RecommendedCompression);
 
 		OutIssues.Add(Issue);
 	}
 
 	// Check if SRGB is correct for the type
-	if (MapType == EAtlasMapType::Normal && Texture->SRGB)
+	if (MapType == EAtlasMapType::Normal && bSRGB)
 	{
 		FString Message = FString::Printf(
 			TEXT("Normal map '%s' should not use SRGB"),
-			*Texture->GetName()
+			*AssetName
 		);
 
 		FAtlasIssue Issue(
-			Texture->GetPathName(),
+			AssetPath,
 			GetRuleName(),
 			EAtlasSeverity::Error,
 			Message,
 			true // Can fix
 		);
 
-		Issue.FixFunction = [Texture]() -> bool
-		{
-			UTexture2D* MutableTexture = const_cast<UTexture2D*>(Texture);
-			if (MutableTexture)
-			{
-				MutableTexture->Modify();
-				MutableTexture->SRGB = false;
-				MutableTexture->PostEditChange();
-				MutableTexture->MarkPackageDirty();
-				UE_LOG(LogAtlas, Log, TEXT("Disabled SRGB for normal map: %s"), *Texture->GetName());
-				return true;
-			}
-			return false;
-		};
+		CreateSRGBFixFunction(Issue, AssetPath);
 
 		OutIssues.Add(Issue);
 	}
 }
 
-void FAtlasTextureCompressionRule::CreateFixFunction(FAtlasIssue& Issue, UTexture2D* Texture, uint8 RecommendedCompression)
+void FAtlasTextureCompressionRule::CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, uint8 RecommendedCompression)
 {
-	Issue.FixFunction = [Texture, RecommendedCompression]() -> bool
+	// The texture is resolved when the fix runs, so metadata-only scans never load it
+	Issue.FixFunction = [AssetPath, RecommendedCompression]() -> bool
 	{
+		UTexture2D* Texture = Cast<UTexture2D>(FAtlasAssetUtils::LoadAsset(AssetPath));
 		if (!Texture)
 		{
 			return false;
 		}
 
-		Texture->Modify();
+		FAtlasFixExecutor::BeginEdit(Texture);
 		Texture->CompressionSettings = static_cast<TextureCompressionSettings>(RecommendedCompression);
-		Texture->PostEditChange();
-		Texture->MarkPackageDirty();
+		FAtlasFixExecutor::EndEdit(Texture);
 
 		UE_LOG(LogAtlas, Log, TEXT("Fixed compression for texture: %s"), *Texture->GetName());
 		return true;
 	};
 }
+
+void FAtlasTextureCompressionRule::CreateSRGBFixFunction(FAtlasIssue& Issue, const FString& AssetPath)
+{
+	Issue.FixFunction = [AssetPath]() -> bool
+	{
+		UTexture2D* Texture = Cast<UTexture2D>(FAtlasAssetUtils::LoadAsset(AssetPath));
+		if (!Texture)
+		{
+			return false;
+		}
+
+		FAtlasFixExecutor::BeginEdit(Texture);
+		Texture->SRGB = false;
+		FAtlasFixExecutor::EndEdit(Texture);
+
+		UE_LOG(LogAtlas, Log, TEXT("Disabled SRGB for normal map: %s"), *Texture->GetName());
+		return true;
+	};
+}
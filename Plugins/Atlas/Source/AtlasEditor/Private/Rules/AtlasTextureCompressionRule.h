@@ -15,9 +15,16 @@ public:
 
 	virtual FName GetRuleName() const override;
 	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) override;
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const override;
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) override;
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const override;
 	virtual FString GetDescription() const override;
 	virtual bool IsEnabled() const override;
+	virtual bool IsThreadSafe() const override;
+	virtual int32 GetRuleVersion() const override;
 
 private:
-	void CreateFixFunction(FAtlasIssue& Issue, class UTexture2D* Texture, uint8 RecommendedCompression);
+	void ValidateSettings(const FString& AssetPath, const FString& AssetName, uint8 Compression, bool bSRGB, TArray<FAtlasIssue>& OutIssues);
+	void CreateFixFunction(FAtlasIssue& Issue, const FString& AssetPath, uint8 RecommendedCompression);
+	void CreateSRGBFixFunction(FAtlasIssue& Issue, const FString& AssetPath);
 };
@@ -7,8 +7,12 @@
 
 class IAtlasRule;
 struct FAtlasIssue;
+struct FAtlasIssueDelta;
+class FAtlasIssueStore;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnAtlasIssuesReady, const TArray<FAtlasIssue>&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAtlasIssueStoreReady, const FAtlasIssueStore&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAtlasIssuesDelta, const FAtlasIssueDelta&);
 
 /**
  * Public interface for the Atlas Editor module
@@ -49,6 +53,12 @@ public:
 
 	/** Event fired when validation scan completes */
 	virtual FOnAtlasIssuesReady& OnIssuesReady() = 0;
+
+	/** Event fired when validation scan completes, with results in their compact store form */
+	virtual FOnAtlasIssueStoreReady& OnIssueStoreReady() = 0;
+
+	/** Event fired by live validation with the issues of changed packages only */
+	virtual FOnAtlasIssuesDelta& OnIssuesDelta() = 0;
 };
 
 /**
@@ -66,6 +76,8 @@ public:
 	virtual void RequestScan(const TArray<struct FAssetData>& OptionalSelection) override;
 	virtual void OpenOverview() override;
 	virtual FOnAtlasIssuesReady& OnIssuesReady() override { return OnIssuesReadyDelegate; }
+	virtual FOnAtlasIssueStoreReady& OnIssueStoreReady() override { return OnIssueStoreReadyDelegate; }
+	virtual FOnAtlasIssuesDelta& OnIssuesDelta() override { return OnIssuesDeltaDelegate; }
 
 private:
 	void RegisterMenus();
@@ -77,5 +89,9 @@ private:
 
 private:
 	FOnAtlasIssuesReady OnIssuesReadyDelegate;
+	FOnAtlasIssueStoreReady OnIssueStoreReadyDelegate;
+	FOnAtlasIssuesDelta OnIssuesDeltaDelegate;
 	TSharedPtr<class FUICommandList> PluginCommands;
+	TUniquePtr<class FAtlasLiveValidator> LiveValidator;
+	TUniquePtr<class FAtlasOrganizer> Organizer;
 };
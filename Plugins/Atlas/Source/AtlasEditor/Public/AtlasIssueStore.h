@@ -0,0 +1,191 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AtlasTypes.h"
+
+/**
+ * Case-sensitive string keys for TMap/TSet (FString's default hashing ignores case)
+ */
+template <typename ValueType>
+struct TAtlasCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, ValueType>, FString, false>
+{
+	static const FString& GetSetKey(const TPair<FString, ValueType>& Element) { return Element.Key; }
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+};
+
+/**
+ * Filter for FAtlasIssueStore::Query
+ */
+struct FAtlasIssueFilter
+{
+	/** One bit per EAtlasSeverity value (see GetSeverityBit) */
+	uint8 SeverityMask;
+
+	/** Only issues reported by these rules; empty for all rules */
+	TArray<FName> RuleNames;
+
+	/** Only assets whose path contains this text (case-insensitive); empty for all assets */
+	FString PathFilter;
+
+	FAtlasIssueFilter()
+		: SeverityMask(0xFF)
+	{
+	}
+
+	static uint8 GetSeverityBit(EAtlasSeverity Severity)
+	{
+		return static_cast<uint8>(1 << static_cast<uint8>(Severity));
+	}
+};
+
+/**
+ * Sort keys for FAtlasIssueStore::Sort
+ */
+enum class EAtlasIssueSortKey : uint8
+{
+	Severity,
+	Rule,
+	Path
+};
+
+/**
+ * Compact structure-of-arrays storage for scan results
+ *
+ * Paths and rule names are interned, messages are stored as a shared template plus their variable
+ * parts, and fix functions are not stored: they are rebuilt from the rule when a fix is applied.
+ * Issues are addressed by index; indices are stable until RemoveIf or Reset.
+ * Not thread-safe.
+ */
+class ATLASEDITOR_API FAtlasIssueStore
+{
+public:
+	/** Stands in for an argument inside a message template; never appears in rule messages */
+	static const TCHAR ArgMarker;
+
+	FAtlasIssueStore();
+
+	/** Number of issues */
+	int32 Num() const { return PathIds.Num(); }
+
+	/** Remove every issue and interned string */
+	void Reset();
+
+	/** Preallocate columns for a number of issues */
+	void Reserve(int32 NumIssues);
+
+	/**
+	 * Add an issue; its fix function is dropped
+	 * @return Index of the new issue
+	 */
+	int32 Add(const FAtlasIssue& Issue);
+
+	/** Add several issues */
+	void Append(TConstArrayView<FAtlasIssue> Issues);
+
+	/** Column accessors */
+	FName GetAssetPath(int32 Index) const { return Paths[PathIds[Index]]; }
+	FName GetRuleName(int32 Index) const { return RuleNames[RuleIds[Index]]; }
+	EAtlasSeverity GetSeverity(int32 Index) const { return static_cast<EAtlasSeverity>(Severities[Index]); }
+	bool CanFix(int32 Index) const { return CanFixBits[Index]; }
+
+	/** Rebuild the message of an issue */
+	FString GetMessage(int32 Index) const;
+
+	/** Materialize an issue (without fix function) */
+	FAtlasIssue GetIssue(int32 Index) const;
+
+	/** Materialize every issue (without fix functions) */
+	void ToArray(TArray<FAtlasIssue>& OutIssues) const;
+
+	/**
+	 * Apply the fix of an issue, rebuilding the fix function from its rule
+	 * @return True if the fix was applied successfully
+	 */
+	bool ApplyFix(int32 Index) const;
+
+	/**
+	 * Apply the fixes of many issues as one undoable batch (see FAtlasFixExecutor)
+	 * @param Indices Issues to fix; issues that cannot be fixed are skipped
+	 * @param bSavePackages Save every package the batch modified
+	 * @return Number of fixes applied successfully
+	 */
+	int32 ApplyFixes(TConstArrayView<int32> Indices, bool bSavePackages = true) const;
+
+	/** Number of issues with a severity */
+	int32 NumWithSeverity(EAtlasSeverity Severity) const;
+
+	/**
+	 * Collect the indices of issues matching a filter, in storage order
+	 * Rule and path conditions are evaluated once per distinct rule and path, not per issue.
+	 * @param Filter The filter to apply
+	 * @param OutIndices Array to fill with matching indices
+	 */
+	void Query(const FAtlasIssueFilter& Filter, TArray<int32>& OutIndices) const;
+
+	/**
+	 * Sort issue indices; ties are broken by path, then storage order
+	 * @param Indices Indices to sort in place
+	 * @param Key Primary sort key
+	 * @param bDescending Reverse the primary key (e.g. errors first)
+	 */
+	void Sort(TArray<int32>& Indices, EAtlasIssueSortKey Key, bool bDescending = false) const;
+
+	/**
+	 * Remove issues, compacting the columns
+	 * Paths and message templates no remaining issue uses are dropped, so the store does not grow
+	 * under repeated live validation. Rule names are kept; there are only as many as registered rules.
+	 * @param Predicate Returns true for indices to remove
+	 * @return Number of issues removed
+	 */
+	int32 RemoveIf(TFunctionRef<bool(int32)> Predicate);
+
+	/**
+	 * Remove every issue of some packages (e.g. when applying an FAtlasIssueDelta)
+	 * @return Number of issues removed
+	 */
+	int32 RemovePackages(const TSet<FName>& PackageNames);
+
+	/**
+	 * Split a message into a template and its variable parts (quoted text and numbers)
+	 * Replacing each ArgMarker of the template with the next argument reproduces the message exactly (see GetMessage).
+	 * @param Message The formatted message
+	 * @param OutTemplate Message with each argument replaced by ArgMarker
+	 * @param OutArgs The replaced parts, in order
+	 */
+	static void SplitMessage(const FString& Message, FString& OutTemplate, TArray<FString>& OutArgs);
+
+private:
+	int32 InternPath(FName Path);
+	int32 InternRule(FName RuleName);
+	int32 InternTemplate(const FString& Template);
+
+	/** Rebuild the path and template tables from the remaining issues, dropping unused entries */
+	void PruneTables();
+
+	/** Rank of every interned path in lexical order, rebuilt after new paths are added */
+	const TArray<int32>& GetPathRanks() const;
+
+	// Interned tables
+	TArray<FName> Paths;
+	TMap<FName, int32> PathLookup;
+	TArray<FName> RuleNames;
+	TMap<FName, int32> RuleLookup;
+	TArray<FString> Templates;
+	TMap<FString, int32, FDefaultSetAllocator, TAtlasCaseSensitiveKeyFuncs<int32>> TemplateLookup;
+
+	// Per-issue columns
+	TArray<int32> PathIds;
+	TArray<uint16> RuleIds;
+	TArray<uint8> Severities;
+	TArray<int32> TemplateIds;
+	TArray<int32> ArgStarts;
+	TBitArray<> CanFixBits;
+
+	/** Message arguments of all issues, each terminated by a null character */
+	TArray<TCHAR> ArgBlob;
+
+	mutable TArray<int32> PathRanks;
+};
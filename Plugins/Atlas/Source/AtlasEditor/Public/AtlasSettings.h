@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "AtlasTypes.h"
 #include "AtlasSettings.generated.h"
 
 /**
@@ -21,11 +22,20 @@ public:
 	/** Get the Atlas settings singleton */
 	static const UAtlasSettings* Get();
 
+	/** Hash of every setting that influences validation results, used to invalidate cached scans */
+	uint32 GetValidationHash() const;
+
 	//~ Begin UDeveloperSettings Interface
 	virtual FName GetCategoryName() const override;
 	virtual FText GetSectionText() const override;
 	//~ End UDeveloperSettings Interface
 
+#if WITH_EDITOR
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+#endif
+
 public:
 	/** Root directory for mesh assets */
 	UPROPERTY(Config, EditAnywhere, Category = "Paths", meta = (RelativeToGameContentDir))
@@ -43,6 +53,10 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Naming Conventions")
 	TMap<FName, FString> NamingPrefixes;
 
+	/** Texture name suffixes and the map type they indicate; two-token suffixes use '_' (e.g. "base_color") */
+	UPROPERTY(Config, EditAnywhere, Category = "Naming Conventions")
+	TMap<FString, EAtlasMapType> MapTypeSuffixes;
+
 	/** Maximum texture dimension (width or height) */
 	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "128", ClampMax = "8192"))
 	int32 MaxTextureSize;
@@ -51,6 +65,34 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "1000", ClampMax = "100000"))
 	int32 MaxTriCount;
 
+	/** Number of LODs a mesh over MaxTriCount should have */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "2", ClampMax = "8"))
+	int32 MinMeshLODs;
+
+	/** Maximum triangles per covered pixel for a LOD at the smallest screen size it is shown */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "0.001", ClampMax = "10.0"))
+	float MaxLODTriangleDensity;
+
+	/** Maximum fraction of the previous LOD's triangles a LOD may keep */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "0.1", ClampMax = "1.0"))
+	float MaxLODReductionRatio;
+
+	/** Triangle count from which opaque meshes should use Nanite instead of LODs */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "1000"))
+	int32 NaniteMinTriangles;
+
+	/** Maximum number of differing fingerprint bits for two textures to count as near-duplicates */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "0", ClampMax = "32"))
+	int32 NearDuplicateMaxDistance;
+
+	/** Parameter values closer than this count as equal when comparing material instances */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "0.000001"))
+	float MaterialInstanceParameterTolerance;
+
+	/** Maximum estimated shaders a master material and its instances may compile */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "1"))
+	int32 MaxShaderPermutations;
+
 	/** Maximum project size in megabytes */
 	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "1024"))
 	int64 MaxProjectSizeMB;
@@ -59,6 +101,18 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "512"))
 	int64 TargetVRAMMB;
 
+	/** Platform whose texture formats and LOD groups the VRAM cost model assumes */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds")
+	EAtlasCostPlatform CostModelPlatform;
+
+	/** Largest screen dimension in pixels; streaming textures never need larger mips than this */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "256", ClampMax = "8192"))
+	int32 StreamingScreenSize;
+
+	/** Typical fraction of the screen a streaming texture covers, used for steady-state texture memory */
+	UPROPERTY(Config, EditAnywhere, Category = "Thresholds", meta = (ClampMin = "0.05", ClampMax = "1.0"))
+	float StreamingSteadyScreenFraction;
+
 	/** Block builds when red (error) violations are present */
 	UPROPERTY(Config, EditAnywhere, Category = "Validation")
 	bool bBlockBuildOnRed;
@@ -67,6 +121,14 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "Organizer")
 	bool bAutoOrganizeOnImport;
 
+	/** Seconds without a new import before the collected import session is organized as one group */
+	UPROPERTY(Config, EditAnywhere, Category = "Organizer", meta = (ClampMin = "0.0", ClampMax = "10.0", EditCondition = "bAutoOrganizeOnImport"))
+	float OrganizerDebounceSeconds;
+
+	/** Master material the organizer builds material instances against; created on first use if missing */
+	UPROPERTY(Config, EditAnywhere, Category = "Organizer", meta = (AllowedClasses = "/Script/Engine.Material"))
+	FSoftObjectPath MasterMaterial;
+
 	/** Automatically fix issues when possible */
 	UPROPERTY(Config, EditAnywhere, Category = "Validator")
 	bool bAutoFixOnScan;
@@ -74,4 +136,24 @@ public:
 	/** Show detailed messages for info-level issues */
 	UPROPERTY(Config, EditAnywhere, Category = "Validator")
 	bool bShowInfoMessages;
+
+	/** Evaluate thread-safe rules on worker threads during scans (assets are still loaded on the game thread) */
+	UPROPERTY(Config, EditAnywhere, Category = "Validator")
+	bool bParallelScan;
+
+	/** Reuse results from Saved/Atlas/ScanCache.bin for packages and rules that have not changed since the last scan */
+	UPROPERTY(Config, EditAnywhere, Category = "Validator")
+	bool bUseScanCache;
+
+	/** Revalidate assets in the background when they are added, renamed or saved */
+	UPROPERTY(Config, EditAnywhere, Category = "Live Validation")
+	bool bLiveValidation;
+
+	/** Seconds a package must stay unchanged before live validation picks it up */
+	UPROPERTY(Config, EditAnywhere, Category = "Live Validation", meta = (ClampMin = "0.0", ClampMax = "10.0", EditCondition = "bLiveValidation"))
+	float LiveValidationDebounceSeconds;
+
+	/** Time budget per editor frame for live validation, in milliseconds */
+	UPROPERTY(Config, EditAnywhere, Category = "Live Validation", meta = (ClampMin = "1.0", ClampMax = "100.0", EditCondition = "bLiveValidation"))
+	float LiveValidationBudgetMs;
 };
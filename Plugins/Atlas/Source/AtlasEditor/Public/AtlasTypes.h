@@ -34,6 +34,16 @@ enum class EAtlasMapType : uint8
 	Unknown UMETA(DisplayName = "Unknown")
 };
 
+/**
+ * Platform class whose texture formats the VRAM cost model assumes
+ */
+UENUM(BlueprintType)
+enum class EAtlasCostPlatform : uint8
+{
+	Desktop UMETA(DisplayName = "Desktop (BC)"),
+	Mobile UMETA(DisplayName = "Mobile (ASTC)")
+};
+
 /**
  * Represents a single validation issue found by Atlas
  */
@@ -62,7 +72,7 @@ struct FAtlasIssue
 	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
 	bool bCanFix;
 
-	/** Function to call to fix this issue (not serialized) */
+	/** Function to call to fix this issue (not serialized, unset for issues restored from the scan cache) */
 	TFunction<bool()> FixFunction;
 
 	FAtlasIssue()
@@ -81,6 +91,24 @@ struct FAtlasIssue
 	}
 };
 
+/**
+ * Incremental change to the set of known issues, produced by live validation
+ * Consumers drop every issue belonging to InvalidatedPackages, then add Issues
+ */
+struct FAtlasIssueDelta
+{
+	/** Packages whose previously reported issues are superseded */
+	TArray<FName> InvalidatedPackages;
+
+	/** Current issues of the invalidated packages that still exist */
+	TArray<FAtlasIssue> Issues;
+
+	bool IsEmpty() const
+	{
+		return InvalidatedPackages.Num() == 0;
+	}
+};
+
 /**
  * Statistics about a texture asset
  */
@@ -152,6 +180,146 @@ struct FAtlasLevelStat
 	}
 };
 
+/**
+ * Estimated shader cost of a master material and every instance derived from it
+ */
+USTRUCT(BlueprintType)
+struct FAtlasShaderStat
+{
+	GENERATED_BODY()
+
+	/** Object path of the master material */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	FString Path;
+
+	/** Material instances whose base material this is */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int32 NumInstances;
+
+	/** Distinct static switch and base property combinations, each compiled separately */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int32 NumStaticCombinations;
+
+	/** Vertex factories the usage flags compile for */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int32 NumVertexFactories;
+
+	/** Estimated number of compiled shaders */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int64 EstimatedPermutations;
+
+	/** Estimated compiled size of those shaders */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int64 EstimatedBytes;
+
+	FAtlasShaderStat()
+		: NumInstances(0)
+		, NumStaticCombinations(0)
+		, NumVertexFactories(0)
+		, EstimatedPermutations(0)
+		, EstimatedBytes(0)
+	{
+	}
+};
+
+/**
+ * Time spent in one rule during a scan
+ */
+USTRUCT(BlueprintType)
+struct FAtlasRuleProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	FName RuleName;
+
+	/** Validate and ValidateAssetData calls; cached results are not counted */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int32 NumCalls;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double TotalSeconds;
+
+	/** Latency percentiles of a single call, from a log-scale histogram (within about 6%) */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double P50Seconds;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double P95Seconds;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double P99Seconds;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double MaxSeconds;
+
+	FAtlasRuleProfile()
+		: NumCalls(0)
+		, TotalSeconds(0.0)
+		, P50Seconds(0.0)
+		, P95Seconds(0.0)
+		, P99Seconds(0.0)
+		, MaxSeconds(0.0)
+	{
+	}
+};
+
+/**
+ * Time spent on one asset during a scan
+ */
+USTRUCT(BlueprintType)
+struct FAtlasAssetProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	FString Path;
+
+	/** Load plus every rule evaluated on the asset */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double Seconds;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double LoadSeconds;
+
+	FAtlasAssetProfile()
+		: Seconds(0.0)
+		, LoadSeconds(0.0)
+	{
+	}
+};
+
+/**
+ * Where the time of a scan went
+ */
+USTRUCT(BlueprintType)
+struct FAtlasScanProfile
+{
+	GENERATED_BODY()
+
+	/** Wall time of the whole scan */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double ScanSeconds;
+
+	/** Time spent loading packages for object-based rules */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	double LoadSeconds;
+
+	/** Rules, most total time first */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	TArray<FAtlasRuleProfile> Rules;
+
+	/** Slowest assets, slowest first */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	TArray<FAtlasAssetProfile> SlowestAssets;
+
+	FAtlasScanProfile()
+		: ScanSeconds(0.0)
+		, LoadSeconds(0.0)
+	{
+	}
+};
+
 /**
  * Complete Atlas report for export
  */
@@ -172,15 +340,32 @@ struct FAtlasReport
 	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
 	TArray<FAtlasLevelStat> Levels;
 
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	TArray<FAtlasShaderStat> Shaders;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
 	int64 TotalProjectBytes;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
 	int64 TotalVRAMBytes;
 
+	/** Disk bytes that consolidating exact duplicate assets would free */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int64 ReclaimableBytes;
+
+	/** Texture memory that consolidating exact duplicate textures would free */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	int64 ReclaimableVRAMBytes;
+
+	/** Timings of the scan that produced the report; empty for merged and binary reports */
+	UPROPERTY(BlueprintReadOnly, Category = "Atlas")
+	FAtlasScanProfile Profile;
+
 	FAtlasReport()
 		: TotalProjectBytes(0)
 		, TotalVRAMBytes(0)
+		, ReclaimableBytes(0)
+		, ReclaimableVRAMBytes(0)
 	{
 	}
 };
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "AtlasTypes.h"
 
+struct FAssetData;
+
 /**
  * Interface for Atlas validation rules
  * Each rule checks assets for specific issues and can optionally auto-fix them
@@ -27,6 +29,29 @@ public:
 	 */
 	virtual void Validate(const UObject* Asset, TArray<FAtlasIssue>& OutIssues) = 0;
 
+	/**
+	 * Check if this rule can validate an asset from its asset registry data alone
+	 * Rules returning true never force the asset to be loaded during a scan
+	 * @param AssetData The asset registry entry of the asset
+	 * @return True if ValidateAssetData can be used instead of Validate for this asset
+	 */
+	virtual bool CanValidateAssetData(const FAssetData& AssetData) const { return false; }
+
+	/**
+	 * Validate an asset using only its asset registry tags
+	 * Only called when CanValidateAssetData returned true for the same asset
+	 * @param AssetData The asset registry entry to validate
+	 * @param OutIssues Array to append any found issues to
+	 */
+	virtual void ValidateAssetData(const FAssetData& AssetData, TArray<FAtlasIssue>& OutIssues) {}
+
+	/**
+	 * Get the asset classes this rule applies to (subclasses included)
+	 * The rule registry uses this to dispatch assets only to relevant rules; leave empty to receive every asset
+	 * @param OutClasses Array to fill with supported classes
+	 */
+	virtual void GetSupportedClasses(TArray<const UClass*>& OutClasses) const {}
+
 	/**
 	 * Get a description of what this rule checks
 	 * @return Human-readable description
@@ -38,4 +63,48 @@ public:
 	 * @return True if the rule should run
 	 */
 	virtual bool IsEnabled() const { return true; }
+
+	/**
+	 * Check if this rule can run on worker threads during a parallel scan
+	 * Thread-safe rules must only read the asset and must not mutate shared state in Validate
+	 * Assets finish compiling on the game thread before they are handed to workers; anything else that
+	 * may block on the game thread (other assets, material parent chains) rules out thread safety
+	 * @return True if Validate/ValidateAssetData may be called concurrently
+	 */
+	virtual bool IsThreadSafe() const { return false; }
+
+	/**
+	 * Get the version of this rule's logic
+	 * Bump it whenever the rule starts reporting different issues for the same asset, to invalidate cached scan results
+	 * @return The rule version
+	 */
+	virtual int32 GetRuleVersion() const { return 1; }
+
+	/**
+	 * Check if this rule's results may be cached per package
+	 * Rules whose results depend on other packages (e.g. everything a level references) must return false,
+	 * since the scan cache only notices changes to the validated package itself
+	 * @return True if results can be reused until the package changes
+	 */
+	virtual bool SupportsCaching() const { return true; }
+
+	/**
+	 * Check if this rule runs when live validation revalidates a changed package
+	 * Rules whose check of one asset loads or compares many other assets should return false;
+	 * full scans and selection scans still run them
+	 * @return True if the rule may run in the background after every save
+	 */
+	virtual bool SupportsLiveValidation() const { return true; }
+
+	/**
+	 * Called on the game thread before a scan over many assets
+	 * Rules that compare assets with each other can reuse shared state until EndScan instead of
+	 * rebuilding it for every asset
+	 */
+	virtual void BeginScan() {}
+
+	/**
+	 * Called on the game thread after a scan; release anything kept since BeginScan
+	 */
+	virtual void EndScan() {}
 };
@@ -0,0 +1,35 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+using System.IO;
+using UnrealBuildTool;
+
+public class AtlasEditorTests : ModuleRules
+{
+	public AtlasEditorTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateIncludePaths.AddRange(
+			new string[] {
+				// Tests drive the scan, classifier, report and fix internals directly
+				Path.Combine(ModuleDirectory, "..", "AtlasEditor", "Private"),
+			}
+		);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"UnrealEd",
+				"AssetRegistry",
+				"Projects",
+				"Json",
+				"DeveloperSettings",
+				"AtlasRuntime",
+				"AtlasEditor",
+			}
+		);
+	}
+}
@@ -0,0 +1,303 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBenchmarkContent.h"
+#include "Core/AtlasTextureUtils.h"
+#include "AtlasRuntime.h"
+#include "AtlasTypes.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace AtlasBenchmarkContent
+{
+	struct FTextureKind
+	{
+		EAtlasMapType MapType;
+		const TCHAR* Suffix;
+	};
+
+	/** The first four kinds are the ones a wrong compression or sRGB flag is reported for */
+	static const FTextureKind TextureKinds[] =
+	{
+		{ EAtlasMapType::BaseColor, TEXT("BaseColor") },
+		{ EAtlasMapType::BaseColor, TEXT("D") },
+		{ EAtlasMapType::Normal, TEXT("Normal") },
+		{ EAtlasMapType::Normal, TEXT("N") },
+		{ EAtlasMapType::Roughness, TEXT("R") },
+		{ EAtlasMapType::Metalness, TEXT("Metallic") },
+		{ EAtlasMapType::AO, TEXT("AO") },
+	};
+
+	static constexpr int32 NumTextureKinds = UE_ARRAY_COUNT(TextureKinds);
+	static constexpr int32 NumViolatingKinds = 4;
+
+	static constexpr int32 TextureSize = 4;
+
+	/** Spread violations evenly, so every prefix of the assets has the requested rate */
+	static bool IsViolation(int32 Index, float Rate)
+	{
+		return static_cast<int64>((Index + 1) * static_cast<double>(Rate)) > static_cast<int64>(Index * static_cast<double>(Rate));
+	}
+
+	static const TSet<FString> NoViolations;
+}
+
+using namespace AtlasBenchmarkContent;
+
+const TCHAR* FAtlasBenchmarkContent::RootPath = TEXT("/Game/AtlasBenchmark");
+
+FAtlasBenchmarkContent::FAtlasBenchmarkContent()
+	: ParentMaterial(nullptr)
+{
+}
+
+FAtlasBenchmarkContent::~FAtlasBenchmarkContent()
+{
+	Reset();
+}
+
+template<typename T>
+T* FAtlasBenchmarkContent::CreateAsset(const TCHAR* Folder, const FString& AssetName)
+{
+	const FString PackageName = FString::Printf(TEXT("%s/%s/%s"), RootPath, Folder, *AssetName);
+	UPackage* Package = CreatePackage(*PackageName);
+
+	T* Asset = NewObject<T>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	Objects.Add(Asset);
+	return Asset;
+}
+
+bool FAtlasBenchmarkContent::Generate(int32 NumAssets, float ViolationRate, int32 Seed)
+{
+	Reset();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.HasAssets(RootPath, true))
+	{
+		UE_LOG(LogAtlas, Error, TEXT("%s already contains assets; delete them before running benchmarks"), RootPath);
+		return false;
+	}
+
+	FRandomStream Random(Seed);
+
+	const int32 NumTextures = NumAssets / 2;
+	const int32 NumMeshes = NumAssets / 4;
+	const int32 NumInstances = NumAssets - NumTextures - NumMeshes;
+
+	TextureNames.Reserve(NumTextures);
+	for (int32 Index = 0; Index < NumTextures; ++Index)
+	{
+		CreateTexture(Index, IsViolation(Index, ViolationRate), Random);
+	}
+
+	for (int32 Index = 0; Index < NumMeshes; ++Index)
+	{
+		CreateMesh(Index, IsViolation(Index, ViolationRate));
+	}
+
+	if (NumInstances > 0)
+	{
+		ParentMaterial = CreateAsset<UMaterial>(TEXT("Materials"), TEXT("M_Bench_Parent"));
+		ParentMaterial->MarkPackageDirty();
+		FAssetRegistryModule::AssetCreated(ParentMaterial);
+
+		for (int32 Index = 0; Index < NumInstances; ++Index)
+		{
+			CreateMaterialInstance(Index, IsViolation(Index, ViolationRate), Random);
+		}
+
+		// Duplicate detection walks package dependencies, which only exist for saved packages
+		TArray<UPackage*> Packages;
+		for (const TWeakObjectPtr<UObject>& Object : Objects)
+		{
+			if (Object.IsValid() && Object->IsA<UMaterialInterface>())
+			{
+				Packages.Add(Object->GetOutermost());
+			}
+		}
+
+		if (!UEditorLoadingAndSavingUtils::SavePackages(Packages, false))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to save the benchmark materials"));
+		}
+
+		for (const UPackage* Package : Packages)
+		{
+			SavedFiles.Add(FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()));
+		}
+
+		AssetRegistry.ScanFilesSynchronous(SavedFiles, true);
+	}
+
+	AssetRegistry.GetAssetsByPath(RootPath, Assets, true);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B)
+	{
+		return A.ObjectPath.LexicalLess(B.ObjectPath);
+	});
+
+	UE_LOG(LogAtlas, Display, TEXT("Generated %d benchmark assets (%d textures, %d meshes, %d material instances)"),
+		Assets.Num(), NumTextures, NumMeshes, NumInstances);
+
+	return true;
+}
+
+void FAtlasBenchmarkContent::Reset()
+{
+	if (Objects.Num() == 0 && SavedFiles.Num() == 0)
+	{
+		return;
+	}
+
+	// Fix batches leave the assets in the undo history
+	if (GEditor)
+	{
+		GEditor->ResetTransaction(FText::FromString(TEXT("Delete Atlas benchmark content")));
+	}
+
+	for (const TWeakObjectPtr<UObject>& WeakObject : Objects)
+	{
+		UObject* Object = WeakObject.Get();
+		if (!Object)
+		{
+			continue;
+		}
+
+		FAssetRegistryModule::AssetDeleted(Object);
+
+		UPackage* Package = Object->GetOutermost();
+		Object->ClearFlags(RF_Public | RF_Standalone);
+		Object->MarkAsGarbage();
+		Package->SetDirtyFlag(false);
+		Package->MarkAsGarbage();
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	IFileManager& FileManager = IFileManager::Get();
+	for (const FString& File : SavedFiles)
+	{
+		FileManager.Delete(*File, false, true, true);
+	}
+
+	// Only empty folders are removed, so nothing else put there is lost
+	const FString RootDirectory = FPackageName::LongPackageNameToFilename(RootPath);
+	for (const TCHAR* Folder : { TEXT("Textures"), TEXT("Meshes"), TEXT("Materials") })
+	{
+		FileManager.DeleteDirectory(*(RootDirectory / Folder), false, false);
+	}
+	FileManager.DeleteDirectory(*RootDirectory, false, false);
+
+	Objects.Reset();
+	Assets.Reset();
+	TextureNames.Reset();
+	Violations.Reset();
+	UniqueScalarValues.Reset();
+	SavedFiles.Reset();
+	ParentMaterial = nullptr;
+}
+
+const TSet<FString>& FAtlasBenchmarkContent::GetViolations(FName RuleName) const
+{
+	const TSet<FString>* Paths = Violations.Find(RuleName);
+	return Paths ? *Paths : NoViolations;
+}
+
+void FAtlasBenchmarkContent::CreateTexture(int32 Index, bool bViolation, FRandomStream& Random)
+{
+	const FTextureKind& Kind = TextureKinds[Random.RandHelper(bViolation ? NumViolatingKinds : NumTextureKinds)];
+	const FString Name = FString::Printf(TEXT("T_Bench_%06d_%s"), Index, Kind.Suffix);
+
+	UTexture2D* Texture = CreateAsset<UTexture2D>(TEXT("Textures"), Name);
+	TextureNames.Add(Name);
+
+	TArray<uint8> Pixels;
+	Pixels.SetNumUninitialized(TextureSize * TextureSize * 4);
+	for (uint8& Value : Pixels)
+	{
+		Value = static_cast<uint8>(Random.RandHelper(256));
+	}
+
+	// Source data only; the platform data is never built, which keeps 100k textures cheap
+	Texture->Source.Init(TextureSize, TextureSize, 1, 1, TSF_BGRA8, Pixels.GetData());
+	Texture->CompressionSettings = static_cast<TextureCompressionSettings>(FAtlasTextureUtils::GetRecommendedCompression(Kind.MapType));
+	Texture->SRGB = Kind.MapType == EAtlasMapType::BaseColor;
+
+	if (bViolation)
+	{
+		// Exactly one issue per texture: a wrong compression, or sRGB on a normal map
+		if (Kind.MapType == EAtlasMapType::BaseColor)
+		{
+			Texture->CompressionSettings = TC_Normalmap;
+		}
+		else if (Random.RandHelper(2) == 0)
+		{
+			Texture->CompressionSettings = TC_Default;
+		}
+		else
+		{
+			Texture->SRGB = true;
+		}
+
+		AddViolation(TEXT("TextureCompression"), Texture);
+	}
+
+	FAssetRegistryModule::AssetCreated(Texture);
+}
+
+void FAtlasBenchmarkContent::CreateMesh(int32 Index, bool bViolation)
+{
+	UStaticMesh* Mesh = CreateAsset<UStaticMesh>(TEXT("Meshes"), FString::Printf(TEXT("SM_Bench_%06d"), Index));
+
+	if (bViolation)
+	{
+		AddViolation(TEXT("StaticMeshCollision"), Mesh);
+	}
+	else
+	{
+		Mesh->CreateBodySetup();
+		Mesh->GetBodySetup()->AggGeom.BoxElems.Add(FKBoxElem(100.0f));
+	}
+
+	FAssetRegistryModule::AssetCreated(Mesh);
+}
+
+void FAtlasBenchmarkContent::CreateMaterialInstance(int32 Index, bool bViolation, FRandomStream& Random)
+{
+	UMaterialInstanceConstant* Instance = CreateAsset<UMaterialInstanceConstant>(TEXT("Materials"), FString::Printf(TEXT("MI_Bench_%06d"), Index));
+	Instance->Parent = ParentMaterial;
+
+	// Instances are named in creation order, so the original of each group sorts first and is the one kept
+	float Value = 0.0f;
+	if (bViolation && UniqueScalarValues.Num() > 0)
+	{
+		Value = UniqueScalarValues[Random.RandHelper(UniqueScalarValues.Num())];
+		AddViolation(TEXT("MaterialInstanceDup"), Instance);
+	}
+	else
+	{
+		// Whole numbers stay distinct under any sensible parameter tolerance
+		Value = static_cast<float>(UniqueScalarValues.Num() + 1);
+		UniqueScalarValues.Add(Value);
+	}
+
+	FScalarParameterValue& Parameter = Instance->ScalarParameterValues.AddDefaulted_GetRef();
+	Parameter.ParameterInfo = FMaterialParameterInfo(TEXT("Tint"));
+	Parameter.ParameterValue = Value;
+
+	Instance->MarkPackageDirty();
+	FAssetRegistryModule::AssetCreated(Instance);
+}
+
+void FAtlasBenchmarkContent::AddViolation(FName RuleName, const UObject* Asset)
+{
+	Violations.FindOrAdd(RuleName).Add(Asset->GetPathName());
+}
@@ -0,0 +1,82 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+class UMaterial;
+
+/**
+ * Procedurally generated textures, static meshes and material instances in /Game/AtlasBenchmark
+ *
+ * Half of the assets are textures, a quarter meshes and a quarter material instances. A fixed
+ * fraction of each kind breaks exactly one rule, so the expected issues are known up front:
+ *  - TextureCompression: base color maps compressed as normal maps, normal maps with default compression or sRGB
+ *  - StaticMeshCollision: meshes without a body setup
+ *  - MaterialInstanceDup: instances repeating the parameters of an earlier instance
+ *
+ * Assets stay loaded for the whole benchmark, so scans measure rule cost rather than disk speed.
+ * Textures and meshes only exist in memory; material instances and their parent are saved, because
+ * duplicate detection finds siblings through package dependencies, which the asset registry only
+ * records for packages on disk. Everything is deleted again by Reset.
+ */
+class FAtlasBenchmarkContent
+{
+public:
+	/** Long package path all content is created under */
+	static const TCHAR* RootPath;
+
+	FAtlasBenchmarkContent();
+	~FAtlasBenchmarkContent();
+
+	/**
+	 * Generate content, replacing anything generated before
+	 * @param NumAssets Total number of assets
+	 * @param ViolationRate Fraction of each asset kind that breaks its rule, 0 to 1
+	 * @param Seed Random seed; the same seed always produces the same content
+	 * @return False if /Game/AtlasBenchmark already holds assets, e.g. left over by a crashed run
+	 */
+	bool Generate(int32 NumAssets, float ViolationRate, int32 Seed);
+
+	/** Delete every generated asset and package file */
+	void Reset();
+
+	/** Registry entries of the generated assets, sorted by object path */
+	const TArray<FAssetData>& GetAssets() const { return Assets; }
+
+	/** Names of the generated textures */
+	const TArray<FString>& GetTextureNames() const { return TextureNames; }
+
+	/**
+	 * Get the assets generated to break a rule
+	 * @param RuleName TextureCompression, StaticMeshCollision or MaterialInstanceDup
+	 * @return Object paths of the violating assets
+	 */
+	const TSet<FString>& GetViolations(FName RuleName) const;
+
+private:
+	void CreateTexture(int32 Index, bool bViolation, FRandomStream& Random);
+	void CreateMesh(int32 Index, bool bViolation);
+	void CreateMaterialInstance(int32 Index, bool bViolation, FRandomStream& Random);
+
+	/** Create a new package holding one asset; the caller registers it once its properties are set */
+	template<typename T>
+	T* CreateAsset(const TCHAR* Folder, const FString& AssetName);
+
+	void AddViolation(FName RuleName, const UObject* Asset);
+
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	TArray<FAssetData> Assets;
+	TArray<FString> TextureNames;
+	TMap<FName, TSet<FString>> Violations;
+
+	/** Parent of every generated material instance */
+	UMaterial* ParentMaterial;
+
+	/** Scalar values of the unique instances; duplicates copy one of them */
+	TArray<float> UniqueScalarValues;
+
+	/** Package files written for the material instances */
+	TArray<FString> SavedFiles;
+};
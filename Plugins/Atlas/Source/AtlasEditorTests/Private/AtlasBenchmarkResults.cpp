@@ -0,0 +1,121 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBenchmarkResults.h"
+#include "AtlasRuntime.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+FAtlasBenchmarkResults::FAtlasBenchmarkResults(const FString& InName)
+	: Name(InName)
+{
+}
+
+void FAtlasBenchmarkResults::SetParameter(const FString& Key, double Value)
+{
+	NumberParameters.Emplace(Key, Value);
+}
+
+void FAtlasBenchmarkResults::SetParameter(const FString& Key, const FString& Value)
+{
+	StringParameters.Emplace(Key, Value);
+}
+
+FAtlasBenchmarkStage& FAtlasBenchmarkResults::Measure(const FString& StageName, TFunctionRef<int64()> Work)
+{
+	FAtlasBenchmarkStage& Stage = Stages.AddDefaulted_GetRef();
+	Stage.Name = StageName;
+	Stage.UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Stage.NumItems = Work();
+	Stage.Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Stage.UsedPhysicalAfter = MemoryStats.UsedPhysical;
+	Stage.PeakUsedPhysical = MemoryStats.PeakUsedPhysical;
+
+	UE_LOG(LogAtlas, Display, TEXT("Benchmark %s/%s: %lld items in %.3fs (%.0f/s), peak %.1f MB"),
+		*Name, *StageName, Stage.NumItems, Stage.Seconds, Stage.GetItemsPerSecond(), Stage.PeakUsedPhysical / (1024.0 * 1024.0));
+
+	return Stage;
+}
+
+bool FAtlasBenchmarkResults::Save(FString& OutFilePath) const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("benchmark"), Name);
+	Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Root->SetStringField(TEXT("buildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Root->SetNumberField(TEXT("numCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+
+	// Lets CI tag results with the commit under test
+	FString Revision;
+	FParse::Value(FCommandLine::Get(), TEXT("AtlasBenchmarkRevision="), Revision);
+	Root->SetStringField(TEXT("revision"), Revision);
+
+	TSharedRef<FJsonObject> Parameters = MakeShared<FJsonObject>();
+	for (const TPair<FString, double>& Parameter : NumberParameters)
+	{
+		Parameters->SetNumberField(Parameter.Key, Parameter.Value);
+	}
+	for (const TPair<FString, FString>& Parameter : StringParameters)
+	{
+		Parameters->SetStringField(Parameter.Key, Parameter.Value);
+	}
+	Root->SetObjectField(TEXT("parameters"), Parameters);
+
+	TArray<TSharedPtr<FJsonValue>> StageValues;
+	for (const FAtlasBenchmarkStage& Stage : Stages)
+	{
+		TSharedRef<FJsonObject> StageObject = MakeShared<FJsonObject>();
+		StageObject->SetStringField(TEXT("name"), Stage.Name);
+		StageObject->SetNumberField(TEXT("items"), static_cast<double>(Stage.NumItems));
+		StageObject->SetNumberField(TEXT("seconds"), Stage.Seconds);
+		StageObject->SetNumberField(TEXT("itemsPerSecond"), Stage.GetItemsPerSecond());
+		StageObject->SetNumberField(TEXT("usedPhysicalBeforeBytes"), static_cast<double>(Stage.UsedPhysicalBefore));
+		StageObject->SetNumberField(TEXT("usedPhysicalAfterBytes"), static_cast<double>(Stage.UsedPhysicalAfter));
+		StageObject->SetNumberField(TEXT("peakUsedPhysicalBytes"), static_cast<double>(Stage.PeakUsedPhysical));
+
+		TSharedRef<FJsonObject> Counters = MakeShared<FJsonObject>();
+		for (const TPair<FString, double>& Counter : Stage.Counters)
+		{
+			Counters->SetNumberField(Counter.Key, Counter.Value);
+		}
+		StageObject->SetObjectField(TEXT("counters"), Counters);
+
+		StageValues.Add(MakeShared<FJsonValueObject>(StageObject));
+	}
+	Root->SetArrayField(TEXT("stages"), StageValues);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	if (!FJsonSerializer::Serialize(Root, Writer))
+	{
+		return false;
+	}
+
+	OutFilePath = GetOutputDirectory() / (Name + TEXT(".json"));
+	return FFileHelper::SaveStringToFile(Json, *OutFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+FString FAtlasBenchmarkResults::GetOutputDirectory()
+{
+	FString Directory;
+	if (FParse::Value(FCommandLine::Get(), TEXT("AtlasBenchmarkDir="), Directory))
+	{
+		return FPaths::ConvertRelativePathToFull(Directory);
+	}
+
+	return FPaths::ProjectSavedDir() / TEXT("Atlas") / TEXT("Benchmarks");
+}
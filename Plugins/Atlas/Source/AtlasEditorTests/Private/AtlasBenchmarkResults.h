@@ -0,0 +1,87 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Timing and memory of one benchmark stage
+ */
+struct FAtlasBenchmarkStage
+{
+	FString Name;
+
+	/** Assets, names, issues or fixes processed by the stage */
+	int64 NumItems;
+
+	double Seconds;
+
+	/** Physical memory in use before and after the stage */
+	uint64 UsedPhysicalBefore;
+	uint64 UsedPhysicalAfter;
+
+	/** High-water mark of the process after the stage; only covers this stage if nothing bigger ran earlier */
+	uint64 PeakUsedPhysical;
+
+	/** Stage-specific numbers, e.g. issues found or bytes written */
+	TArray<TPair<FString, double>> Counters;
+
+	FAtlasBenchmarkStage()
+		: NumItems(0)
+		, Seconds(0.0)
+		, UsedPhysicalBefore(0)
+		, UsedPhysicalAfter(0)
+		, PeakUsedPhysical(0)
+	{
+	}
+
+	double GetItemsPerSecond() const { return Seconds > 0.0 ? NumItems / Seconds : 0.0; }
+
+	void AddCounter(const FString& CounterName, double Value) { Counters.Emplace(CounterName, Value); }
+};
+
+/**
+ * Results of one benchmark run, saved as JSON in Saved/Atlas/Benchmarks
+ *
+ * Each run overwrites <Name>.json, so CI can archive the file per commit and diff throughput
+ * ("itemsPerSecond") and memory ("peakUsedPhysicalBytes") between builds.
+ */
+class FAtlasBenchmarkResults
+{
+public:
+	/**
+	 * @param InName File name of the results, e.g. "Pipeline-10k"
+	 */
+	explicit FAtlasBenchmarkResults(const FString& InName);
+
+	/** Describe the run, e.g. scale or violation rate */
+	void SetParameter(const FString& Key, double Value);
+	void SetParameter(const FString& Key, const FString& Value);
+
+	/**
+	 * Run and time one stage
+	 * @param StageName Name of the stage in the results
+	 * @param Work The stage; returns the number of items it processed
+	 * @return The recorded stage, valid until the next call to Measure
+	 */
+	FAtlasBenchmarkStage& Measure(const FString& StageName, TFunctionRef<int64()> Work);
+
+	/**
+	 * Write the results file
+	 * @param OutFilePath Receives the path of the written file
+	 * @return True if the file was written
+	 */
+	bool Save(FString& OutFilePath) const;
+
+	/**
+	 * Get the directory results are written to
+	 * @return -AtlasBenchmarkDir= if given, Saved/Atlas/Benchmarks otherwise
+	 */
+	static FString GetOutputDirectory();
+
+private:
+	FString Name;
+	TArray<TPair<FString, double>> NumberParameters;
+	TArray<TPair<FString, FString>> StringParameters;
+	TArray<FAtlasBenchmarkStage> Stages;
+};
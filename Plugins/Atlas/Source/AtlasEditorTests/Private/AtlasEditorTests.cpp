@@ -0,0 +1,6 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Automation tests only; everything is registered by the IMPLEMENT_*_AUTOMATION_TEST macros
+IMPLEMENT_MODULE(FDefaultModuleImpl, AtlasEditorTests)
@@ -0,0 +1,222 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBenchmarkResults.h"
+#include "Core/AtlasMapTypeClassifier.h"
+#include "Core/AtlasTextureUtils.h"
+#include "AtlasTypes.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AtlasMapTypeClassifierTests
+{
+	/** Names timed per stage of the classifier benchmark */
+	static constexpr int32 NumBenchmarkNames = 100000;
+	static constexpr int32 NumBenchmarkPasses = 10;
+
+	/** One line of TestContent/MapTypeNames.csv */
+	struct FGoldenName
+	{
+		FString Name;
+		EAtlasMapType MapType;
+		int32 SuffixStart;
+	};
+
+	static FString GetMapTypeName(EAtlasMapType MapType)
+	{
+		return StaticEnum<EAtlasMapType>()->GetNameStringByValue(static_cast<int64>(MapType));
+	}
+
+	/**
+	 * Load the golden name corpus
+	 * @return False if the file is missing or has no valid lines; malformed lines are reported as errors
+	 */
+	static bool LoadGoldenNames(FAutomationTestBase& Test, TArray<FGoldenName>& OutNames)
+	{
+		const FString FilePath = IPluginManager::Get().FindPlugin(TEXT("Atlas"))->GetBaseDir() / TEXT("TestContent") / TEXT("MapTypeNames.csv");
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+		{
+			Test.AddError(FString::Printf(TEXT("Could not read %s"), *FilePath));
+			return false;
+		}
+
+		const UEnum* MapTypeEnum = StaticEnum<EAtlasMapType>();
+		for (const FString& Line : Lines)
+		{
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+			{
+				continue;
+			}
+
+			TArray<FString> Fields;
+			Line.ParseIntoArray(Fields, TEXT(","), false);
+
+			const int64 MapType = Fields.Num() == 3 ? MapTypeEnum->GetValueByNameString(Fields[1]) : INDEX_NONE;
+			if (MapType == INDEX_NONE || !Fields[2].IsNumeric())
+			{
+				Test.AddError(FString::Printf(TEXT("Malformed line in %s: '%s'"), *FilePath, *Line));
+				continue;
+			}
+
+			FGoldenName& Golden = OutNames.AddDefaulted_GetRef();
+			Golden.Name = Fields[0];
+			Golden.MapType = static_cast<EAtlasMapType>(MapType);
+			Golden.SuffixStart = FCString::Atoi(*Fields[2]);
+		}
+
+		return OutNames.Num() > 0;
+	}
+}
+
+/**
+ * Every name of the golden corpus classifies to its recorded map type and suffix position
+ * Uses the built-in suffix table, so project settings do not change the outcome.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAtlasMapTypeGoldenNamesTest, "Atlas.Classifier.GoldenNames", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FAtlasMapTypeGoldenNamesTest::RunTest(const FString& Parameters)
+{
+	using namespace AtlasMapTypeClassifierTests;
+
+	TArray<FGoldenName> Corpus;
+	if (!LoadGoldenNames(*this, Corpus))
+	{
+		return false;
+	}
+
+	const FAtlasMapTypeClassifier Classifier(FAtlasMapTypeClassifier::GetDefaultSuffixes());
+
+	TArray<FString> Names;
+	for (const FGoldenName& Golden : Corpus)
+	{
+		int32 SuffixStart = INDEX_NONE;
+		const EAtlasMapType MapType = Classifier.Classify(Golden.Name, &SuffixStart);
+
+		TestEqual(FString::Printf(TEXT("Map type of '%s'"), *Golden.Name), GetMapTypeName(MapType), GetMapTypeName(Golden.MapType));
+		TestEqual(FString::Printf(TEXT("Suffix start of '%s'"), *Golden.Name), SuffixStart, Golden.SuffixStart);
+
+		Names.Add(Golden.Name);
+	}
+
+	TArray<EAtlasMapType> BatchTypes;
+	TArray<int32> BatchSuffixStarts;
+	Classifier.ClassifyBatch(Names, BatchTypes, &BatchSuffixStarts);
+
+	for (int32 Index = 0; Index < Corpus.Num(); ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("ClassifyBatch map type of '%s'"), *Corpus[Index].Name), GetMapTypeName(BatchTypes[Index]), GetMapTypeName(Corpus[Index].MapType));
+		TestEqual(FString::Printf(TEXT("ClassifyBatch suffix start of '%s'"), *Corpus[Index].Name), BatchSuffixStarts[Index], Corpus[Index].SuffixStart);
+	}
+
+	return true;
+}
+
+/**
+ * Classifier throughput on names built from the golden corpus
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAtlasMapTypeClassifierBenchmark, "Atlas.Benchmark.Classifier", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FAtlasMapTypeClassifierBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace AtlasMapTypeClassifierTests;
+
+	TArray<FGoldenName> Corpus;
+	if (!LoadGoldenNames(*this, Corpus))
+	{
+		return false;
+	}
+
+	// A distinct middle token per name, so nothing benefits from repeated identical strings
+	TArray<FString> Names;
+	Names.Reserve(NumBenchmarkNames);
+	for (int32 Index = 0; Index < NumBenchmarkNames; ++Index)
+	{
+		Names.Add(FString::Printf(TEXT("T_Set%d_%s"), Index / Corpus.Num(), *Corpus[Index % Corpus.Num()].Name));
+	}
+
+	const FAtlasMapTypeClassifier Classifier(FAtlasMapTypeClassifier::GetDefaultSuffixes());
+	const int64 NumItems = static_cast<int64>(NumBenchmarkNames) * NumBenchmarkPasses;
+
+	FAtlasBenchmarkResults Results(TEXT("Classifier"));
+	Results.SetParameter(TEXT("names"), NumBenchmarkNames);
+	Results.SetParameter(TEXT("passes"), NumBenchmarkPasses);
+
+	// Counting results keeps the calls from being optimized away
+	int32 NumTokens = 0;
+	FAtlasBenchmarkStage& TokenizeStage = Results.Measure(TEXT("Tokenize"), [&]() -> int64
+	{
+		FAtlasMapTypeClassifier::FToken Tokens[FAtlasMapTypeClassifier::MaxTokens];
+		for (int32 Pass = 0; Pass < NumBenchmarkPasses; ++Pass)
+		{
+			for (const FString& Name : Names)
+			{
+				NumTokens += FAtlasMapTypeClassifier::Tokenize(Name, Tokens);
+			}
+		}
+		return NumItems;
+	});
+	TokenizeStage.AddCounter(TEXT("tokens"), NumTokens);
+
+	int32 NumClassified = 0;
+	FAtlasBenchmarkStage& ClassifyStage = Results.Measure(TEXT("Classify"), [&]() -> int64
+	{
+		for (int32 Pass = 0; Pass < NumBenchmarkPasses; ++Pass)
+		{
+			for (const FString& Name : Names)
+			{
+				if (Classifier.Classify(Name) != EAtlasMapType::Unknown)
+				{
+					++NumClassified;
+				}
+			}
+		}
+		return NumItems;
+	});
+	ClassifyStage.AddCounter(TEXT("classified"), NumClassified);
+
+	TArray<EAtlasMapType> Types;
+	Results.Measure(TEXT("ClassifyBatch"), [&]() -> int64
+	{
+		for (int32 Pass = 0; Pass < NumBenchmarkPasses; ++Pass)
+		{
+			Classifier.ClassifyBatch(Names, Types);
+		}
+		return NumItems;
+	});
+
+	// Through the settings classifier, the path every rule takes
+	int32 NumDetected = 0;
+	FAtlasBenchmarkStage& DetectStage = Results.Measure(TEXT("DetectMapTypeByName"), [&]() -> int64
+	{
+		for (int32 Pass = 0; Pass < NumBenchmarkPasses; ++Pass)
+		{
+			for (const FString& Name : Names)
+			{
+				if (FAtlasTextureUtils::DetectMapTypeByName(Name) != EAtlasMapType::Unknown)
+				{
+					++NumDetected;
+				}
+			}
+		}
+		return NumItems;
+	});
+	DetectStage.AddCounter(TEXT("classified"), NumDetected);
+
+	FString ResultsPath;
+	if (Results.Save(ResultsPath))
+	{
+		AddInfo(FString::Printf(TEXT("Benchmark results written to %s"), *ResultsPath));
+	}
+	else
+	{
+		AddError(TEXT("Could not write the benchmark results"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,278 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasBenchmarkContent.h"
+#include "AtlasBenchmarkResults.h"
+#include "Core/AtlasFixExecutor.h"
+#include "Core/AtlasScanExecutor.h"
+#include "Core/AtlasTextureUtils.h"
+#include "Overview/AtlasBinaryReport.h"
+#include "Overview/AtlasReportWriter.h"
+#include "AtlasSettings.h"
+#include "AtlasTypes.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "TextureCompiler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AtlasPipelineBenchmarkTests
+{
+	static constexpr float DefaultViolationRate = 0.2f;
+	static constexpr int32 DefaultSeed = 1234;
+
+	/** Fixes rebuild textures, so the fix stage is capped to keep 100k runs reasonable */
+	static constexpr int32 DefaultMaxFixes = 2000;
+
+	/** Classifications timed by the DetectMapTypeByName stage at least, however few textures there are */
+	static constexpr int32 MinClassifications = 1000000;
+
+	/** Benchmarks time the rules rather than cache hits, and must not prune the project's scan cache */
+	class FScopedScanCacheDisabled
+	{
+	public:
+		FScopedScanCacheDisabled()
+			: Settings(GetMutableDefault<UAtlasSettings>())
+			, bWasEnabled(Settings->bUseScanCache)
+		{
+			Settings->bUseScanCache = false;
+		}
+
+		~FScopedScanCacheDisabled()
+		{
+			Settings->bUseScanCache = bWasEnabled;
+		}
+
+	private:
+		UAtlasSettings* Settings;
+		bool bWasEnabled;
+	};
+
+	/** Check that a rule reported exactly the generated violations */
+	static void TestViolations(FAutomationTestBase& Test, const TArray<FAtlasIssue>& Issues, const FAtlasBenchmarkContent& Content, FName RuleName)
+	{
+		const TSet<FString>& Expected = Content.GetViolations(RuleName);
+
+		int32 NumIssues = 0;
+		int32 NumUnexpected = 0;
+		for (const FAtlasIssue& Issue : Issues)
+		{
+			if (Issue.RuleName != RuleName || !Issue.AssetPath.StartsWith(FAtlasBenchmarkContent::RootPath))
+			{
+				continue;
+			}
+
+			++NumIssues;
+			if (!Expected.Contains(Issue.AssetPath))
+			{
+				++NumUnexpected;
+			}
+		}
+
+		Test.TestEqual(FString::Printf(TEXT("%s issues on generated assets"), *RuleName.ToString()), NumIssues, Expected.Num());
+		Test.TestEqual(FString::Printf(TEXT("%s issues on assets generated without a violation"), *RuleName.ToString()), NumUnexpected, 0);
+	}
+
+	/** Time one report writer and record the size of its output */
+	static void MeasureReport(FAutomationTestBase& Test, FAtlasBenchmarkResults& Results, const FString& StageName, const FAtlasReport& Report, const FString& FilePath, TFunctionRef<bool()> Write)
+	{
+		bool bWritten = false;
+		FAtlasBenchmarkStage& Stage = Results.Measure(StageName, [&]() -> int64
+		{
+			bWritten = Write();
+			return Report.Issues.Num();
+		});
+
+		Test.TestTrue(FString::Printf(TEXT("%s wrote %s"), *StageName, *FilePath), bWritten);
+		Stage.AddCounter(TEXT("bytes"), static_cast<double>(IFileManager::Get().FileSize(*FilePath)));
+
+		IFileManager::Get().Delete(*FilePath, false, true, true);
+	}
+}
+
+/**
+ * Generates synthetic content and times every stage of a validation run on it
+ * Run one scale per process when comparing peak memory, since the process high-water mark only grows.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAtlasPipelineBenchmark, "Atlas.Benchmark.Pipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FAtlasPipelineBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(TEXT("1k"));
+	OutTestCommands.Add(TEXT("1000"));
+
+	OutBeautifiedNames.Add(TEXT("10k"));
+	OutTestCommands.Add(TEXT("10000"));
+
+	OutBeautifiedNames.Add(TEXT("100k"));
+	OutTestCommands.Add(TEXT("100000"));
+}
+
+bool FAtlasPipelineBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace AtlasPipelineBenchmarkTests;
+
+	const int32 NumAssets = FCString::Atoi(*Parameters);
+
+	float ViolationRate = DefaultViolationRate;
+	int32 Seed = DefaultSeed;
+	int32 MaxFixes = DefaultMaxFixes;
+	FParse::Value(FCommandLine::Get(), TEXT("AtlasBenchmarkViolationRate="), ViolationRate);
+	FParse::Value(FCommandLine::Get(), TEXT("AtlasBenchmarkSeed="), Seed);
+	FParse::Value(FCommandLine::Get(), TEXT("AtlasBenchmarkMaxFixes="), MaxFixes);
+	ViolationRate = FMath::Clamp(ViolationRate, 0.0f, 1.0f);
+
+	FAtlasBenchmarkResults Results(FString::Printf(TEXT("Pipeline-%dk"), NumAssets / 1000));
+	Results.SetParameter(TEXT("assets"), NumAssets);
+	Results.SetParameter(TEXT("violationRate"), ViolationRate);
+	Results.SetParameter(TEXT("seed"), Seed);
+	Results.SetParameter(TEXT("maxFixes"), MaxFixes);
+	Results.SetParameter(TEXT("parallelScan"), UAtlasSettings::Get()->bParallelScan ? 1.0 : 0.0);
+
+	FScopedScanCacheDisabled ScanCacheDisabled;
+	FAtlasBenchmarkContent Content;
+
+	bool bGenerated = false;
+	Results.Measure(TEXT("Generate"), [&]() -> int64
+	{
+		bGenerated = Content.Generate(NumAssets, ViolationRate, Seed);
+		return Content.GetAssets().Num();
+	});
+
+	if (!bGenerated)
+	{
+		AddError(FString::Printf(TEXT("Could not generate benchmark content in %s"), FAtlasBenchmarkContent::RootPath));
+		return false;
+	}
+
+	// Generated assets only; every planted violation must be found
+	TArray<FAtlasIssue> SelectionIssues;
+	FAtlasScanStats SelectionStats;
+	FAtlasBenchmarkStage& SelectionStage = Results.Measure(TEXT("ScanSelection"), [&]() -> int64
+	{
+		FAtlasScanExecutor::ScanSelection(Content.GetAssets(), SelectionIssues, &SelectionStats);
+		return SelectionStats.NumAssets;
+	});
+	SelectionStage.AddCounter(TEXT("issues"), SelectionIssues.Num());
+	SelectionStage.AddCounter(TEXT("loaded"), SelectionStats.NumLoaded);
+	SelectionStage.AddCounter(TEXT("loadsAvoided"), SelectionStats.NumLoadsAvoided);
+
+	TestViolations(*this, SelectionIssues, Content, TEXT("TextureCompression"));
+	TestViolations(*this, SelectionIssues, Content, TEXT("StaticMeshCollision"));
+	TestViolations(*this, SelectionIssues, Content, TEXT("MaterialInstanceDup"));
+
+	// The whole project, generated assets included
+	TArray<FAtlasIssue> AllIssues;
+	FAtlasScanStats AllStats;
+	FAtlasBenchmarkStage& AllStage = Results.Measure(TEXT("ScanAll"), [&]() -> int64
+	{
+		FAtlasScanExecutor::ScanAll(AllIssues, &AllStats);
+		return AllStats.NumAssets;
+	});
+	AllStage.AddCounter(TEXT("issues"), AllIssues.Num());
+	AllStage.AddCounter(TEXT("loaded"), AllStats.NumLoaded);
+	AllStage.AddCounter(TEXT("loadsAvoided"), AllStats.NumLoadsAvoided);
+
+	// The generated assets live in subfolders of /Game and must be enumerated exactly once
+	TestTrue(TEXT("ScanAll visited every generated asset"), AllStats.NumAssets >= Content.GetAssets().Num());
+	TestViolations(*this, AllIssues, Content, TEXT("TextureCompression"));
+	TestViolations(*this, AllIssues, Content, TEXT("StaticMeshCollision"));
+	TestViolations(*this, AllIssues, Content, TEXT("MaterialInstanceDup"));
+
+	const TArray<FString>& TextureNames = Content.GetTextureNames();
+	const int32 NumPasses = TextureNames.Num() > 0 ? FMath::Max(1, MinClassifications / TextureNames.Num()) : 0;
+	int32 NumClassified = 0;
+	FAtlasBenchmarkStage& ClassifyStage = Results.Measure(TEXT("DetectMapTypeByName"), [&]() -> int64
+	{
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (const FString& Name : TextureNames)
+			{
+				// Counting results keeps the calls from being optimized away
+				if (FAtlasTextureUtils::DetectMapTypeByName(Name) != EAtlasMapType::Unknown)
+				{
+					++NumClassified;
+				}
+			}
+		}
+		return static_cast<int64>(NumPasses) * TextureNames.Num();
+	});
+	ClassifyStage.AddCounter(TEXT("classified"), NumClassified);
+
+	FAtlasReport Report;
+	Report.Issues = MoveTemp(AllIssues);
+	Report.Profile = AllStats.Profile;
+
+	const FString ReportDirectory = FAtlasBenchmarkResults::GetOutputDirectory() / TEXT("Reports");
+	const FString JsonPath = ReportDirectory / TEXT("Report.json");
+	const FString GzipPath = ReportDirectory / TEXT("Report.json.gz");
+	const FString BinaryPath = ReportDirectory / TEXT("Report.atlasreport");
+
+	MeasureReport(*this, Results, TEXT("WriteReport"), Report, JsonPath, [&]() { return FAtlasReportWriter::WriteReport(Report, JsonPath, false); });
+	MeasureReport(*this, Results, TEXT("WriteReportGzip"), Report, GzipPath, [&]() { return FAtlasReportWriter::WriteReport(Report, GzipPath, true); });
+	MeasureReport(*this, Results, TEXT("WriteBinaryReport"), Report, BinaryPath, [&]() { return FAtlasBinaryReportWriter::WriteReport(Report, BinaryPath); });
+
+	// Compression fixes only: each is one deferred texture edit, the batched path ApplyFixes optimizes
+	const TSet<FString>& CompressionViolations = Content.GetViolations(TEXT("TextureCompression"));
+	TArray<FAtlasIssue> Fixes;
+	for (const FAtlasIssue& Issue : SelectionIssues)
+	{
+		if (Fixes.Num() < MaxFixes && Issue.RuleName == TEXT("TextureCompression") && CompressionViolations.Contains(Issue.AssetPath))
+		{
+			Fixes.Add(Issue);
+		}
+	}
+
+	FAtlasFixStats FixStats;
+	FAtlasBenchmarkStage& FixStage = Results.Measure(TEXT("ApplyFixes"), [&]() -> int64
+	{
+		FAtlasFixExecutor::ApplyFixes(Fixes, false, &FixStats);
+		return FixStats.NumApplied;
+	});
+	FixStage.AddCounter(TEXT("issues"), FixStats.NumIssues);
+	FixStage.AddCounter(TEXT("objectsEdited"), FixStats.NumObjectsEdited);
+
+	FTextureCompilingManager::Get().FinishAllCompilation();
+
+	TestEqual(TEXT("Fixes applied"), FixStats.NumApplied, Fixes.Num());
+
+	// Fixed textures must scan clean
+	int32 NumRemaining = 0;
+	TArray<FAtlasIssue> AssetIssues;
+	for (const FAtlasIssue& Fix : Fixes)
+	{
+		UTexture2D* Texture = FindObject<UTexture2D>(nullptr, *Fix.AssetPath);
+		if (!Texture)
+		{
+			++NumRemaining;
+			continue;
+		}
+
+		AssetIssues.Reset();
+		FAtlasScanExecutor::ScanAsset(Texture, AssetIssues);
+		for (const FAtlasIssue& Issue : AssetIssues)
+		{
+			if (Issue.RuleName == Fix.RuleName)
+			{
+				++NumRemaining;
+			}
+		}
+	}
+	TestEqual(TEXT("TextureCompression issues left on fixed textures"), NumRemaining, 0);
+
+	FString ResultsPath;
+	if (Results.Save(ResultsPath))
+	{
+		AddInfo(FString::Printf(TEXT("Benchmark results written to %s"), *ResultsPath));
+	}
+	else
+	{
+		AddError(TEXT("Could not write the benchmark results"));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
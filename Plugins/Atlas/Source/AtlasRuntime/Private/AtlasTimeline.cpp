@@ -0,0 +1,789 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#include "AtlasTimeline.h"
+#include "AtlasRuntime.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace AtlasTimeline
+{
+	static constexpr uint32 FileMagic = 0x4C545441; // "ATTL"
+	static constexpr uint32 FileVersion = 1;
+
+	static constexpr uint32 NameIndexMagic = 0x4E545441; // "ATTN"
+	static constexpr uint32 NameIndexVersion = 1;
+
+	/** Smallest bucket count of the name index; it doubles whenever it would be more than half full */
+	static constexpr uint32 MinNameBuckets = 1024;
+
+	struct FFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 RecordSize;
+		uint32 Resolution;
+	};
+
+	struct FNameIndexHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumBuckets;
+		uint32 NumNames;
+
+		/** Size of Timeline.Names.txt when the index was last written */
+		int64 NamesBytes;
+	};
+
+	/** One slot of the name index; a zero hash marks an empty slot */
+	struct FNameIndexBucket
+	{
+		uint64 Hash;
+		uint32 Id;
+		uint32 Padding;
+	};
+
+	static_assert(sizeof(FFileHeader) == 16, "Timeline header layout changed, bump FileVersion");
+	static_assert(sizeof(FNameIndexHeader) == 24, "Name index header layout changed, bump NameIndexVersion");
+	static_assert(sizeof(FNameIndexBucket) == 16, "Name index bucket layout changed, bump NameIndexVersion");
+	static_assert(sizeof(FAtlasTimelineRecord) == 688, "Timeline record layout changed, bump FileVersion");
+	static_assert(sizeof(FAtlasTimelineAggregateRecord) == 760, "Timeline aggregate layout changed, bump FileVersion");
+	static_assert(UE_ARRAY_COUNT(FAtlasTimelineRecord::Rules) == FAtlasTimeline::MaxRules, "MaxRules does not match the record");
+	static_assert(UE_ARRAY_COUNT(FAtlasTimelineRecord::Offenders) == FAtlasTimeline::MaxOffenders, "MaxOffenders does not match the record");
+
+	static uint32 GetRecordSize(EAtlasTimelineResolution Resolution)
+	{
+		return Resolution == EAtlasTimelineResolution::Raw ? sizeof(FAtlasTimelineRecord) : sizeof(FAtlasTimelineAggregateRecord);
+	}
+
+	static FString GetNamesPath(const FString& Directory)
+	{
+		return Directory / TEXT("Timeline.Names.txt");
+	}
+
+	/**
+	 * Load the name table; the id of a name is its line index
+	 * @param OutNeedsNewline Set if the last line was not terminated, i.e. an earlier append was interrupted
+	 */
+	static void LoadNames(const FString& Directory, TArray<FString>& OutNames, bool* OutNeedsNewline = nullptr)
+	{
+		OutNames.Reset();
+		if (OutNeedsNewline)
+		{
+			*OutNeedsNewline = false;
+		}
+
+		FString Content;
+		if (!FFileHelper::LoadFileToString(Content, *GetNamesPath(Directory)) || Content.IsEmpty())
+		{
+			return;
+		}
+
+		// Keep empty lines so ids stay line indices
+		Content.ParseIntoArray(OutNames, TEXT("\n"), false);
+		if (Content.EndsWith(TEXT("\n")))
+		{
+			OutNames.Pop();
+		}
+
+		if (OutNeedsNewline)
+		{
+			*OutNeedsNewline = !Content.EndsWith(TEXT("\n"));
+		}
+	}
+
+	static FString GetNameIndexPath(const FString& Directory)
+	{
+		return Directory / TEXT("Timeline.Names.idx");
+	}
+
+	static int64 GetNamesBytes(const FString& Directory)
+	{
+		return FMath::Max<int64>(IFileManager::Get().FileSize(*GetNamesPath(Directory)), 0);
+	}
+
+	static uint64 HashName(const FString& Name)
+	{
+		const FTCHARToUTF8 Utf8(*Name);
+		const uint64 Hash = CityHash64(Utf8.Get(), Utf8.Length());
+		return Hash != 0 ? Hash : 1;
+	}
+
+	/**
+	 * Hash index of Timeline.Names.txt, kept in Timeline.Names.idx
+	 * Appending a snapshot looks up its few names by probing the index on disk instead of reading the whole
+	 * name table. Open addressing with linear probing, at most half full; names are identified by a 64-bit hash.
+	 * The header records the size of the name table it covers and is written last, so an index that does not
+	 * match the table (missing, or an append was interrupted) is rebuilt from the table.
+	 */
+	class FNameIndex
+	{
+	public:
+		/**
+		 * Open the index, rebuilding it if it does not match the name table
+		 * @return False if the index cannot be written
+		 */
+		bool Open(const FString& InDirectory)
+		{
+			Directory = InDirectory;
+			Pending.Reset();
+
+			Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*GetNameIndexPath(Directory), true, true));
+			if (Handle && Handle->Seek(0) && Handle->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header))
+				&& Header.Magic == NameIndexMagic && Header.Version == NameIndexVersion
+				&& FMath::IsPowerOfTwo(Header.NumBuckets) && Header.NamesBytes == GetNamesBytes(Directory)
+				&& Handle->Size() == GetBucketOffset(Header.NumBuckets))
+			{
+				return true;
+			}
+
+			return Rebuild(MinNameBuckets);
+		}
+
+		/**
+		 * Get the id of a name, assigning the next free one if the table does not have it yet
+		 * @param NewNames Receives the line to append to the name table for a new name
+		 */
+		uint32 Intern(const FString& Name, FString& NewNames)
+		{
+			const uint64 Hash = HashName(Name);
+			if (const uint32* PendingId = Pending.Find(Hash))
+			{
+				return *PendingId;
+			}
+
+			uint32 Slot = 0;
+			FNameIndexBucket Bucket;
+			if (Probe(Hash, Slot, Bucket) && Bucket.Hash == Hash)
+			{
+				return Bucket.Id;
+			}
+
+			const uint32 Id = Header.NumNames + Pending.Num();
+			Pending.Add(Hash, Id);
+			NewNames += Name;
+			NewNames += TEXT("\n");
+			return Id;
+		}
+
+		/**
+		 * Add the names interned since Open; call after they were appended to the name table
+		 * @return False if the index cannot be written
+		 */
+		bool Commit()
+		{
+			if (Pending.Num() == 0)
+			{
+				return true;
+			}
+
+			const uint32 NumNames = Header.NumNames + Pending.Num();
+			if (NumNames * 2 > Header.NumBuckets)
+			{
+				return Rebuild(Header.NumBuckets * 2);
+			}
+
+			for (const TPair<uint64, uint32>& Entry : Pending)
+			{
+				uint32 Slot = 0;
+				FNameIndexBucket Bucket;
+				if (!Probe(Entry.Key, Slot, Bucket))
+				{
+					return false;
+				}
+
+				Bucket.Hash = Entry.Key;
+				Bucket.Id = Entry.Value;
+				Bucket.Padding = 0;
+				if (!Handle->Seek(GetBucketOffset(Slot)) || !Handle->Write(reinterpret_cast<const uint8*>(&Bucket), sizeof(Bucket)))
+				{
+					return false;
+				}
+			}
+
+			Pending.Reset();
+			Header.NumNames = NumNames;
+			Header.NamesBytes = GetNamesBytes(Directory);
+			return Handle->Seek(0) && Handle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header)) && Handle->Flush();
+		}
+
+	private:
+		static int64 GetBucketOffset(uint32 Slot)
+		{
+			return static_cast<int64>(sizeof(FNameIndexHeader)) + static_cast<int64>(Slot) * static_cast<int64>(sizeof(FNameIndexBucket));
+		}
+
+		/**
+		 * Find the slot holding a hash, or the empty slot it would go in
+		 * @return False if the index cannot be read
+		 */
+		bool Probe(uint64 Hash, uint32& OutSlot, FNameIndexBucket& OutBucket)
+		{
+			const uint32 Mask = Header.NumBuckets - 1;
+			for (OutSlot = static_cast<uint32>(Hash) & Mask;; OutSlot = (OutSlot + 1) & Mask)
+			{
+				if (!Handle->Seek(GetBucketOffset(OutSlot)) || !Handle->Read(reinterpret_cast<uint8*>(&OutBucket), sizeof(OutBucket)))
+				{
+					return false;
+				}
+
+				if (OutBucket.Hash == 0 || OutBucket.Hash == Hash)
+				{
+					return true;
+				}
+			}
+		}
+
+		/** Rewrite the index from the name table, with at least MinBuckets slots */
+		bool Rebuild(uint32 MinBuckets)
+		{
+			TArray<FString> Names;
+			bool bNeedsNewline = false;
+			LoadNames(Directory, Names, &bNeedsNewline);
+
+			// Terminate a line left by an interrupted append now; it was already counted as a name
+			if (bNeedsNewline && !FFileHelper::SaveStringToFile(TEXT("\n"), *GetNamesPath(Directory), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+			{
+				UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas timeline names %s"), *GetNamesPath(Directory));
+				return false;
+			}
+
+			uint32 NumBuckets = MinBuckets;
+			while (static_cast<uint32>(Names.Num()) * 2 > NumBuckets)
+			{
+				NumBuckets *= 2;
+			}
+
+			// The first line of a repeated name keeps the id
+			TArray<FNameIndexBucket> Buckets;
+			Buckets.SetNumZeroed(NumBuckets);
+			for (int32 Id = 0; Id < Names.Num(); ++Id)
+			{
+				const uint64 Hash = HashName(Names[Id]);
+				uint32 Slot = static_cast<uint32>(Hash) & (NumBuckets - 1);
+				while (Buckets[Slot].Hash != 0 && Buckets[Slot].Hash != Hash)
+				{
+					Slot = (Slot + 1) & (NumBuckets - 1);
+				}
+
+				if (Buckets[Slot].Hash == 0)
+				{
+					Buckets[Slot].Hash = Hash;
+					Buckets[Slot].Id = Id;
+				}
+			}
+
+			Pending.Reset();
+			Header.Magic = NameIndexMagic;
+			Header.Version = NameIndexVersion;
+			Header.NumBuckets = NumBuckets;
+			Header.NumNames = Names.Num();
+			Header.NamesBytes = GetNamesBytes(Directory);
+
+			// Buckets before the header, so a torn rebuild is detected and redone
+			Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*GetNameIndexPath(Directory), false, true));
+			if (!Handle
+				|| !Handle->Seek(sizeof(FNameIndexHeader)) || !Handle->Write(reinterpret_cast<const uint8*>(Buckets.GetData()), GetBucketOffset(NumBuckets) - GetBucketOffset(0))
+				|| !Handle->Seek(0) || !Handle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header)) || !Handle->Flush())
+			{
+				UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas timeline name index %s"), *GetNameIndexPath(Directory));
+				return false;
+			}
+
+			return true;
+		}
+
+		FString Directory;
+		TUniquePtr<IFileHandle> Handle;
+		FNameIndexHeader Header;
+
+		/** Names interned since Open, by hash */
+		TMap<uint64, uint32> Pending;
+	};
+
+	/**
+	 * Open a timeline file for appending, writing the header if the file is new
+	 * @param OutNumRecords Complete records in the file; a torn record at the end is not counted
+	 * @return The handle, or null if the file cannot be opened or belongs to another format
+	 */
+	static TUniquePtr<IFileHandle> OpenForAppend(const FString& FilePath, EAtlasTimelineResolution Resolution, int64& OutNumRecords)
+	{
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath, true, true));
+		if (!Handle)
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to open Atlas timeline %s"), *FilePath);
+			return nullptr;
+		}
+
+		const uint32 RecordSize = GetRecordSize(Resolution);
+		const int64 HeaderSize = sizeof(FFileHeader);
+
+		if (Handle->Size() < HeaderSize)
+		{
+			FFileHeader Header;
+			Header.Magic = FileMagic;
+			Header.Version = FileVersion;
+			Header.RecordSize = RecordSize;
+			Header.Resolution = static_cast<uint32>(Resolution);
+
+			if (!Handle->Seek(0) || !Handle->Write(reinterpret_cast<const uint8*>(&Header), HeaderSize))
+			{
+				UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas timeline header %s"), *FilePath);
+				return nullptr;
+			}
+
+			OutNumRecords = 0;
+			return Handle;
+		}
+
+		FFileHeader Header;
+		if (!Handle->Seek(0) || !Handle->Read(reinterpret_cast<uint8*>(&Header), HeaderSize))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to read Atlas timeline header %s"), *FilePath);
+			return nullptr;
+		}
+
+		// Never append to a file written with another layout; move it away to start a new history
+		if (Header.Magic != FileMagic || Header.Version != FileVersion || Header.RecordSize != RecordSize || Header.Resolution != static_cast<uint32>(Resolution))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("%s is not a version %u Atlas timeline, not appending"), *FilePath, FileVersion);
+			return nullptr;
+		}
+
+		OutNumRecords = (Handle->Size() - HeaderSize) / RecordSize;
+		return Handle;
+	}
+
+	static int64 GetRecordOffset(EAtlasTimelineResolution Resolution, int64 Index)
+	{
+		return static_cast<int64>(sizeof(FFileHeader)) + Index * GetRecordSize(Resolution);
+	}
+
+	/** Write one raw record after the last complete one */
+	static bool AppendRecord(const FString& Directory, const FAtlasTimelineRecord& Record)
+	{
+		const FString FilePath = FAtlasTimeline::GetFilePath(EAtlasTimelineResolution::Raw, Directory);
+
+		int64 NumRecords = 0;
+		TUniquePtr<IFileHandle> Handle = OpenForAppend(FilePath, EAtlasTimelineResolution::Raw, NumRecords);
+		if (!Handle)
+		{
+			return false;
+		}
+
+		return Handle->Seek(GetRecordOffset(EAtlasTimelineResolution::Raw, NumRecords))
+			&& Handle->Write(reinterpret_cast<const uint8*>(&Record), sizeof(Record))
+			&& Handle->Flush();
+	}
+
+	/** Start a new aggregate period from one record */
+	static void InitAggregate(FAtlasTimelineAggregateRecord& Aggregate, int64 PeriodStart, const FAtlasTimelineRecord& Record)
+	{
+		FMemory::Memzero(Aggregate);
+		Aggregate.PeriodStart = PeriodStart;
+		Aggregate.NumSnapshots = 1;
+		Aggregate.MinProjectBytes = Aggregate.MaxProjectBytes = Record.ProjectBytes;
+		Aggregate.MinVRAMBytes = Aggregate.MaxVRAMBytes = Record.VRAMBytes;
+		for (int32 Severity = 0; Severity < FAtlasTimeline::NumSeverities; ++Severity)
+		{
+			Aggregate.MinViolations[Severity] = Aggregate.MaxViolations[Severity] = Record.Violations[Severity];
+		}
+		Aggregate.Last = Record;
+	}
+
+	static void FoldAggregate(FAtlasTimelineAggregateRecord& Aggregate, const FAtlasTimelineRecord& Record)
+	{
+		++Aggregate.NumSnapshots;
+		Aggregate.MinProjectBytes = FMath::Min(Aggregate.MinProjectBytes, Record.ProjectBytes);
+		Aggregate.MaxProjectBytes = FMath::Max(Aggregate.MaxProjectBytes, Record.ProjectBytes);
+		Aggregate.MinVRAMBytes = FMath::Min(Aggregate.MinVRAMBytes, Record.VRAMBytes);
+		Aggregate.MaxVRAMBytes = FMath::Max(Aggregate.MaxVRAMBytes, Record.VRAMBytes);
+		for (int32 Severity = 0; Severity < FAtlasTimeline::NumSeverities; ++Severity)
+		{
+			Aggregate.MinViolations[Severity] = FMath::Min(Aggregate.MinViolations[Severity], Record.Violations[Severity]);
+			Aggregate.MaxViolations[Severity] = FMath::Max(Aggregate.MaxViolations[Severity], Record.Violations[Severity]);
+		}
+
+		if (Record.Timestamp >= Aggregate.Last.Timestamp)
+		{
+			Aggregate.Last = Record;
+		}
+	}
+
+	/**
+	 * Fold a record into the last aggregate if it falls into the same period, or start a new one
+	 * Snapshots older than the last period (clock skew between CI agents) are folded into it as well,
+	 * so the file stays sorted by period.
+	 */
+	static bool UpdateAggregate(const FString& Directory, EAtlasTimelineResolution Resolution, const FAtlasTimelineRecord& Record)
+	{
+		const FString FilePath = FAtlasTimeline::GetFilePath(Resolution, Directory);
+
+		int64 NumRecords = 0;
+		TUniquePtr<IFileHandle> Handle = OpenForAppend(FilePath, Resolution, NumRecords);
+		if (!Handle)
+		{
+			return false;
+		}
+
+		const int64 PeriodStart = FAtlasTimeline::GetPeriodStart(Resolution, FDateTime(Record.Timestamp)).GetTicks();
+
+		FAtlasTimelineAggregateRecord Aggregate;
+		int64 WriteIndex = NumRecords;
+		if (NumRecords > 0)
+		{
+			if (!Handle->Seek(GetRecordOffset(Resolution, NumRecords - 1)) || !Handle->Read(reinterpret_cast<uint8*>(&Aggregate), sizeof(Aggregate)))
+			{
+				UE_LOG(LogAtlas, Error, TEXT("Failed to read the last aggregate of %s"), *FilePath);
+				return false;
+			}
+
+			if (Aggregate.PeriodStart >= PeriodStart)
+			{
+				FoldAggregate(Aggregate, Record);
+				WriteIndex = NumRecords - 1;
+			}
+		}
+
+		if (WriteIndex == NumRecords)
+		{
+			InitAggregate(Aggregate, PeriodStart, Record);
+		}
+
+		return Handle->Seek(GetRecordOffset(Resolution, WriteIndex))
+			&& Handle->Write(reinterpret_cast<const uint8*>(&Aggregate), sizeof(Aggregate))
+			&& Handle->Flush();
+	}
+}
+
+using namespace AtlasTimeline;
+
+// FAtlasSnapshot
+
+FAtlasSnapshot::FAtlasSnapshot()
+	: ProjectBytes(0)
+	, VRAMBytes(0)
+	, Violations{ 0, 0, 0 }
+{
+}
+
+void FAtlasSnapshot::AddViolation(FName RuleName, uint8 Severity)
+{
+	if (Severity >= FAtlasTimeline::NumSeverities)
+	{
+		return;
+	}
+
+	// Linear search: a project has a few dozen rules at most
+	FAtlasSnapshotRule* Rule = Rules.FindByPredicate([RuleName](const FAtlasSnapshotRule& Candidate)
+	{
+		return Candidate.RuleName == RuleName;
+	});
+
+	if (!Rule)
+	{
+		Rule = &Rules.AddDefaulted_GetRef();
+		Rule->RuleName = RuleName;
+	}
+
+	++Rule->Counts[Severity];
+	++Violations[Severity];
+}
+
+// FAtlasTimeline
+
+FString FAtlasTimeline::GetDefaultDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Atlas");
+}
+
+FString FAtlasTimeline::GetFilePath(EAtlasTimelineResolution Resolution, const FString& Directory)
+{
+	switch (Resolution)
+	{
+	case EAtlasTimelineResolution::Daily:
+		return Directory / TEXT("Timeline.Daily.bin");
+	case EAtlasTimelineResolution::Weekly:
+		return Directory / TEXT("Timeline.Weekly.bin");
+	default:
+		return Directory / TEXT("Timeline.bin");
+	}
+}
+
+FDateTime FAtlasTimeline::GetPeriodStart(EAtlasTimelineResolution Resolution, const FDateTime& When)
+{
+	switch (Resolution)
+	{
+	case EAtlasTimelineResolution::Daily:
+		return When.GetDate();
+	case EAtlasTimelineResolution::Weekly:
+		// EDayOfWeek starts at Monday = 0
+		return When.GetDate() - FTimespan::FromDays(static_cast<int32>(When.GetDayOfWeek()));
+	default:
+		return When;
+	}
+}
+
+bool FAtlasTimeline::AppendSnapshot(const FAtlasSnapshot& Snapshot, const FString& Directory)
+{
+	// Rank so the records keep the worst rules and offenders
+	TArray<const FAtlasSnapshotRule*> Rules;
+	for (const FAtlasSnapshotRule& Rule : Snapshot.Rules)
+	{
+		Rules.Add(&Rule);
+	}
+	Rules.Sort([](const FAtlasSnapshotRule& A, const FAtlasSnapshotRule& B)
+	{
+		return A.GetTotal() != B.GetTotal() ? A.GetTotal() > B.GetTotal() : A.RuleName.LexicalLess(B.RuleName);
+	});
+	Rules.SetNum(FMath::Min(Rules.Num(), MaxRules));
+
+	TArray<const FAtlasSnapshotOffender*> Offenders;
+	for (const FAtlasSnapshotOffender& Offender : Snapshot.Offenders)
+	{
+		Offenders.Add(&Offender);
+	}
+	Offenders.Sort([](const FAtlasSnapshotOffender& A, const FAtlasSnapshotOffender& B)
+	{
+		return A.NumViolations != B.NumViolations ? A.NumViolations > B.NumViolations : A.AssetPath < B.AssetPath;
+	});
+	Offenders.SetNum(FMath::Min(Offenders.Num(), MaxOffenders));
+
+	// Intern names; new ones are written before any record refers to them
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+	FNameIndex NameIndex;
+	if (!NameIndex.Open(Directory))
+	{
+		return false;
+	}
+
+	FString NewNames;
+	auto Intern = [&NameIndex, &NewNames](const FString& Name) -> uint32
+	{
+		return NameIndex.Intern(Name, NewNames);
+	};
+
+	FAtlasTimelineRecord Record;
+	FMemory::Memzero(Record);
+	Record.Timestamp = Snapshot.When.GetTicks();
+	Record.ProjectBytes = Snapshot.ProjectBytes;
+	Record.VRAMBytes = Snapshot.VRAMBytes;
+	Record.NumRules = Rules.Num();
+	Record.NumOffenders = Offenders.Num();
+
+	for (int32 Severity = 0; Severity < NumSeverities; ++Severity)
+	{
+		Record.Violations[Severity] = FMath::Max(Snapshot.Violations[Severity], 0);
+	}
+
+	for (int32 Index = 0; Index < Rules.Num(); ++Index)
+	{
+		FAtlasTimelineRuleSlot& Slot = Record.Rules[Index];
+		Slot.RuleId = Intern(Rules[Index]->RuleName.ToString());
+		for (int32 Severity = 0; Severity < NumSeverities; ++Severity)
+		{
+			Slot.Counts[Severity] = FMath::Max(Rules[Index]->Counts[Severity], 0);
+		}
+	}
+
+	for (int32 Index = 0; Index < Offenders.Num(); ++Index)
+	{
+		FAtlasTimelineOffenderSlot& Slot = Record.Offenders[Index];
+		Slot.AssetId = Intern(Offenders[Index]->AssetPath);
+		Slot.NumViolations = FMath::Max(Offenders[Index]->NumViolations, 0);
+	}
+
+	if (!NewNames.IsEmpty())
+	{
+		if (!FFileHelper::SaveStringToFile(NewNames, *GetNamesPath(Directory), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas timeline names %s"), *GetNamesPath(Directory));
+			return false;
+		}
+
+		if (!NameIndex.Commit())
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to write Atlas timeline name index %s"), *GetNameIndexPath(Directory));
+			return false;
+		}
+	}
+
+	bool bWritten = AppendRecord(Directory, Record);
+	bWritten &= UpdateAggregate(Directory, EAtlasTimelineResolution::Daily, Record);
+	bWritten &= UpdateAggregate(Directory, EAtlasTimelineResolution::Weekly, Record);
+
+	UE_LOG(LogAtlas, Log, TEXT("Appended Atlas timeline snapshot: %lld project bytes, %lld VRAM bytes, %d violations"),
+		Snapshot.ProjectBytes, Snapshot.VRAMBytes, Snapshot.GetNumViolations());
+
+	return bWritten;
+}
+
+TArray<FAtlasSnapshot> FAtlasTimeline::LoadHistory(EAtlasTimelineResolution Resolution, const FString& Directory)
+{
+	TArray<FAtlasSnapshot> History;
+
+	FAtlasTimelineView View;
+	if (View.Open(Resolution, Directory))
+	{
+		History.Reserve(View.Num());
+		for (int32 Index = 0; Index < View.Num(); ++Index)
+		{
+			History.Add(View.GetSnapshot(Index));
+		}
+	}
+
+	return History;
+}
+
+// FAtlasTimelineView
+
+FAtlasTimelineView::FAtlasTimelineView()
+{
+	Reset();
+}
+
+FAtlasTimelineView::~FAtlasTimelineView()
+{
+	// The region must be released before the handle that owns the mapping
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+void FAtlasTimelineView::Reset()
+{
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	FallbackData.Empty();
+	Names.Empty();
+
+	Records = nullptr;
+	NumRecords = 0;
+	RecordSize = 0;
+	Resolution = EAtlasTimelineResolution::Raw;
+}
+
+bool FAtlasTimelineView::Open(EAtlasTimelineResolution InResolution, const FString& Directory)
+{
+	Reset();
+
+	const FString FilePath = FAtlasTimeline::GetFilePath(InResolution, Directory);
+	if (!FPaths::FileExists(FilePath))
+	{
+		// No snapshot recorded yet
+		return false;
+	}
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (MappedHandle && MappedHandle->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackData, *FilePath))
+		{
+			UE_LOG(LogAtlas, Error, TEXT("Failed to open Atlas timeline %s"), *FilePath);
+			return false;
+		}
+
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+
+	const FFileHeader* Header = reinterpret_cast<const FFileHeader*>(Data);
+	const bool bValid = DataSize >= static_cast<int64>(sizeof(FFileHeader))
+		&& Header->Magic == FileMagic
+		&& Header->Version == FileVersion
+		&& Header->RecordSize == GetRecordSize(InResolution)
+		&& Header->Resolution == static_cast<uint32>(InResolution);
+
+	if (!bValid)
+	{
+		UE_LOG(LogAtlas, Error, TEXT("%s is not a valid Atlas timeline"), *FilePath);
+		Reset();
+		return false;
+	}
+
+	Resolution = InResolution;
+	RecordSize = Header->RecordSize;
+	Records = Data + sizeof(FFileHeader);
+	NumRecords = static_cast<int32>((DataSize - sizeof(FFileHeader)) / RecordSize);
+
+	LoadNames(Directory, Names);
+	return true;
+}
+
+const FAtlasTimelineRecord& FAtlasTimelineView::GetRecord(int32 Index) const
+{
+	if (Resolution != EAtlasTimelineResolution::Raw)
+	{
+		return GetAggregate(Index).Last;
+	}
+
+	check(Index >= 0 && Index < NumRecords);
+	return *reinterpret_cast<const FAtlasTimelineRecord*>(Records + static_cast<int64>(Index) * RecordSize);
+}
+
+const FAtlasTimelineAggregateRecord& FAtlasTimelineView::GetAggregate(int32 Index) const
+{
+	check(Resolution != EAtlasTimelineResolution::Raw);
+	check(Index >= 0 && Index < NumRecords);
+	return *reinterpret_cast<const FAtlasTimelineAggregateRecord*>(Records + static_cast<int64>(Index) * RecordSize);
+}
+
+FString FAtlasTimelineView::GetName(uint32 Id) const
+{
+	return Names.IsValidIndex(Id) ? Names[Id] : FString();
+}
+
+FAtlasSnapshot FAtlasTimelineView::GetSnapshot(int32 Index) const
+{
+	const FAtlasTimelineRecord& Record = GetRecord(Index);
+
+	FAtlasSnapshot Snapshot;
+	Snapshot.When = FDateTime(Record.Timestamp);
+	Snapshot.ProjectBytes = Record.ProjectBytes;
+	Snapshot.VRAMBytes = Record.VRAMBytes;
+
+	for (int32 Severity = 0; Severity < FAtlasTimeline::NumSeverities; ++Severity)
+	{
+		Snapshot.Violations[Severity] = static_cast<int32>(Record.Violations[Severity]);
+	}
+
+	const uint32 NumRules = FMath::Min<uint32>(Record.NumRules, FAtlasTimeline::MaxRules);
+	for (uint32 RuleIndex = 0; RuleIndex < NumRules; ++RuleIndex)
+	{
+		FAtlasSnapshotRule& Rule = Snapshot.Rules.AddDefaulted_GetRef();
+		Rule.RuleName = FName(*GetName(Record.Rules[RuleIndex].RuleId));
+		for (int32 Severity = 0; Severity < FAtlasTimeline::NumSeverities; ++Severity)
+		{
+			Rule.Counts[Severity] = static_cast<int32>(Record.Rules[RuleIndex].Counts[Severity]);
+		}
+	}
+
+	const uint32 NumOffenders = FMath::Min<uint32>(Record.NumOffenders, FAtlasTimeline::MaxOffenders);
+	for (uint32 OffenderIndex = 0; OffenderIndex < NumOffenders; ++OffenderIndex)
+	{
+		FAtlasSnapshotOffender& Offender = Snapshot.Offenders.AddDefaulted_GetRef();
+		Offender.AssetPath = GetName(Record.Offenders[OffenderIndex].AssetId);
+		Offender.NumViolations = static_cast<int32>(Record.Offenders[OffenderIndex].NumViolations);
+	}
+
+	return Snapshot;
+}
@@ -0,0 +1,246 @@
+// Copyright Atlas Team. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Resolution of a timeline file
+ */
+enum class EAtlasTimelineResolution : uint8
+{
+	/** One record per appended snapshot */
+	Raw,
+	/** One record per UTC day */
+	Daily,
+	/** One record per UTC week, starting on Monday */
+	Weekly
+};
+
+/**
+ * Violations of one rule, by severity (indexed like EAtlasSeverity: Info, Warning, Error)
+ */
+struct FAtlasSnapshotRule
+{
+	FName RuleName;
+	int32 Counts[3];
+
+	FAtlasSnapshotRule()
+		: Counts{ 0, 0, 0 }
+	{
+	}
+
+	int32 GetTotal() const { return Counts[0] + Counts[1] + Counts[2]; }
+};
+
+/**
+ * An asset with many violations
+ */
+struct FAtlasSnapshotOffender
+{
+	FString AssetPath;
+	int32 NumViolations;
+
+	FAtlasSnapshotOffender()
+		: NumViolations(0)
+	{
+	}
+};
+
+/**
+ * Project metrics at one point in time
+ */
+struct ATLASRUNTIME_API FAtlasSnapshot
+{
+	/** UTC time of the snapshot */
+	FDateTime When;
+
+	int64 ProjectBytes;
+	int64 VRAMBytes;
+
+	/** Violations by rule; only the FAtlasTimeline::MaxRules rules with the most violations are stored per record */
+	TArray<FAtlasSnapshotRule> Rules;
+
+	/** Assets with the most violations; only FAtlasTimeline::MaxOffenders are stored per record */
+	TArray<FAtlasSnapshotOffender> Offenders;
+
+	/** Totals by severity, including rules that did not fit into a record */
+	int32 Violations[3];
+
+	FAtlasSnapshot();
+
+	/**
+	 * Count one violation
+	 * @param RuleName The rule that reported it
+	 * @param Severity EAtlasSeverity value
+	 */
+	void AddViolation(FName RuleName, uint8 Severity);
+
+	int32 GetNumViolations() const { return Violations[0] + Violations[1] + Violations[2]; }
+};
+
+/**
+ * One snapshot record of the timeline files
+ * Rules and offenders are stored as ids into the timeline's name table.
+ */
+struct FAtlasTimelineRuleSlot
+{
+	uint32 RuleId;
+	uint32 Counts[3];
+};
+
+struct FAtlasTimelineOffenderSlot
+{
+	uint32 AssetId;
+	uint32 NumViolations;
+};
+
+struct FAtlasTimelineRecord
+{
+	/** FDateTime ticks, UTC */
+	int64 Timestamp;
+	int64 ProjectBytes;
+	int64 VRAMBytes;
+	uint32 NumRules;
+	uint32 NumOffenders;
+	uint32 Violations[3];
+	uint32 Padding;
+	FAtlasTimelineRuleSlot Rules[32];
+	FAtlasTimelineOffenderSlot Offenders[16];
+};
+
+/**
+ * Snapshots of one day or week folded together; Last is the snapshot that closed the period so far
+ */
+struct FAtlasTimelineAggregateRecord
+{
+	/** FDateTime ticks of the period start, UTC */
+	int64 PeriodStart;
+	uint32 NumSnapshots;
+	uint32 Padding;
+	int64 MinProjectBytes;
+	int64 MaxProjectBytes;
+	int64 MinVRAMBytes;
+	int64 MaxVRAMBytes;
+	uint32 MinViolations[3];
+	uint32 MaxViolations[3];
+	FAtlasTimelineRecord Last;
+};
+
+/**
+ * Append-only history of project metrics in Saved/Atlas
+ *
+ * Timeline.bin holds one fixed-size record per snapshot after a small header, so appending is a single
+ * write at the end of the file and record N is at a known offset. Timeline.Daily.bin and Timeline.Weekly.bin
+ * hold one aggregate per period: an append either rewrites the last aggregate in place or adds a new one,
+ * so charting years of history reads a few hundred records instead of every CI run.
+ * Rule names and asset paths live in Timeline.Names.txt, one per line, and are referenced by line index.
+ * Timeline.Names.idx is an on-disk hash index of that table, so an append looks its names up without reading
+ * the table; it is rebuilt from the table whenever it is missing or does not match it.
+ * Names are written before the record that uses them, so an interrupted append never leaves dangling ids;
+ * a partially written record at the end of a file is ignored and overwritten by the next append.
+ */
+class ATLASRUNTIME_API FAtlasTimeline
+{
+public:
+	static constexpr int32 NumSeverities = 3;
+	static constexpr int32 MaxRules = 32;
+	static constexpr int32 MaxOffenders = 16;
+
+	/**
+	 * Get the directory of the timeline files
+	 * @return Saved/Atlas of the current project
+	 */
+	static FString GetDefaultDirectory();
+
+	/**
+	 * Get the path of one timeline file
+	 * @param Resolution Which file
+	 * @param Directory Timeline directory
+	 * @return Full file path
+	 */
+	static FString GetFilePath(EAtlasTimelineResolution Resolution, const FString& Directory);
+
+	/**
+	 * Append a snapshot to the raw log and fold it into the daily and weekly aggregates
+	 * Rules and offenders are ranked by violation count before they are cut to MaxRules and MaxOffenders.
+	 * @param Snapshot The snapshot to record
+	 * @param Directory Timeline directory, created if needed
+	 * @return True if every file was written
+	 */
+	static bool AppendSnapshot(const FAtlasSnapshot& Snapshot, const FString& Directory = GetDefaultDirectory());
+
+	/**
+	 * Load every snapshot of a timeline file
+	 * @param Resolution Raw snapshots, or the last snapshot of each day or week
+	 * @param Directory Timeline directory
+	 * @return Snapshots in append order, empty if there is no history
+	 */
+	static TArray<FAtlasSnapshot> LoadHistory(EAtlasTimelineResolution Resolution = EAtlasTimelineResolution::Raw, const FString& Directory = GetDefaultDirectory());
+
+	/**
+	 * Get the start of the period a time falls into
+	 * @param Resolution Daily or weekly
+	 * @param When UTC time
+	 * @return Midnight of the day, or of the Monday of the week
+	 */
+	static FDateTime GetPeriodStart(EAtlasTimelineResolution Resolution, const FDateTime& When);
+};
+
+/**
+ * Read-only view of one timeline file
+ * The file is memory-mapped where the platform supports it and records are read in place.
+ */
+class ATLASRUNTIME_API FAtlasTimelineView
+{
+public:
+	FAtlasTimelineView();
+	~FAtlasTimelineView();
+
+	/**
+	 * Map a timeline file and its name table
+	 * @param Resolution Which file to open
+	 * @param Directory Timeline directory
+	 * @return True if the file exists and has a valid header
+	 */
+	bool Open(EAtlasTimelineResolution Resolution, const FString& Directory = FAtlasTimeline::GetDefaultDirectory());
+
+	EAtlasTimelineResolution GetResolution() const { return Resolution; }
+
+	int32 Num() const { return NumRecords; }
+
+	/** Raw record, or the last snapshot of an aggregate */
+	const FAtlasTimelineRecord& GetRecord(int32 Index) const;
+
+	/** Aggregate record; only valid for daily and weekly files */
+	const FAtlasTimelineAggregateRecord& GetAggregate(int32 Index) const;
+
+	/** Decode a rule name or asset path, empty if the id is unknown */
+	FString GetName(uint32 Id) const;
+
+	/** Materialize a record with its names resolved */
+	FAtlasSnapshot GetSnapshot(int32 Index) const;
+
+private:
+	void Reset();
+
+	// Non-copyable
+	FAtlasTimelineView(const FAtlasTimelineView&) = delete;
+	FAtlasTimelineView& operator=(const FAtlasTimelineView&) = delete;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** File contents when memory mapping is not available */
+	TArray<uint8> FallbackData;
+
+	const uint8* Records;
+	int32 NumRecords;
+	uint32 RecordSize;
+	EAtlasTimelineResolution Resolution;
+
+	TArray<FString> Names;
+};